@@ -23,12 +23,15 @@
 
 // C/STL
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <stdint.h>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 // Global
@@ -39,17 +42,24 @@
 	\defgroup CommandOptions
 	\defgroup Writers
 	\defgroup WriterConfiguration
+	\defgroup Sinks
 	\defgroup Data
+	\defgroup Jobs
+	\defgroup Tracing
 */
 
 #include "Version.hpp"
 
 // Commands
 
+#include "commands/AlignPop.hpp"
+#include "commands/AlignPush.hpp"
 #include "commands/Braces.hpp"
+#include "commands/CachedCommand.hpp"
 #include "commands/CommaList.hpp"
 #include "commands/CommentBlock.hpp"
 #include "commands/CommentLine.hpp"
+#include "commands/Document.hpp"
 #include "commands/FeatureFlag.hpp"
 #include "commands/Include.hpp"
 #include "commands/IncludeBlock.hpp"
@@ -57,7 +67,16 @@
 #include "commands/IndentPush.hpp"
 #include "commands/Label.hpp"
 #include "commands/NextLine.hpp"
+#include "commands/ParallelForEach.hpp"
+#include "commands/PinnedChunk.hpp"
 #include "commands/Scope.hpp"
+#include "commands/Splice.hpp"
+
+// Sinks
+
+#include "sinks/BufferSink.hpp"
+#include "sinks/FileDescriptorSink.hpp"
+#include "sinks/StringSink.hpp"
 
 // Writers
 
@@ -65,4 +84,21 @@
 #include "writers/ConsoleWriter.hpp"
 #include "writers/DebugWriter.hpp"
 #include "writers/FileWriter.hpp"
+#include "writers/FragmentWriter.hpp"
+#include "writers/HashWriter.hpp"
+#include "writers/ProfilingWriter.hpp"
+#include "writers/SinkWriter.hpp"
 #include "writers/StringWriter.hpp"
+#include "writers/TeeWriter.hpp"
+#include "writers/WriterPool.hpp"
+
+// Jobs
+
+#include "jobs/GenerationJobs.hpp"
+#include "jobs/ThreadPool.hpp"
+
+// Tracing
+
+#include "tracing/TraceRecorder.hpp"
+#include "tracing/TraceSpan.hpp"
+#include "tracing/Tracing.hpp"
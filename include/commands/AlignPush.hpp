@@ -0,0 +1,74 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace panini
+{
+
+	/*!
+		\brief Command for aligning new lines to a column after the
+		indentation.
+
+		\ingroup Commands
+
+		Alignment is written as spaces after the indentation of every new
+		line, so lines can be aligned to a column regardless of the
+		characters used for indentation. Alignment is added to the alignment
+		that was pushed before and is undone with \ref AlignPop.
+
+		Example:
+
+		\code{.cpp}
+			writer << IndentPush() << "Call(first," << NextLine();
+			writer << AlignPush(5) << "second);" << AlignPop() << NextLine();
+		\endcode
+
+		Output:
+
+		\code{.cpp}
+				Call(first,
+				     second);
+		\endcode
+
+		\sa Writer
+	*/
+
+	struct AlignPush
+	{
+		/*!
+			Construct an AlignPush command with the number of columns to add
+			to the alignment.
+		*/
+		inline explicit AlignPush(uint32_t _columns)
+			: columns(_columns)
+		{
+		}
+
+		/*!
+			Number of columns to add to the alignment.
+		*/
+		uint32_t columns;
+	};
+
+};
@@ -25,9 +25,169 @@
 #include "options/BracesOptions.hpp"
 #include "writers/Writer.hpp"
 
+#include <type_traits>
+
 namespace panini
 {
 
+	/*!
+		\brief Interface for commands that output braces around a callback.
+
+		\ingroup Commands
+
+		Implemented by \ref Braces and by the commands returned from
+		\ref MakeBraces, so they can be handled the same way regardless of
+		how the callback is stored.
+	*/
+
+	class BracesCommand
+		: public Command
+	{
+
+	public:
+		/*!
+			Options used for the braces.
+		*/
+		virtual const BracesOptions& GetOptions() const = 0;
+
+		/*!
+			Call the callback that is output between the braces.
+		*/
+		virtual void VisitCallback(Writer& writer) = 0;
+
+		inline void Visit(Writer& writer) override
+		{
+			Render(writer, GetOptions(), [this](Writer& writer) {
+				VisitCallback(writer);
+			});
+		}
+
+		/*!
+			Output braces with the specified `options` and call `callback`
+			between them, without constructing a command.
+		*/
+		template <typename TInner>
+		inline static void Render(
+			Writer& writer,
+			const BracesOptions& options,
+			TInner&& callback)
+		{
+			const BraceBreakingStyle breakingStyle =
+				options.breakingStyle == BraceBreakingStyle::Inherit
+					? writer.GetBraceBreakingStyle()
+					: options.breakingStyle;
+
+			const bool wasNewLine = writer.IsOnNewLine();
+
+			switch (breakingStyle)
+			{
+
+			case BraceBreakingStyle::Attach:
+				{
+					writer << options.chunkBraceOpen << IndentPush() << NextLine();
+					callback(writer);
+					writer << IndentPop() << options.chunkBraceClose;
+
+				} break;
+
+			case BraceBreakingStyle::Allman:
+				{
+					if (!wasNewLine)
+					{
+						writer << NextLine();
+					}
+
+					writer << options.chunkBraceOpen << IndentPush() << NextLine();
+					callback(writer);
+					writer << IndentPop() << options.chunkBraceClose;
+
+				} break;
+
+			case BraceBreakingStyle::Whitesmiths:
+				{
+					if (!wasNewLine)
+					{
+						writer << NextLine() << IndentPush();
+					}
+
+					writer << options.chunkBraceOpen << NextLine();
+					callback(writer);
+					writer << options.chunkBraceClose;
+
+					if (!wasNewLine)
+					{
+						writer << IndentPop();
+					}
+
+				} break;
+
+			default:
+				break;
+
+			}
+		}
+
+	};
+
+	/*!
+		\brief Braces command that stores its callback without type erasure.
+
+		\ingroup Commands
+
+		The callback is stored inline, so constructing the command does not
+		allocate memory regardless of what the callback captures. Use
+		\ref MakeBraces to deduce the type of the callback.
+
+		\sa Braces
+	*/
+
+	template <typename TCallback>
+	class BasicBraces
+		: public BracesCommand
+	{
+
+	public:
+		/*!
+			Create a Braces command with a `callback` that is moved into the
+			instance.
+		*/
+		inline explicit BasicBraces(
+			TCallback&& callback,
+			const BracesOptions& options = BracesOptions{}) noexcept(std::is_nothrow_move_constructible_v<TCallback>)
+			: m_callback(std::move(callback))
+			, m_options(options)
+		{
+		}
+
+		/*!
+			Callback that is called between the opening and closing braces.
+		*/
+		inline const TCallback& GetCallback() const
+		{
+			return m_callback;
+		}
+
+		inline const BracesOptions& GetOptions() const override
+		{
+			return m_options;
+		}
+
+		inline void VisitCallback(Writer& writer) override
+		{
+			m_callback(writer);
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			Render(writer, m_options, m_callback);
+		}
+
+	protected:
+		TCallback m_callback;
+		BracesOptions m_options;
+
+	};
+
 	/*!
 		\brief Command for outputting opening and closing (curly) braces.
 
@@ -73,7 +233,7 @@ namespace panini
 	*/
 
 	class Braces
-		: public Command
+		: public BasicBraces<std::function<void(Writer&)>>
 	{
 
 	public:
@@ -96,7 +256,7 @@ namespace panini
 		inline explicit Braces(
 			TCallback&& callback,
 			BraceBreakingStyle breakingStyle = BraceBreakingStyle::Inherit) noexcept
-			: m_callback(std::move(callback))
+			: BasicBraces(std::move(callback))
 		{
 			m_options.breakingStyle = breakingStyle;
 		}
@@ -116,72 +276,37 @@ namespace panini
 		inline explicit Braces(
 			TCallback&& callback,
 			const BracesOptions& options) noexcept
-			: m_callback(std::move(callback))
-			, m_options(options)
+			: BasicBraces(std::move(callback), options)
 		{
 		}
 
-		inline void Visit(Writer& writer) override
-		{
-			const BraceBreakingStyle breakingStyle =
-				m_options.breakingStyle == BraceBreakingStyle::Inherit
-					? writer.GetBraceBreakingStyle()
-					: m_options.breakingStyle;
-
-			const bool wasNewLine = writer.IsOnNewLine();
-
-			switch (breakingStyle)
-			{
-
-			case BraceBreakingStyle::Attach:
-				{
-					writer << m_options.chunkBraceOpen << IndentPush() << NextLine();
-					m_callback(writer);
-					writer << IndentPop() << m_options.chunkBraceClose;
-
-				} break;
+	};
 
-			case BraceBreakingStyle::Allman:
-				{
-					if (!wasNewLine)
-					{
-						writer << NextLine();
-					}
+	/*!
+		Create a Braces command that stores the `callback` without
+		allocating memory.
 
-					writer << m_options.chunkBraceOpen << IndentPush() << NextLine();
-					m_callback(writer);
-					writer << IndentPop() << m_options.chunkBraceClose;
+		\ingroup Commands
 
-				} break;
+		Example:
 
-			case BraceBreakingStyle::Whitesmiths:
+		\code{.cpp}
+			writer << MakeBraces([&members](Writer& writer) {
+				for (const std::string& member : members)
 				{
-					if (!wasNewLine)
-					{
-						writer << NextLine() << IndentPush();
-					}
-
-					writer << m_options.chunkBraceOpen << NextLine();
-					m_callback(writer);
-					writer << m_options.chunkBraceClose;
-
-					if (!wasNewLine)
-					{
-						writer << IndentPop();
-					}
-
-				} break;
-
-			default:
-				break;
-
-			}
-		}
-
-	private:
-		TCallback m_callback;
-		BracesOptions m_options;
-
-	};
+					writer << member << ";" << NextLine();
+				}
+			});
+		\endcode
+	*/
+	template <typename TCallback>
+	inline BasicBraces<std::decay_t<TCallback>> MakeBraces(
+		TCallback&& callback,
+		const BracesOptions& options = BracesOptions{})
+	{
+		return BasicBraces<std::decay_t<TCallback>>(
+			std::decay_t<TCallback>(std::forward<TCallback>(callback)),
+			options);
+	}
 
 };
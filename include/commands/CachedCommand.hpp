@@ -0,0 +1,158 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "commands/Command.hpp"
+#include "commands/Splice.hpp"
+#include "data/CommandCache.hpp"
+#include "data/Hash64.hpp"
+#include "writers/FragmentWriter.hpp"
+
+#include <type_traits>
+#include <typeinfo>
+
+namespace panini
+{
+
+	/*!
+		\brief Command that replays the output of another command from a
+		\ref CommandCache instead of visiting it, when its inputs did not
+		change.
+
+		\ingroup Commands
+
+		The cache key combines the `inputHash` with the type of the command,
+		the configuration of the writer and whether the writer is on a new
+		line. The `inputHash` must change whenever anything the output of the
+		command depends on changes, otherwise stale output is replayed. A
+		\ref Hash64 of the inputs is a good choice.
+
+		On a miss, the command is visited with a \ref FragmentWriter and the
+		fragment is stored in the cache. In both cases, the output is spliced
+		into the writer at its current level of indentation, so the output is
+		identical to visiting the command directly.
+
+		Example:
+
+		\code{.cpp}
+			CommandCache cache("intermediate/cache");
+
+			for (const GameObject& object : objects)
+			{
+				Hash64 inputs;
+				inputs.Update(object.name);
+				inputs.Update(object.source);
+
+				writer << CachedCommand(cache, inputs.GetDigest(), GameObjectCommand(object)) << NextLine();
+			}
+		\endcode
+
+		\sa CommandCache
+	*/
+
+	template <typename TCommand>
+	class CachedCommand
+		: public Command
+	{
+
+		static_assert(std::is_base_of_v<Command, TCommand>, "CachedCommand can only wrap commands.");
+
+	public:
+		/*!
+			Create a command that caches the output of `command`.
+
+			\param cache      Cache to load from and store to.
+			\param inputHash  Hash of everything the output depends on.
+			\param command    Command to visit on a miss.
+		*/
+		inline CachedCommand(
+			CommandCache& cache,
+			uint64_t inputHash,
+			TCommand&& command)
+			: m_cache(cache)
+			, m_inputHash(inputHash)
+			, m_command(std::move(command))
+		{
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			const uint64_t key = GetKey(writer);
+
+			Fragment fragment;
+
+			if (!m_cache.Load(key, fragment))
+			{
+				FragmentWriterConfig config;
+				static_cast<WriterConfig&>(config) = writer.GetConfig();
+				config.braceBreakingStyle = writer.GetBraceBreakingStyle();
+				config.includeStyle = writer.GetIncludeStyle();
+				config.isOnNewLine = writer.IsOnNewLine();
+
+				{
+					FragmentWriter fragmentWriter(fragment, config);
+					fragmentWriter << std::move(m_command);
+				}
+
+				m_cache.Store(key, fragment);
+			}
+
+			writer << Splice(fragment);
+		}
+
+		/*!
+			Key of the cache entry when the command is visited with `writer`.
+		*/
+		inline uint64_t GetKey(const Writer& writer) const
+		{
+			const WriterConfig& config = writer.GetConfig();
+
+			const char state[3] = {
+				static_cast<char>(writer.GetBraceBreakingStyle()),
+				static_cast<char>(writer.GetIncludeStyle()),
+				static_cast<char>(writer.IsOnNewLine() ? 1 : 0),
+			};
+
+			// strings are prefixed with their size, so their boundaries are
+			// part of the key
+
+			Hash64 hash(m_inputHash);
+			hash.Update(std::string_view(state, sizeof(state)));
+
+			for (std::string_view text : { std::string_view(typeid(TCommand).name()), std::string_view(config.chunkNewLine), std::string_view(config.chunkIndent) })
+			{
+				const uint64_t size = text.size();
+				hash.Update(std::string_view(reinterpret_cast<const char*>(&size), sizeof(size)));
+				hash.Update(text);
+			}
+
+			return hash.GetDigest();
+		}
+
+	private:
+		CommandCache& m_cache;
+		uint64_t m_inputHash = 0;
+		TCommand m_command;
+
+	};
+
+};
@@ -24,11 +24,271 @@
 #include "commands/Command.hpp"
 #include "options/CommaListOptions.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace panini
 {
 
+	/*!
+		\brief Default transform for the \ref CommaList command.
+
+		\ingroup Commands
+
+		Items that can be viewed as a string, like `std::string` and C-style
+		strings, are passed through unchanged. Arithmetic items are formatted
+		with `std::to_chars` into a buffer on the stack, using the
+		\ref NumberFormat and precision from \ref CommaListOptions. Other
+		items are converted with `std::to_string`.
+
+		Floating-point items are formatted with a stream when the standard
+		library doesn't implement `std::to_chars` for them.
+	*/
+
+	struct CommaListTransform
+	{
+		/*!
+			Format used for arithmetic items.
+		*/
+		NumberFormat numberFormat = NumberFormat::Default;
+
+		/*!
+			Digits after the decimal point for NumberFormat::Fixed.
+		*/
+		int precision = 6;
+
+		template <typename TItem>
+		inline void operator () (Writer& writer, const TItem& item, size_t listIndex) const
+		{
+			(void)listIndex;
+
+			if constexpr (std::is_convertible_v<const TItem&, std::string_view>)
+			{
+				writer << std::string_view(item);
+			}
+			else if constexpr (std::is_same_v<TItem, bool>)
+			{
+				writer << (item ? '1' : '0');
+			}
+			else if constexpr (std::is_arithmetic_v<TItem>)
+			{
+				WriteNumber(writer, item, numberFormat, precision);
+			}
+			else
+			{
+				writer << std::to_string(item);
+			}
+		}
+
+		/*!
+			Write an arithmetic `value` to the `writer` without allocating
+			memory.
+		*/
+		template <typename TNumber>
+		inline static void WriteNumber(
+			Writer& writer,
+			TNumber value,
+			NumberFormat format,
+			int precision = 6)
+		{
+			char buffer[128];
+			char* first = buffer;
+			char* last = buffer + sizeof(buffer);
+
+			if constexpr (std::is_integral_v<TNumber>)
+			{
+				if (format == NumberFormat::Hexadecimal)
+				{
+					using TUnsigned = std::make_unsigned_t<TNumber>;
+
+					TUnsigned magnitude = static_cast<TUnsigned>(value);
+					if (value < 0)
+					{
+						*first++ = '-';
+						magnitude = static_cast<TUnsigned>(TUnsigned(0) - magnitude);
+					}
+
+					*first++ = '0';
+					*first++ = 'x';
+
+					first = std::to_chars(first, last, magnitude, 16).ptr;
+				}
+				else
+				{
+					first = std::to_chars(first, last, value).ptr;
+				}
+
+				writer << std::string_view(buffer, first - buffer);
+			}
+			else
+			{
+			#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+				if (format == NumberFormat::Hexadecimal &&
+					std::isfinite(value))
+				{
+					if (std::signbit(value))
+					{
+						*first++ = '-';
+						value = -value;
+					}
+
+					*first++ = '0';
+					*first++ = 'x';
+				}
+
+				std::to_chars_result result = ToChars(first, last, value, format, precision);
+				if (result.ec == std::errc())
+				{
+					writer << std::string_view(buffer, result.ptr - buffer);
+
+					return;
+				}
+
+				// very large values in fixed notation don't fit on the stack
+
+				std::string large(buffer, first);
+				large.resize(large.size() + 512 + static_cast<size_t>(std::max(precision, 0)));
+
+				char* largeFirst = large.data() + (first - buffer);
+				result = ToChars(largeFirst, large.data() + large.size(), value, format, precision);
+				large.resize(result.ec == std::errc() ? result.ptr - large.data() : 0);
+
+				writer << large;
+			#else
+				(void)first;
+				(void)last;
+
+				WriteFloatingPoint(writer, value, format, precision);
+			#endif
+			}
+		}
+
+	private:
+	#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		template <typename TNumber>
+		inline static std::to_chars_result ToChars(
+			char* first,
+			char* last,
+			TNumber value,
+			NumberFormat format,
+			int precision)
+		{
+			switch (format)
+			{
+
+			case NumberFormat::Hexadecimal:
+				return std::to_chars(first, last, value, std::chars_format::hex);
+
+			case NumberFormat::Fixed:
+				return std::to_chars(first, last, value, std::chars_format::fixed, std::max(precision, 0));
+
+			case NumberFormat::Shortest:
+				return std::to_chars(first, last, value);
+
+			default:
+				return std::to_chars(first, last, value, std::chars_format::fixed, 6);
+
+			}
+		}
+	#else
+		/*
+			Standard libraries without floating-point `std::to_chars`, like
+			the one in Visual Studio 2017, format with a stream instead.
+		*/
+		template <typename TNumber>
+		inline static void WriteFloatingPoint(
+			Writer& writer,
+			TNumber value,
+			NumberFormat format,
+			int precision)
+		{
+			std::ostringstream stream;
+			stream.imbue(std::locale::classic());
+
+			switch (format)
+			{
+
+			case NumberFormat::Hexadecimal:
+				stream << std::hexfloat << value;
+				break;
+
+			case NumberFormat::Fixed:
+				stream << std::fixed << std::setprecision(std::max(precision, 0)) << value;
+				break;
+
+			case NumberFormat::Shortest:
+				WriteShortest(stream, value);
+				break;
+
+			default:
+				stream << std::fixed << std::setprecision(6) << value;
+				break;
+
+			}
+
+			writer << stream.str();
+		}
+
+		/*
+			Use the fewest digits that read back as the same value, in fixed
+			or scientific notation, whichever is shorter.
+		*/
+		template <typename TNumber>
+		inline static void WriteShortest(std::ostringstream& stream, TNumber value)
+		{
+			if (!std::isfinite(value))
+			{
+				stream << value;
+
+				return;
+			}
+
+			std::ostringstream scientific;
+			scientific.imbue(std::locale::classic());
+			scientific << std::scientific;
+
+			int digits = 1;
+			for (; digits < std::numeric_limits<TNumber>::max_digits10; ++digits)
+			{
+				scientific.str(std::string());
+				scientific << std::setprecision(digits - 1) << value;
+
+				std::istringstream parser(scientific.str());
+				parser.imbue(std::locale::classic());
+
+				TNumber parsed = TNumber(0);
+				if (parser >> parsed &&
+					parsed == value)
+				{
+					break;
+				}
+			}
+
+			scientific.str(std::string());
+			scientific << std::setprecision(digits - 1) << value;
+
+			const std::string scientificText = scientific.str();
+			const int exponent = std::atoi(scientificText.c_str() + scientificText.find('e') + 1);
+
+			stream << std::fixed << std::setprecision(std::max(digits - 1 - exponent, 0)) << value;
+
+			if (scientificText.size() < stream.str().size())
+			{
+				stream.str(scientificText);
+			}
+		}
+	#endif
+	};
+
 	/*!
 		\brief Command for outputting a list of items, comma-separated by
 		default.
@@ -78,7 +338,20 @@ namespace panini
 		\endcode
 	*/
 
+	/*!
+		Underlying type of the items in a \ref CommaList, as derived from
+		TIterator, which should be either a pointer type or an iterator one.
+	*/
 	template <class TIterator>
+	using CommaListItem = typename std::conditional<
+		std::is_pointer_v<TIterator>,
+		std::remove_pointer_t<TIterator>,
+		typename std::iterator_traits<TIterator>::value_type
+	>::type;
+
+	template <
+		class TIterator,
+		class TCallback = std::function<void(Writer& writer, const CommaListItem<TIterator>& item, size_t listIndex)>>
 	class CommaList
 		: public Command
 	{
@@ -88,30 +361,29 @@ namespace panini
 			Underlying type as derived from TIterator, which should be either a
 			pointer type or an iterator one.
 		*/
-		using TUnderlying = typename std::conditional<
-			std::is_pointer_v<TIterator>,
-			std::remove_pointer_t<TIterator>,
-			typename std::iterator_traits<TIterator>::value_type
-		>::type;
+		using TUnderlying = CommaListItem<TIterator>;
 
 		/*!
 			Function for transforming elements in the list to chunks for a \ref
-			Writer instance.
+			Writer instance. The transform is stored inline when its type is
+			deduced from the constructor.
 
 			\param writer     Active writer.
 			\param item       Value being processed.
 			\param listIndex  Index of the value in the list.
 		*/
-		using TTransform = std::function<void(Writer& writer, const TUnderlying& item, size_t listIndex)>;
+		using TTransform = TCallback;
 
 		/*!
 			\brief Default transform function for the command.
 
 			Each iterated item is passed through a function that "transforms" it
-			to an `std::string` before passing it to the active writer.
-			
-			The default implementation calls `std::to_string`, which will handle
-			most standard types.
+			to a chunk before passing it to the active writer.
+
+			Items that can be viewed as a string, like `std::string` and C-style
+			strings, are passed through unchanged. Arithmetic items are
+			formatted with `std::to_chars` in the same format as
+			`std::to_string`. Other items are converted with `std::to_string`.
 
 			\param writer     Active writer.
 			\param item       Value being processed.
@@ -120,30 +392,15 @@ namespace panini
 		template <typename TItem>
 		static void DefaultTransform(Writer& writer, const TItem& item, size_t listIndex)
 		{
-			(void)listIndex;
-
-			writer << std::to_string(item);
-		}
-
-		/*!
-			Specialization for transforming string items that passes the input
-			through unchanged.
-
-			\param writer     Active writer.
-			\param item       Value being processed.
-			\param listIndex  Index of the value in the list.
-		*/
-		template <>
-		static void DefaultTransform(Writer& writer, const std::string& item, size_t listIndex)
-		{
-			(void)listIndex;
-
-			writer << item;
+			CommaListTransform()(writer, item, listIndex);
 		}
 
 		/*!
 			Construct a CommaList from a begin and end iterator.
 
+			Arithmetic items are formatted with the \ref NumberFormat set in
+			the `options`.
+
 			\param begin       Starting point for iteration.
 			\param end         End point for iteration.
 			\param options     Additional options for the command.
@@ -155,7 +412,7 @@ namespace panini
 			: m_begin(begin)
 			, m_end(end)
 			, m_options(options)
-			, m_transform(DefaultTransform<TUnderlying>)
+			, m_transform(CommaListTransform{ options.numberFormat, options.precision })
 		{
 		}
 
@@ -171,7 +428,7 @@ namespace panini
 			TIterator begin,
 			TIterator end,
 			const CommaListOptions& options,
-			TTransform&& transform) noexcept
+			TTransform transform) noexcept(std::is_nothrow_move_constructible_v<TTransform>)
 			: m_begin(begin)
 			, m_end(end)
 			, m_options(options)
@@ -220,4 +477,16 @@ namespace panini
 
 	};
 
+	// lists without a transform use CommaListTransform, transforms are
+	// stored without type erasure
+
+	template <class TIterator>
+	CommaList(TIterator, TIterator) -> CommaList<TIterator, CommaListTransform>;
+
+	template <class TIterator>
+	CommaList(TIterator, TIterator, const CommaListOptions&) -> CommaList<TIterator, CommaListTransform>;
+
+	template <class TIterator, class TCallback>
+	CommaList(TIterator, TIterator, const CommaListOptions&, TCallback) -> CommaList<TIterator, TCallback>;
+
 };
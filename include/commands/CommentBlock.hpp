@@ -24,9 +24,56 @@
 #include "commands/Command.hpp"
 #include "writers/Writer.hpp"
 
+#include <type_traits>
+
 namespace panini
 {
 
+	/*!
+		\brief Comment block command that stores its callback without type
+		erasure.
+
+		\ingroup Commands
+
+		The callback is stored inline, so constructing the command does not
+		allocate memory regardless of what the callback captures. Use
+		\ref MakeCommentBlock to deduce the type of the callback.
+
+		\sa CommentBlock
+	*/
+
+	template <typename TCallback>
+	class BasicCommentBlock
+		: public Command
+	{
+
+	public:
+		/*!
+			Construct a CommentBlock with a callback that is moved into the
+			instance.
+		*/
+		inline explicit BasicCommentBlock(
+			TCallback&& callback) noexcept(std::is_nothrow_move_constructible_v<TCallback>)
+			: m_callback(std::move(callback))
+		{
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			writer << "/* ";
+			writer.SetIsInCommentBlock(true);
+
+			m_callback(writer);
+
+			writer.SetIsInCommentBlock(false);
+			writer << NextLine() << " */";
+		}
+
+	protected:
+		TCallback m_callback;
+
+	};
+
 	/*!
 		\brief Command for outputting comment blocks over multiple lines.
 
@@ -53,7 +100,7 @@ namespace panini
 		Output:
 
 		\code{.cpp}
-			/* EXAMPLE:
+			/&zwj;* EXAMPLE:
 			 *
 			 * Writing beautiful multi-line comments is easy
 			 * When you use a comment block command!
@@ -62,7 +109,7 @@ namespace panini
 	*/
 
 	class CommentBlock
-		: public Command
+		: public BasicCommentBlock<std::function<void(Writer&)>>
 	{
 
 	public:
@@ -76,24 +123,23 @@ namespace panini
 		*/
 		inline explicit CommentBlock(
 			std::function<void(Writer&)>&& callback) noexcept
-			: m_callback(std::exchange(callback, {}))
+			: BasicCommentBlock(std::exchange(callback, {}))
 		{
 		}
 
-		inline void Visit(Writer& writer) override
-		{
-			writer << "/* ";
-			writer.SetIsInCommentBlock(true);
-
-			m_callback(writer);
-
-			writer.SetIsInCommentBlock(false);
-			writer << NextLine() << " */";
-		}
+	};
 
-	private:
-		std::function<void(Writer&)> m_callback;
+	/*!
+		Create a CommentBlock command that stores the `callback` without
+		allocating memory.
 
-	};
+		\ingroup Commands
+	*/
+	template <typename TCallback>
+	inline BasicCommentBlock<std::decay_t<TCallback>> MakeCommentBlock(TCallback&& callback)
+	{
+		return BasicCommentBlock<std::decay_t<TCallback>>(
+			std::decay_t<TCallback>(std::forward<TCallback>(callback)));
+	}
 
 };
@@ -77,7 +77,7 @@ namespace panini
 
 			if (!m_comment.empty())
 			{
-				writer << " " << m_comment;
+				writer << ' ' << m_comment;
 			}
 		}
 
@@ -0,0 +1,618 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "commands/Braces.hpp"
+#include "commands/Command.hpp"
+#include "commands/Include.hpp"
+#include "commands/IncludeBlock.hpp"
+#include "commands/Scope.hpp"
+#include "writers/Writer.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Command that records the output of a callback once, so it can
+		be rendered to many writers.
+
+		\ingroup Commands
+
+		The callback is called once when the document is constructed. The
+		chunks and commands it outputs are stored as a tree of nodes. Commands
+		that depend on the configuration of a writer, like \ref Braces,
+		\ref Scope (including those made with \ref MakeBraces and
+		\ref MakeScope), \ref Include and \ref IncludeBlock, are stored as
+		nodes that are resolved every time the document is rendered. This means the
+		same document can be rendered to writers with a different
+		`chunkIndent`, `chunkNewLine`, brace breaking style or include style.
+
+		Unlike other commands, a Document is not consumed when it is visited
+		and can be rendered any number of times. Rendering does not modify
+		the document, so the same document can be rendered to many writers
+		on different threads at the same time.
+
+		\note Chunks output with \ref PinnedChunk are referenced instead of
+		copied, so their storage must outlive the document and every
+		document its nodes were copied to.
+
+		\note The callback is called with a writer that uses the default
+		\ref WriterConfig. Code in the callback that inspects the writer's
+		configuration directly is only evaluated for that configuration.
+
+		Example:
+
+		\code{.cpp}
+			Document document([](Writer& writer) {
+				writer << Scope("struct Vector2", [](Writer& writer) {
+					writer << "float x;" << NextLine();
+					writer << "float y;" << NextLine();
+				}) << ";";
+			});
+
+			FileWriter header(headerConfig);
+			document.Render(header);
+
+			FileWriter fixture(fixtureConfig);
+			document.Render(fixture);
+		\endcode
+	*/
+
+	class Document
+		: public Command
+	{
+
+	public:
+		using TCallback = std::function<void(Writer&)>;
+
+		/*!
+			Create an empty document.
+		*/
+		inline Document() = default;
+
+		/*!
+			Create a document from the output of a `callback`.
+		*/
+		inline explicit Document(const TCallback& callback)
+		{
+			Record(callback);
+		}
+
+		Document(const Document&) = delete;
+		Document& operator = (const Document&) = delete;
+
+		inline Document(Document&&) noexcept = default;
+		inline Document& operator = (Document&&) noexcept = default;
+
+		/*!
+			Append the output of a `callback` to the document.
+		*/
+		inline void Record(const TCallback& callback)
+		{
+			Recorder recorder(*this);
+			callback(recorder);
+		}
+
+		/*!
+			Check if nothing was recorded.
+		*/
+		inline bool IsEmpty() const
+		{
+			return m_nodes.empty();
+		}
+
+		/*!
+			Remove all recorded nodes.
+		*/
+		inline void Clear()
+		{
+			m_nodes.clear();
+			m_chunks.clear();
+			m_pinned.clear();
+			m_braces.clear();
+			m_scopes.clear();
+			m_commands.clear();
+			m_includeSets.clear();
+		}
+
+		/*!
+			Output the recorded nodes to a `writer`.
+		*/
+		inline void Render(Writer& writer) const
+		{
+			// rendering into another document copies the nodes, so the
+			// commands in them are still resolved later
+
+			if (Recorder* recorder = dynamic_cast<Recorder*>(&writer))
+			{
+				recorder->Append(*this);
+
+				return;
+			}
+
+			RenderNodes(writer, 0, m_nodes.size());
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			Render(writer);
+		}
+
+	private:
+		enum class NodeType : uint8_t
+		{
+			Chunk,
+			PinnedChunk,
+			NextLine,
+			IndentPush,
+			IndentPop,
+			AlignPush,
+			AlignPop,
+			CommentBlockBegin,
+			CommentBlockEnd,
+			Braces,
+			Scope,
+			Command,
+			IncludeBlock
+		};
+
+		/*
+			Braces and scopes are followed by the nodes recorded inside them,
+			`size` is the number of those nodes.
+		*/
+		struct Node
+		{
+			NodeType type;
+			size_t size;
+			size_t index;
+		};
+
+		struct ScopeNode
+		{
+			size_t nameOffset;
+			size_t nameSize;
+			ScopeOptions options;
+		};
+
+		/*
+			Writer that adds nodes to a document instead of writing output.
+		*/
+		class Recorder final
+			: public Writer
+		{
+
+		public:
+			inline explicit Recorder(Document& document)
+				: m_document(document)
+			{
+			}
+
+			inline const WriterConfig& GetConfig() const override
+			{
+				return m_config;
+			}
+
+			inline BraceBreakingStyle GetBraceBreakingStyle() const override
+			{
+				return m_config.braceBreakingStyle;
+			}
+
+			inline IncludeStyle GetIncludeStyle() const override
+			{
+				return m_config.includeStyle;
+			}
+
+			inline bool IsOnNewLine() const override
+			{
+				return m_isOnNewLine;
+			}
+
+			inline Writer& operator << (std::string_view chunk) override
+			{
+				Write(chunk);
+
+				return *this;
+			}
+
+			inline Writer& operator << (const std::string& chunk) override
+			{
+				Write(chunk);
+
+				return *this;
+			}
+
+			inline Writer& operator << (const char* chunkString) override
+			{
+				Write(chunkString);
+
+				return *this;
+			}
+
+			inline Writer& operator << (char chunkCharacter) override
+			{
+				Write(std::string_view(&chunkCharacter, 1));
+
+				return *this;
+			}
+
+			inline Writer& operator << (const PinnedChunk& command) override
+			{
+				WritePinned(command.chunk);
+
+				return *this;
+			}
+
+			inline Writer& operator << (const NextLine&) override
+			{
+				WriteNewLine();
+
+				return *this;
+			}
+
+			inline Writer& operator << (const IndentPush&) override
+			{
+				m_document.AddNode(NodeType::IndentPush);
+
+				return *this;
+			}
+
+			inline Writer& operator << (const IndentPop&) override
+			{
+				m_document.AddNode(NodeType::IndentPop);
+
+				return *this;
+			}
+
+			inline Writer& operator << (const AlignPush& command) override
+			{
+				m_document.AddNode(NodeType::AlignPush, 0, command.columns);
+
+				return *this;
+			}
+
+			inline Writer& operator << (const AlignPop&) override
+			{
+				m_document.AddNode(NodeType::AlignPop);
+
+				return *this;
+			}
+
+			inline Writer& operator << (Command&& command) override
+			{
+				// commands that depend on the writer's configuration are
+				// resolved when the document is rendered
+
+				if (BracesCommand* braces = dynamic_cast<BracesCommand*>(&command))
+				{
+					const size_t node = m_document.AddNode(NodeType::Braces, m_document.m_braces.size());
+					m_document.m_braces.push_back(braces->GetOptions());
+
+					RecordChildren(node, *braces);
+				}
+				else if (
+					ScopeCommand* scope = dynamic_cast<ScopeCommand*>(&command))
+				{
+					const size_t node = m_document.AddNode(NodeType::Scope, m_document.m_scopes.size());
+					m_document.m_scopes.push_back(ScopeNode{
+						m_document.m_chunks.size(),
+						scope->GetName().size(),
+						scope->GetOptions()
+					});
+					m_document.m_chunks.append(scope->GetName());
+
+					RecordChildren(node, *scope);
+				}
+				else if (
+					Include* include = dynamic_cast<Include*>(&command))
+				{
+					AddCommand(std::make_shared<Include>(std::move(*include)));
+
+					m_isOnNewLine = false;
+				}
+				else if (
+					IncludeBlock* includeBlock = dynamic_cast<IncludeBlock*>(&command))
+				{
+					m_document.AddNode(NodeType::IncludeBlock, m_document.m_includeSets.size());
+					m_document.m_includeSets.push_back(std::make_shared<const IncludeSet>(includeBlock->GetSet()));
+
+					m_isOnNewLine = false;
+				}
+				else if (
+					Document* document = dynamic_cast<Document*>(&command))
+				{
+					Append(*document);
+				}
+				else
+				{
+					command.Visit(*this);
+				}
+
+				return *this;
+			}
+
+			inline void SetIsInCommentBlock(bool value) override
+			{
+				m_document.AddNode(value ? NodeType::CommentBlockBegin : NodeType::CommentBlockEnd);
+			}
+
+			inline bool IsChanged() const override
+			{
+				return false;
+			}
+
+			inline bool Commit(bool force = false) override
+			{
+				(void)force;
+
+				return false;
+			}
+
+		protected:
+			inline void Write(std::string_view chunk) override
+			{
+				if (chunk.empty())
+				{
+					return;
+				}
+
+				m_document.AddNode(NodeType::Chunk, m_document.m_chunks.size(), chunk.size());
+				m_document.m_chunks.append(chunk);
+
+				m_isOnNewLine = false;
+			}
+
+			inline void WritePinned(std::string_view chunk) override
+			{
+				if (chunk.empty())
+				{
+					return;
+				}
+
+				m_document.AddNode(NodeType::PinnedChunk, m_document.m_pinned.size());
+				m_document.m_pinned.push_back(chunk);
+
+				m_isOnNewLine = false;
+			}
+
+			inline void WriteNewLine() override
+			{
+				m_document.AddNode(NodeType::NextLine);
+
+				m_isOnNewLine = true;
+			}
+
+			inline bool OnCommit(bool force = false) override
+			{
+				(void)force;
+
+				return false;
+			}
+
+		public:
+			/*
+				Copy the nodes of another document.
+			*/
+			inline void Append(const Document& other)
+			{
+				Document& document = m_document;
+
+				if (&other == &document)
+				{
+					return;
+				}
+
+				for (const Node& node : other.m_nodes)
+				{
+					size_t index = node.index;
+
+					switch (node.type)
+					{
+
+					case NodeType::Chunk:
+						index += document.m_chunks.size();
+						break;
+
+					case NodeType::PinnedChunk:
+						index += document.m_pinned.size();
+						break;
+
+					case NodeType::Braces:
+						index += document.m_braces.size();
+						break;
+
+					case NodeType::Scope:
+						index += document.m_scopes.size();
+						break;
+
+					case NodeType::Command:
+						index += document.m_commands.size();
+						break;
+
+					case NodeType::IncludeBlock:
+						index += document.m_includeSets.size();
+						break;
+
+					default:
+						break;
+
+					}
+
+					document.AddNode(node.type, index, node.size);
+				}
+
+				for (const ScopeNode& scope : other.m_scopes)
+				{
+					document.m_scopes.push_back(scope);
+					document.m_scopes.back().nameOffset += document.m_chunks.size();
+				}
+
+				document.m_chunks += other.m_chunks;
+				document.m_pinned.insert(document.m_pinned.end(), other.m_pinned.begin(), other.m_pinned.end());
+				document.m_braces.insert(document.m_braces.end(), other.m_braces.begin(), other.m_braces.end());
+				document.m_commands.insert(document.m_commands.end(), other.m_commands.begin(), other.m_commands.end());
+				document.m_includeSets.insert(document.m_includeSets.end(), other.m_includeSets.begin(), other.m_includeSets.end());
+
+				if (!other.m_nodes.empty())
+				{
+					m_isOnNewLine = other.m_nodes.back().type == NodeType::NextLine;
+				}
+			}
+
+		protected:
+			template <typename TCommand>
+			inline void RecordChildren(size_t node, TCommand& command)
+			{
+				// the opening brace always ends on a new line
+
+				m_isOnNewLine = true;
+
+				command.VisitCallback(*this);
+
+				m_document.m_nodes[node].size = m_document.m_nodes.size() - node - 1;
+
+				m_isOnNewLine = false;
+			}
+
+			inline void AddCommand(std::shared_ptr<Command>&& command)
+			{
+				m_document.AddNode(NodeType::Command, m_document.m_commands.size());
+				m_document.m_commands.push_back(std::move(command));
+			}
+
+		private:
+			Document& m_document;
+			WriterConfig m_config;
+			bool m_isOnNewLine = true;
+
+		};
+
+		inline size_t AddNode(NodeType type, size_t index = 0, size_t size = 0)
+		{
+			m_nodes.push_back(Node{ type, size, index });
+
+			return m_nodes.size() - 1;
+		}
+
+		inline void RenderNodes(Writer& writer, size_t first, size_t last) const
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				const Node& node = m_nodes[i];
+
+				switch (node.type)
+				{
+
+				case NodeType::Chunk:
+					writer << std::string_view(m_chunks.data() + node.index, node.size);
+					break;
+
+				case NodeType::PinnedChunk:
+					writer << PinnedChunk{ m_pinned[node.index] };
+					break;
+
+				case NodeType::NextLine:
+					writer << NextLine();
+					break;
+
+				case NodeType::IndentPush:
+					writer << IndentPush();
+					break;
+
+				case NodeType::IndentPop:
+					writer << IndentPop();
+					break;
+
+				case NodeType::AlignPush:
+					writer << AlignPush(node.size);
+					break;
+
+				case NodeType::AlignPop:
+					writer << AlignPop();
+					break;
+
+				case NodeType::CommentBlockBegin:
+					writer.SetIsInCommentBlock(true);
+					break;
+
+				case NodeType::CommentBlockEnd:
+					writer.SetIsInCommentBlock(false);
+					break;
+
+				case NodeType::Braces:
+					{
+						BracesCommand::Render(writer, m_braces[node.index], [this, i, &node](Writer& writer) {
+							RenderNodes(writer, i + 1, i + 1 + node.size);
+						});
+
+						i += node.size;
+
+					} break;
+
+				case NodeType::Scope:
+					{
+						const ScopeNode& scope = m_scopes[node.index];
+						const std::string_view name(m_chunks.data() + scope.nameOffset, scope.nameSize);
+
+						ScopeCommand::Render(writer, name, scope.options, [this, i, &node](Writer& writer) {
+							RenderNodes(writer, i + 1, i + 1 + node.size);
+						});
+
+						i += node.size;
+
+					} break;
+
+				case NodeType::Command:
+					m_commands[node.index]->Visit(writer);
+					break;
+
+				case NodeType::IncludeBlock:
+					{
+						// the shared set is left unsorted, each render sorts
+						// its own copy for the writer's include style
+
+						IncludeSet set(*m_includeSets[node.index]);
+						set.Sort(writer.GetIncludeStyle());
+
+						IncludeBlock::Render(writer, set);
+
+					} break;
+
+				}
+			}
+		}
+
+	private:
+		std::vector<Node> m_nodes;
+		std::string m_chunks;
+		std::vector<std::string_view> m_pinned;
+		std::vector<BracesOptions> m_braces;
+		std::vector<ScopeNode> m_scopes;
+		// shared with documents the nodes were copied to
+		std::vector<std::shared_ptr<Command>> m_commands;
+		std::vector<std::shared_ptr<const IncludeSet>> m_includeSets;
+
+	};
+
+};
@@ -23,9 +23,100 @@
 
 #include "commands/Command.hpp"
 
+#include <cstddef>
+#include <type_traits>
+
 namespace panini
 {
 
+	/*!
+		\brief Feature flag command that stores its callbacks without type
+		erasure.
+
+		\ingroup Commands
+
+		The callbacks are stored inline, so constructing the command does not
+		allocate memory for them regardless of what they capture. Use
+		\ref MakeFeatureFlag to deduce the types of the callbacks.
+
+		The context is still copied into a `std::string`, which allocates when
+		it doesn't fit in the small string buffer.
+
+		\sa FeatureFlag
+	*/
+
+	template <typename TCallbackThen, typename TCallbackElse>
+	class BasicFeatureFlag
+		: public Command
+	{
+
+	public:
+		/*!
+			Construct a FeatureFlag with callbacks that are moved into the
+			instance. Use `nullptr` for `callbackElse` to output nothing when
+			the condition is false.
+		*/
+		inline explicit BasicFeatureFlag(
+			bool condition,
+			const std::string& context,
+			TCallbackThen&& callbackThen,
+			TCallbackElse&& callbackElse)
+			: m_condition(condition)
+			, m_context(context)
+			, m_callbackThen(std::move(callbackThen))
+			, m_callbackElse(std::move(callbackElse))
+		{
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			if (m_condition)
+			{
+				if (!m_context.empty())
+				{
+					writer << CommentLine(m_context) << NextLine();
+				}
+
+				m_callbackThen(writer);
+				
+				if (!m_context.empty())
+				{
+					writer << CommentLine(m_context);
+				}
+			}
+			else if constexpr (!std::is_same_v<TCallbackElse, std::nullptr_t>)
+			{
+				if (IsSet(m_callbackElse))
+				{
+					m_callbackElse(writer);
+				}
+			}
+		}
+
+	protected:
+		template <typename TCallback>
+		inline static bool IsSet(const TCallback& callback)
+		{
+			if constexpr (std::is_constructible_v<bool, const TCallback&>)
+			{
+				return static_cast<bool>(callback);
+			}
+			else
+			{
+				(void)callback;
+
+				return true;
+			}
+		}
+
+	protected:
+		bool m_condition = false;
+		std::string m_context;
+		TCallbackThen m_callbackThen;
+		TCallbackElse m_callbackElse;
+
+	};
+
 	/*!
 		\brief Command for feature flags.
 
@@ -76,7 +167,7 @@ namespace panini
 	*/
 
 	class FeatureFlag
-		: public Command
+		: public BasicFeatureFlag<std::function<void(Writer&)>, std::function<void(Writer&)>>
 	{
 
 	public:
@@ -99,9 +190,7 @@ namespace panini
 			bool condition,
 			const std::string& context,
 			TCallback&& callbackThen) noexcept
-			: m_condition(condition)
-			, m_context(context)
-			, m_callbackThen(std::move(callbackThen))
+			: BasicFeatureFlag(condition, context, std::move(callbackThen), TCallback{})
 		{
 		}
 
@@ -119,42 +208,32 @@ namespace panini
 			const std::string& context,
 			TCallback&& callbackThen,
 			TCallback&& callbackElse) noexcept
-			: m_condition(condition)
-			, m_context(context)
-			, m_callbackThen(std::move(callbackThen))
-			, m_callbackElse(std::move(callbackElse))
+			: BasicFeatureFlag(condition, context, std::move(callbackThen), std::move(callbackElse))
 		{
 		}
 
-		inline void Visit(Writer& writer) override
-		{
-			if (m_condition)
-			{
-				if (!m_context.empty())
-				{
-					writer << CommentLine(m_context) << NextLine();
-				}
+	};
 
-				m_callbackThen(writer);
-				
-				if (!m_context.empty())
-				{
-					writer << CommentLine(m_context);
-				}
-			}
-			else if (
-				m_callbackElse)
-			{
-				m_callbackElse(writer);
-			}
-		}
+	/*!
+		Create a FeatureFlag command that stores the callbacks without
+		allocating memory for them.
 
-	private:
-		bool m_condition = false;
-		std::string m_context;
-		TCallback m_callbackThen;
-		TCallback m_callbackElse;
+		The `context` is still copied into the command.
 
-	};
+		\ingroup Commands
+	*/
+	template <typename TCallbackThen, typename TCallbackElse = std::nullptr_t>
+	inline BasicFeatureFlag<std::decay_t<TCallbackThen>, std::decay_t<TCallbackElse>> MakeFeatureFlag(
+		bool condition,
+		const std::string& context,
+		TCallbackThen&& callbackThen,
+		TCallbackElse&& callbackElse = nullptr)
+	{
+		return BasicFeatureFlag<std::decay_t<TCallbackThen>, std::decay_t<TCallbackElse>>(
+			condition,
+			context,
+			std::decay_t<TCallbackThen>(std::forward<TCallbackThen>(callbackThen)),
+			std::decay_t<TCallbackElse>(std::forward<TCallbackElse>(callbackElse)));
+	}
 
 };
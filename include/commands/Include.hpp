@@ -111,36 +111,90 @@ namespace panini
 		{
 		}
 
+		/*!
+			Create an Include command with an interned path and an
+			IncludeStyle. The include statement is written from the string
+			that was built when the path was interned.
+
+			Setting the `style` parameter to IncludeStyle::Inherit copies the
+			include style from the writer, otherwise it will be overridden for
+			this command only.
+		*/
+		inline explicit Include(
+			IncludePath path,
+			IncludeStyle style = IncludeStyle::Inherit) noexcept
+			: m_entry(path, style)
+		{
+		}
+
 		inline void Visit(Writer& writer) override
+		{
+			Render(writer, m_entry);
+		}
+
+		/*!
+			Write an include statement for an entry without constructing a
+			command. The path is taken from the string cached on the entry.
+		*/
+		inline static void Render(Writer& writer, const IncludeEntry& entry)
 		{
 			IncludeStyle includeStyle =
-				m_entry.style == IncludeStyle::Inherit
+				entry.style == IncludeStyle::Inherit
 					? writer.GetIncludeStyle()
-					: m_entry.style;
+					: entry.style;
 
-			writer << "#include ";
+			if (entry.interned &&
+				includeStyle != IncludeStyle::Inherit)
+			{
+				writer << entry.interned.GetLine(includeStyle);
 
-			std::string path = m_entry.path.string();
+				return;
+			}
+
+			char open = 0;
+			char close = 0;
 
 			switch (includeStyle)
 			{
 
 			case IncludeStyle::DoubleQuotes:
-				writer << "\"" << path << "\"";
+				open = close = '"';
 				break;
 
 			case IncludeStyle::SingleQuotes:
-				writer << "'" << path << "'";
+				open = close = '\'';
 				break;
 
 			case IncludeStyle::AngularBrackets:
-				writer << "<" << path << ">";
+				open = '<';
+				close = '>';
 				break;
-			
+
 			default:
 				break;
 
 			}
+
+			writer << "#include ";
+
+			if (open == 0)
+			{
+				return;
+			}
+
+			writer << open;
+
+			if (entry.pathString.empty() &&
+				!entry.path.empty())
+			{
+				writer << entry.path.string();
+			}
+			else
+			{
+				writer << entry.pathString;
+			}
+
+			writer << close;
 		}
 
 	private:
@@ -79,6 +79,14 @@ namespace panini
 		{
 		}
 
+		/*!
+			Get the set of includes that is output by the command.
+		*/
+		inline const IncludeSet& GetSet() const
+		{
+			return m_set;
+		}
+
 		inline void Visit(Writer& writer) override
 		{
 			// sort includes and resolve "inherit" include style with the
@@ -86,17 +94,26 @@ namespace panini
 
 			m_set.Sort(writer.GetIncludeStyle());
 
-			// write includes
+			Render(writer, m_set);
+		}
+
+		/*!
+			Write the include statements of a set that was already sorted for
+			the writer's include style, without constructing a command.
+		*/
+		inline static void Render(Writer& writer, const IncludeSet& set)
+		{
+			// the set is iterated as const so it stays sorted
 
 			size_t includeIndex = 0;
-			for (IncludeEntry& entry : m_set)
+			for (const IncludeEntry& entry : set)
 			{
 				if (includeIndex++ > 0)
 				{
 					writer << NextLine();
 				}
 
-				writer << Include(entry);
+				Include::Render(writer, entry);
 			}
 		}
 
@@ -89,7 +89,7 @@ namespace panini
 
 		inline void Visit(Writer& writer) override
 		{
-			writer << IndentPop() << m_name << ":" << IndentPush();
+			writer << IndentPop() << m_name << ':' << IndentPush();
 		}
 
 	private:
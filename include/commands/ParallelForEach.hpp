@@ -0,0 +1,228 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "commands/Command.hpp"
+#include "commands/Splice.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "options/ParallelForEachOptions.hpp"
+#include "tracing/Tracing.hpp"
+#include "writers/FragmentWriter.hpp"
+
+#include <iterator>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Command that renders the output of every item in a range on
+		a thread pool and outputs it in order.
+
+		\ingroup Commands
+
+		The items are divided into batches, which are rendered to a
+		\ref Fragment on the thread pool. Every batch uses the configuration
+		of the writer the command is visited with. When all batches are
+		done, they are spliced into the writer in the order of the items, at
+		its current level of indentation. The output is identical to calling
+		the callback for every item on the writer directly.
+
+		The callback is called as `callback(writer, item, index)` and may be
+		called on several threads at the same time, so it must not modify
+		state it shares with other items. If a callback throws an exception,
+		the first exception is rethrown after all batches are done.
+
+		Every batch is rendered as if the writer is on a new line when it
+		starts. If an item depends on whether it starts on a new line and
+		the previous item did not end on one, its batch is rendered again
+		on the calling thread.
+
+		Example:
+
+		\code{.cpp}
+			ParallelForEachOptions options;
+			options.addNewLines = true;
+
+			writer << ParallelForEach(tables.begin(), tables.end(), [](Writer& writer, const Table& table, size_t index) {
+				writer << Scope("struct " + table.name, [&table](Writer& writer) {
+					WriteColumns(writer, table);
+				}) << ";" << NextLine();
+			}, options);
+		\endcode
+
+		\sa ThreadPool, FragmentWriter
+	*/
+
+	template <class TIterator, class TCallback>
+	class ParallelForEach
+		: public Command
+	{
+
+	public:
+		/*!
+			Construct the command from a range of items.
+
+			\param begin     Starting point for iteration.
+			\param end       End point for iteration.
+			\param callback  Renders a single item.
+			\param options   Additional options for the command.
+		*/
+		inline explicit ParallelForEach(
+			TIterator begin,
+			TIterator end,
+			TCallback callback,
+			const ParallelForEachOptions& options = {}) noexcept(std::is_nothrow_move_constructible_v<TCallback>)
+			: m_begin(begin)
+			, m_end(end)
+			, m_callback(std::move(callback))
+			, m_options(options)
+		{
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			ThreadPool& pool = (m_options.pool != nullptr)
+				? *m_options.pool
+				: ThreadPool::GetShared();
+
+			const size_t itemCount = static_cast<size_t>(std::distance(m_begin, m_end));
+
+			size_t itemsPerTask = m_options.itemsPerTask;
+			if (itemsPerTask == 0)
+			{
+				const size_t taskCount = pool.GetThreadCount() * 4;
+				itemsPerTask = std::max<size_t>((itemCount + taskCount - 1) / taskCount, 1);
+			}
+
+			// nothing to gain from a single batch
+
+			if (itemCount <= itemsPerTask)
+			{
+				RenderItems(writer, m_begin, m_end, 0);
+				WriteLastSeparator(writer, itemCount);
+
+				return;
+			}
+
+			struct Batch
+			{
+				TIterator begin;
+				TIterator end;
+				size_t index;
+				Fragment fragment;
+			};
+
+			std::vector<Batch> batches;
+			batches.reserve((itemCount + itemsPerTask - 1) / itemsPerTask);
+
+			TIterator item = m_begin;
+			for (size_t index = 0; index < itemCount; index += itemsPerTask)
+			{
+				TIterator begin = item;
+				std::advance(item, std::min(itemsPerTask, itemCount - index));
+				batches.push_back(Batch{ begin, item, index, Fragment() });
+			}
+
+			FragmentWriterConfig config;
+			static_cast<WriterConfig&>(config) = writer.GetConfig();
+
+			ThreadPool::TaskGroup group;
+
+			for (size_t i = 0; i < batches.size(); ++i)
+			{
+				config.isOnNewLine = (i == 0) ? writer.IsOnNewLine() : true;
+
+				pool.Submit(group, [this, &batch = batches[i], config] {
+					PANINI_TRACE_SPAN("command", "ParallelForEach batch");
+
+					FragmentWriter fragmentWriter(batch.fragment, config);
+					RenderItems(fragmentWriter, batch.begin, batch.end, batch.index);
+				});
+			}
+
+			pool.Wait(group);
+
+			for (size_t i = 0; i < batches.size(); ++i)
+			{
+				const Batch& batch = batches[i];
+
+				if (i > 0 &&
+					batch.fragment.IsStartOfLineDependent() &&
+					!writer.IsOnNewLine())
+				{
+					RenderItems(writer, batch.begin, batch.end, batch.index);
+				}
+				else
+				{
+					writer << Splice(batch.fragment);
+				}
+			}
+
+			WriteLastSeparator(writer, itemCount);
+		}
+
+	private:
+		inline void RenderItems(Writer& writer, TIterator begin, TIterator end, size_t index) const
+		{
+			for (TIterator item = begin; item != end; ++item)
+			{
+				if (index > 0)
+				{
+					writer << m_options.chunkEndSeparator;
+
+					if (m_options.addNewLines)
+					{
+						writer << NextLine();
+					}
+				}
+
+				if (index > 0 ||
+					!m_options.skipFirstItemBeginSeparator)
+				{
+					writer << m_options.chunkBeginSeparator;
+				}
+
+				m_callback(writer, *item, index);
+
+				index++;
+			}
+		}
+
+		inline void WriteLastSeparator(Writer& writer, size_t itemCount) const
+		{
+			if (itemCount > 0 &&
+				!m_options.skipLastItemEndSeparator)
+			{
+				writer << m_options.chunkEndSeparator;
+			}
+		}
+
+	private:
+		TIterator m_begin;
+		TIterator m_end;
+		TCallback m_callback;
+		ParallelForEachOptions m_options;
+
+	};
+
+};
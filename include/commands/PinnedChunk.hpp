@@ -0,0 +1,60 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <string_view>
+
+namespace panini
+{
+
+	/*!
+		\brief Command for outputting a chunk whose storage outlives the
+		writer.
+
+		\ingroup Commands
+
+		Writers may keep a reference to a pinned chunk instead of copying it,
+		e.g. the \ref FileWriter in FileWriterMode::ScatterGather mode. This
+		makes pinned chunks ideal for large strings that already exist in
+		memory, like string literals and embedded templates.
+
+		\warning The storage of the chunk must remain valid until the writer
+		is committed.
+
+		Example:
+
+		\code{.cpp}
+			static const std::string s_Template = LoadTemplate("Component.hpp");
+
+			writer << PinnedChunk{ s_Template } << NextLine();
+		\endcode
+
+		\sa Writer
+	*/
+
+	struct PinnedChunk
+	{
+		//! View of the chunk's storage.
+		std::string_view chunk;
+	};
+
+};
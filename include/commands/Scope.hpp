@@ -24,11 +24,169 @@
 #include "commands/Braces.hpp"
 #include "commands/Command.hpp"
 #include "options/ScopeOptions.hpp"
+#include "tracing/Tracing.hpp"
 #include "writers/Writer.hpp"
 
+#include <type_traits>
+
 namespace panini
 {
 
+	/*!
+		\brief Interface for commands that output a named scope around a
+		callback.
+
+		\ingroup Commands
+
+		Implemented by \ref Scope and by the commands returned from
+		\ref MakeScope, so they can be handled the same way regardless of how
+		the callback is stored.
+	*/
+
+	class ScopeCommand
+		: public Command
+	{
+
+	public:
+		/*!
+			Name that is output before the opening brace.
+		*/
+		virtual const std::string& GetName() const = 0;
+
+		/*!
+			Options used for the scope.
+		*/
+		virtual const ScopeOptions& GetOptions() const = 0;
+
+		/*!
+			Call the callback that is output between the braces.
+		*/
+		virtual void VisitCallback(Writer& writer) = 0;
+
+		inline void Visit(Writer& writer) override
+		{
+			Render(writer, GetName(), GetOptions(), [this](Writer& writer) {
+				VisitCallback(writer);
+			});
+		}
+
+		/*!
+			Output a scope with the specified `name` and `options` and call
+			`callback` between the braces, without constructing a command.
+		*/
+		template <typename TInner>
+		inline static void Render(
+			Writer& writer,
+			std::string_view name,
+			const ScopeOptions& options,
+			TInner&& callback)
+		{
+			PANINI_TRACE_SPAN_LABEL("scope", "Scope", name);
+
+			const BraceBreakingStyle breakingStyle =
+				options.breakingStyle == BraceBreakingStyle::Inherit
+					? writer.GetBraceBreakingStyle()
+					: options.breakingStyle;
+
+			if (!name.empty())
+			{
+				writer << name;
+
+				if (breakingStyle == BraceBreakingStyle::Attach)
+				{
+					writer << options.chunkAttachSpacing;
+				}
+			}
+
+			BracesCommand::Render(writer, options, callback);
+		}
+
+	};
+
+	/*!
+		\brief Scope command that stores its callback without type erasure.
+
+		\ingroup Commands
+
+		The callback is stored inline, so constructing the command does not
+		allocate memory for the callback regardless of what it captures. Use
+		\ref MakeScope to deduce the type of the callback.
+
+		The name is still stored in a `std::string`, which allocates when it
+		doesn't fit in the small string buffer.
+
+		\sa Scope
+	*/
+
+	template <typename TCallback>
+	class BasicScope
+		: public ScopeCommand
+	{
+
+	public:
+		/*!
+			Create a Scope with a `name` and a `callback` that are both moved
+			into the instance.
+		*/
+		inline explicit BasicScope(
+			std::string&& name,
+			TCallback&& callback,
+			const ScopeOptions& options = ScopeOptions{}) noexcept(std::is_nothrow_move_constructible_v<TCallback>)
+			: m_name(std::move(name))
+			, m_callback(std::move(callback))
+			, m_options(options)
+		{
+		}
+
+		/*!
+			Create a Scope with a `name` that is copied and a `callback` that
+			is moved into the instance.
+		*/
+		inline explicit BasicScope(
+			const std::string& name,
+			TCallback&& callback,
+			const ScopeOptions& options = ScopeOptions{})
+			: m_name(name)
+			, m_callback(std::move(callback))
+			, m_options(options)
+		{
+		}
+
+		inline const std::string& GetName() const override
+		{
+			return m_name;
+		}
+
+		/*!
+			Callback that is called between the opening and closing braces.
+		*/
+		inline const TCallback& GetCallback() const
+		{
+			return m_callback;
+		}
+
+		inline const ScopeOptions& GetOptions() const override
+		{
+			return m_options;
+		}
+
+		inline void VisitCallback(Writer& writer) override
+		{
+			m_callback(writer);
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			Render(writer, m_name, m_options, m_callback);
+		}
+
+	protected:
+		std::string m_name;
+		TCallback m_callback;
+		ScopeOptions m_options;
+
+	};
+
 	/*!
 		\brief Command for outputting a scope with braces.
 
@@ -67,7 +225,7 @@ namespace panini
 	*/
 
 	class Scope
-		: public Command
+		: public BasicScope<std::function<void(Writer&)>>
 	{
 
 	public:
@@ -95,8 +253,7 @@ namespace panini
 			std::string&& name,
 			TCallback&& callback,
 			BraceBreakingStyle breakingStyle = BraceBreakingStyle::Inherit) noexcept
-			: m_name(name)
-			, m_callback(std::move(callback))
+			: BasicScope(std::move(name), std::move(callback))
 		{
 			m_options.breakingStyle = breakingStyle;
 		}
@@ -119,8 +276,7 @@ namespace panini
 			const std::string& name,
 			TCallback&& callback,
 			BraceBreakingStyle breakingStyle = BraceBreakingStyle::Inherit) noexcept
-			: m_name(name)
-			, m_callback(std::move(callback))
+			: BasicScope(name, std::move(callback))
 		{
 			m_options.breakingStyle = breakingStyle;
 		}
@@ -134,9 +290,7 @@ namespace panini
 			std::string&& name,
 			TCallback&& callback,
 			const ScopeOptions& options) noexcept
-			: m_name(name)
-			, m_callback(std::move(callback))
-			, m_options(options)
+			: BasicScope(std::move(name), std::move(callback), options)
 		{
 		}
 
@@ -149,37 +303,41 @@ namespace panini
 			const std::string& name,
 			TCallback&& callback,
 			const ScopeOptions& options) noexcept
-			: m_name(name)
-			, m_callback(std::move(callback))
-			, m_options(options)
+			: BasicScope(name, std::move(callback), options)
 		{
 		}
 
-		inline void Visit(Writer& writer) override
-		{
-			const BraceBreakingStyle breakingStyle =
-				m_options.breakingStyle == BraceBreakingStyle::Inherit
-					? writer.GetBraceBreakingStyle()
-					: m_options.breakingStyle;
+	};
 
-			if (!m_name.empty())
-			{
-				writer << m_name;
+	/*!
+		Create a Scope command that stores the `callback` without allocating
+		memory for it.
 
-				if (breakingStyle == BraceBreakingStyle::Attach)
-				{
-					writer << m_options.chunkAttachSpacing;
-				}
-			}
+		The `name` is still copied into the command.
 
-			writer << Braces(std::move(m_callback), m_options);
-		}
+		\ingroup Commands
 
-	private:
-		std::string m_name;
-		TCallback m_callback;
-		ScopeOptions m_options;
+		Example:
 
-	};
+		\code{.cpp}
+			writer << MakeScope("struct Vector2", [&fields](Writer& writer) {
+				for (const std::string& field : fields)
+				{
+					writer << "float " << field << ";" << NextLine();
+				}
+			}) << ";";
+		\endcode
+	*/
+	template <typename TCallback>
+	inline BasicScope<std::decay_t<TCallback>> MakeScope(
+		std::string name,
+		TCallback&& callback,
+		const ScopeOptions& options = ScopeOptions{})
+	{
+		return BasicScope<std::decay_t<TCallback>>(
+			std::move(name),
+			std::decay_t<TCallback>(std::forward<TCallback>(callback)),
+			options);
+	}
 
 };
@@ -0,0 +1,90 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "commands/Command.hpp"
+#include "data/Fragment.hpp"
+
+namespace panini
+{
+
+	/*!
+		\brief Command that outputs a \ref Fragment at the current position
+		of the writer.
+
+		\ingroup Commands
+
+		The lines of the fragment are indented relative to the indentation
+		of the writer, as if the fragment had been written there directly.
+		The fragment is not copied and must outlive the command.
+
+		Example:
+
+		\code{.cpp}
+			Fragment body;
+
+			{
+				FragmentWriter fragmentWriter(body);
+				fragmentWriter << "return x * x;" << NextLine();
+			}
+
+			writer << "int square(int x)" << Braces([&body](Writer& writer) {
+				writer << Splice(body);
+			});
+		\endcode
+
+		Output:
+
+		\code{.cpp}
+			int square(int x)
+			{
+				return x * x;
+			}
+		\endcode
+
+		\sa FragmentWriter
+	*/
+
+	class Splice
+		: public Command
+	{
+
+	public:
+		/*!
+			Create a command for the `fragment`.
+		*/
+		inline explicit Splice(const Fragment& fragment)
+			: m_fragment(fragment)
+		{
+		}
+
+		inline void Visit(Writer& writer) override
+		{
+			m_fragment.Render(writer);
+		}
+
+	private:
+		const Fragment& m_fragment;
+
+	};
+
+};
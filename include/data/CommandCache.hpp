@@ -0,0 +1,456 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/DataFile.hpp"
+#include "data/Fragment.hpp"
+#include "data/Hash64.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Stores rendered output of commands in a directory, so it can
+		be replayed instead of rendered again.
+
+		\ingroup Data
+
+		Every entry is a \ref Fragment stored in its own file, named after
+		its key. Fragments are stored relative to the indentation of the
+		writer, so a cached entry can be replayed at any level of
+		indentation.
+
+		The total size of the entries is limited. When an entry is stored and
+		the cache grows beyond its maximum size, the least recently used
+		entries are removed. The order in which entries were used is kept in
+		the modification time of their files, so it is preserved between
+		runs.
+
+		Entries that fail their checksum are treated as a miss and removed.
+
+		Entries can be loaded and stored from multiple threads.
+
+		\sa CachedCommand
+	*/
+
+	class CommandCache
+	{
+
+	public:
+		/*!
+			Construct a cache in `directory` and index the entries that are
+			already there. The directory is created when the first entry is
+			stored.
+
+			\param directory     Directory to store the entries in.
+			\param maxByteSize   Maximum size of all entry files combined.
+		*/
+		inline explicit CommandCache(
+			const std::filesystem::path& directory,
+			uint64_t maxByteSize = 64 * 1024 * 1024)
+			: m_directory(directory)
+			, m_maxByteSize(maxByteSize)
+		{
+			Index();
+		}
+
+		CommandCache(const CommandCache&) = delete;
+		CommandCache& operator = (const CommandCache&) = delete;
+
+		/*!
+			Directory where entries are stored.
+		*/
+		inline const std::filesystem::path& GetDirectory() const
+		{
+			return m_directory;
+		}
+
+		/*!
+			Maximum size of all entries combined, in bytes.
+		*/
+		inline uint64_t GetMaxByteSize() const
+		{
+			return m_maxByteSize;
+		}
+
+		/*!
+			Size of all entries combined, in bytes.
+		*/
+		inline uint64_t GetByteSize() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			return m_byteSize;
+		}
+
+		/*!
+			Number of entries in the cache.
+		*/
+		inline size_t GetEntryCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			return m_entries.size();
+		}
+
+		/*!
+			Number of times an entry was loaded.
+		*/
+		inline uint64_t GetHitCount() const
+		{
+			return m_hitCount.load(std::memory_order_relaxed);
+		}
+
+		/*!
+			Number of times an entry was not found or could not be loaded.
+		*/
+		inline uint64_t GetMissCount() const
+		{
+			return m_missCount.load(std::memory_order_relaxed);
+		}
+
+		/*!
+			Number of entries removed to stay within the maximum size.
+		*/
+		inline uint64_t GetEvictionCount() const
+		{
+			return m_evictionCount.load(std::memory_order_relaxed);
+		}
+
+		/*!
+			Check if an entry exists for `key`, without loading it.
+		*/
+		inline bool Contains(uint64_t key) const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			return m_entries.find(key) != m_entries.end();
+		}
+
+		/*!
+			Load the entry for `key` into `fragment` and mark it as the most
+			recently used entry.
+
+			\return True on a hit.
+		*/
+		inline bool Load(uint64_t key, Fragment& fragment)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (m_entries.find(key) == m_entries.end())
+				{
+					m_missCount.fetch_add(1, std::memory_order_relaxed);
+
+					return false;
+				}
+			}
+
+			const std::filesystem::path path = GetEntryPath(key);
+
+			std::string contents;
+			if (!DataFile::Read(path, contents) ||
+				!Parse(contents, fragment))
+			{
+				// the entry was removed or corrupted, a corrupted file would
+				// otherwise be indexed again on the next run
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				std::error_code error;
+				std::filesystem::remove(path, error);
+
+				RemoveEntry(key);
+				m_missCount.fetch_add(1, std::memory_order_relaxed);
+
+				return false;
+			}
+
+			std::error_code error;
+			std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto found = m_entries.find(key);
+			if (found != m_entries.end())
+			{
+				m_order.splice(m_order.begin(), m_order, found->second.order);
+			}
+
+			m_hitCount.fetch_add(1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		/*!
+			Store the `fragment` as the entry for `key`, replacing the
+			previous entry, and evict the least recently used entries when the
+			cache is too large.
+
+			\return False if the entry could not be written, or if it is
+			larger than the cache.
+		*/
+		inline bool Store(uint64_t key, const Fragment& fragment)
+		{
+			std::string contents(s_Header);
+			fragment.Serialize(contents);
+
+			const uint64_t checksum = Hash64::Compute(contents);
+			for (size_t i = 0; i < 8; ++i)
+			{
+				contents.push_back(static_cast<char>((checksum >> (i * 8)) & 0xFF));
+			}
+
+			if (contents.size() > m_maxByteSize)
+			{
+				return false;
+			}
+
+			std::error_code error;
+			std::filesystem::create_directories(m_directory, error);
+
+			// entries are written to a temporary file first, so an
+			// interrupted store can't leave a partial entry
+
+			const std::filesystem::path path = GetEntryPath(key);
+			std::filesystem::path temporaryPath = path;
+			temporaryPath += ".tmp" + std::to_string(m_temporaryCount.fetch_add(1, std::memory_order_relaxed));
+
+			if (!DataFile::Write(path, contents, temporaryPath))
+			{
+				return false;
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			RemoveEntry(key);
+
+			m_order.push_front(key);
+			m_entries.emplace(key, Entry{ contents.size(), m_order.begin() });
+			m_byteSize += contents.size();
+
+			Evict();
+
+			return true;
+		}
+
+		/*!
+			Remove all entries from the cache and from disk.
+		*/
+		inline void Clear()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			for (const auto& [key, entry] : m_entries)
+			{
+				std::error_code error;
+				std::filesystem::remove(GetEntryPath(key), error);
+			}
+
+			m_entries.clear();
+			m_order.clear();
+			m_byteSize = 0;
+		}
+
+	private:
+		struct Entry
+		{
+			uint64_t size = 0;
+			std::list<uint64_t>::iterator order;
+		};
+
+		inline void Index()
+		{
+			std::error_code error;
+			std::filesystem::directory_iterator it(m_directory, error);
+			if (error)
+			{
+				return;
+			}
+
+			struct Found
+			{
+				uint64_t key = 0;
+				uint64_t size = 0;
+				std::filesystem::file_time_type usedTime;
+			};
+			std::vector<Found> found;
+
+			for (; it != std::filesystem::directory_iterator(); it.increment(error))
+			{
+				if (error)
+				{
+					break;
+				}
+
+				Found entry;
+				if (!it->is_regular_file(error) ||
+					it->path().extension() != s_Extension ||
+					!ParseKey(it->path().stem().string(), entry.key))
+				{
+					continue;
+				}
+
+				entry.size = it->file_size(error);
+				entry.usedTime = it->last_write_time(error);
+				if (!error)
+				{
+					found.push_back(entry);
+				}
+			}
+
+			// most recently used first
+
+			std::sort(found.begin(), found.end(), [](const Found& left, const Found& right) {
+				return left.usedTime > right.usedTime;
+			});
+
+			for (const Found& entry : found)
+			{
+				m_order.push_back(entry.key);
+				m_entries.emplace(entry.key, Entry{ entry.size, std::prev(m_order.end()) });
+				m_byteSize += entry.size;
+			}
+
+			Evict();
+		}
+
+		inline void Evict()
+		{
+			while (m_byteSize > m_maxByteSize &&
+				!m_order.empty())
+			{
+				const uint64_t key = m_order.back();
+
+				std::error_code error;
+				std::filesystem::remove(GetEntryPath(key), error);
+
+				RemoveEntry(key);
+				m_evictionCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		inline void RemoveEntry(uint64_t key)
+		{
+			auto found = m_entries.find(key);
+			if (found == m_entries.end())
+			{
+				return;
+			}
+
+			m_byteSize -= found->second.size;
+			m_order.erase(found->second.order);
+			m_entries.erase(found);
+		}
+
+		inline static bool Parse(std::string_view contents, Fragment& fragment)
+		{
+			if (contents.size() < s_Header.size() + 8 ||
+				contents.substr(0, s_Header.size()) != s_Header)
+			{
+				return false;
+			}
+
+			// the last 8 bytes contain the checksum of everything before it
+
+			const std::string_view body = contents.substr(0, contents.size() - 8);
+
+			uint64_t checksum = 0;
+			for (size_t i = 0; i < 8; ++i)
+			{
+				checksum |= static_cast<uint64_t>(static_cast<uint8_t>(contents[body.size() + i])) << (i * 8);
+			}
+
+			return
+				checksum == Hash64::Compute(body) &&
+				fragment.Deserialize(body.substr(s_Header.size()));
+		}
+
+		inline static bool ParseKey(const std::string& text, uint64_t& key)
+		{
+			if (text.size() != 16)
+			{
+				return false;
+			}
+
+			key = 0;
+
+			for (char character : text)
+			{
+				key <<= 4;
+
+				if (character >= '0' && character <= '9')
+				{
+					key |= static_cast<uint64_t>(character - '0');
+				}
+				else if (character >= 'a' && character <= 'f')
+				{
+					key |= static_cast<uint64_t>(character - 'a' + 10);
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		inline std::filesystem::path GetEntryPath(uint64_t key) const
+		{
+			std::string name = DataFile::ToHex(key);
+			name += s_Extension;
+
+			return m_directory / name;
+		}
+
+	private:
+		static constexpr std::string_view s_Header = "panini-cache 1\n";
+		static constexpr std::string_view s_Extension = ".cache";
+
+		std::filesystem::path m_directory;
+		uint64_t m_maxByteSize = 0;
+
+		mutable std::mutex m_mutex;
+		std::unordered_map<uint64_t, Entry> m_entries;
+		std::list<uint64_t> m_order;
+		uint64_t m_byteSize = 0;
+
+		std::atomic<uint64_t> m_hitCount{ 0 };
+		std::atomic<uint64_t> m_missCount{ 0 };
+		std::atomic<uint64_t> m_evictionCount{ 0 };
+		std::atomic<uint64_t> m_temporaryCount{ 0 };
+
+	};
+
+};
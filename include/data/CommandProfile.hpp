@@ -0,0 +1,86 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace panini
+{
+
+	/*!
+		\brief Cost of all commands of a single type, measured by the
+		\ref ProfilingWriter.
+
+		\ingroup Data
+
+		Inclusive values include the commands visited by the command, like
+		those in the callback of a \ref Scope. Exclusive values only count
+		the command itself.
+	*/
+
+	struct CommandProfile
+	{
+		/*!
+			Name of the command type, without template arguments.
+		*/
+		std::string name;
+
+		/*!
+			Number of times a command of this type was visited.
+		*/
+		uint64_t invocationCount = 0;
+
+		/*!
+			Time spent visiting the commands, in nanoseconds.
+		*/
+		uint64_t inclusiveTime = 0;
+
+		/*!
+			Time spent visiting the commands, excluding the commands they
+			visited, in nanoseconds.
+		*/
+		uint64_t exclusiveTime = 0;
+
+		/*!
+			Number of chunks written, including those of nested commands.
+		*/
+		uint64_t inclusiveChunkCount = 0;
+
+		/*!
+			Number of chunks written by the commands themselves.
+		*/
+		uint64_t exclusiveChunkCount = 0;
+
+		/*!
+			Number of bytes written, including those of nested commands.
+			Indentation and new lines are not counted.
+		*/
+		uint64_t inclusiveByteCount = 0;
+
+		/*!
+			Number of bytes written by the commands themselves.
+		*/
+		uint64_t exclusiveByteCount = 0;
+	};
+
+};
@@ -21,8 +21,13 @@
 
 #pragma once
 
+#include "data/DependencyDatabase.hpp"
+#include "data/OutputManifest.hpp"
 #include "data/WriterConfig.hpp"
 
+#include <filesystem>
+#include <vector>
+
 namespace panini
 {
 
@@ -39,6 +44,29 @@ namespace panini
 			File that will be compared against the output.
 		*/
 		std::filesystem::path filePath;
+
+		/*!
+			Optional manifest of previous outputs. When the manifest has a
+			trusted entry for the file, the output is hashed instead of
+			compared and the file is not read at all.
+		*/
+		OutputManifest* manifest = nullptr;
+
+		/*!
+			Optional database of the inputs outputs were generated from. When
+			the writer is committed, the \ref inputs are recorded for the
+			output, so generating it again can be skipped while they are
+			unchanged.
+
+			\sa DependencyDatabase::IsUpToDate
+		*/
+		DependencyDatabase* dependencies = nullptr;
+
+		/*!
+			Files the output is generated from, recorded in the
+			\ref dependencies database when the writer is committed.
+		*/
+		std::vector<std::filesystem::path> inputs = {};
 	};
 
 };
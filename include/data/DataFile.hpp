@@ -0,0 +1,320 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/Hash64.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace panini
+{
+
+	/*!
+		\brief Reads and writes the files that keep the state of a generator
+		between runs.
+
+		\ingroup Data
+
+		Shared by the \ref OutputManifest, the \ref DependencyDatabase and
+		the \ref CommandCache. Files are written to a temporary path first
+		and then renamed, so an interrupted write can't leave a partial file.
+
+		Text files describe a file on every line with a record:
+
+		\code{.unparsed}
+			<hash> <size> <modified time> <path>
+		\endcode
+
+		The last line contains the checksum of everything before it, so a
+		file that was corrupted is discarded as a whole.
+	*/
+
+	class DataFile
+	{
+
+	public:
+		/*!
+			Read the entire contents of the file at `path`.
+
+			\return False if the file could not be read.
+		*/
+		inline static bool Read(const std::filesystem::path& path, std::string& contents)
+		{
+			std::ifstream stream(path, std::ios::in | std::ios::binary | std::ios::ate);
+			if (!stream.is_open())
+			{
+				return false;
+			}
+
+			const std::streamoff size = stream.tellg();
+			if (size < 0)
+			{
+				return false;
+			}
+
+			contents.resize(static_cast<size_t>(size));
+			stream.seekg(0);
+			stream.read(contents.data(), size);
+
+			return stream.gcount() == size;
+		}
+
+		/*!
+			Write the `contents` to `temporaryPath` and rename it to `path`.
+			The temporary file is removed when anything fails.
+
+			\return False if the file could not be written.
+		*/
+		inline static bool Write(
+			const std::filesystem::path& path,
+			std::string_view contents,
+			const std::filesystem::path& temporaryPath)
+		{
+			std::ofstream stream(temporaryPath, std::ios::out | std::ios::binary);
+			if (!stream.is_open())
+			{
+				return false;
+			}
+
+			stream.write(contents.data(), contents.size());
+			stream.close();
+
+			std::error_code error;
+
+			if (stream.fail())
+			{
+				std::filesystem::remove(temporaryPath, error);
+
+				return false;
+			}
+
+			std::filesystem::rename(temporaryPath, path, error);
+			if (error)
+			{
+				std::filesystem::remove(temporaryPath, error);
+
+				return false;
+			}
+
+			return true;
+		}
+
+		/*!
+			Append a line with the checksum of the `contents` so far.
+		*/
+		inline static void AppendChecksum(std::string& contents)
+		{
+			const uint64_t checksum = Hash64::Compute(contents);
+			contents += s_ChecksumPrefix;
+			contents += ToHex(checksum);
+			contents += '\n';
+		}
+
+		/*!
+			Check that the `contents` start with the `header` and end with a
+			valid checksum line.
+
+			\param lines  Lines between the header and the checksum line.
+
+			\return False if the header or the checksum doesn't match.
+		*/
+		inline static bool ParseChecksum(std::string_view contents, std::string_view header, std::string_view& lines)
+		{
+			if (contents.substr(0, header.size()) != header)
+			{
+				return false;
+			}
+
+			size_t checksumOffset = contents.rfind(s_ChecksumPrefix);
+			if (checksumOffset == std::string_view::npos ||
+				checksumOffset < header.size())
+			{
+				return false;
+			}
+
+			std::string_view checksumLine = contents.substr(checksumOffset + s_ChecksumPrefix.size());
+			if (checksumLine.empty() ||
+				checksumLine.back() != '\n')
+			{
+				return false;
+			}
+
+			uint64_t checksum = 0;
+			if (!ParseNumber(checksumLine.substr(0, checksumLine.size() - 1), 16, checksum) ||
+				checksum != Hash64::Compute(contents.substr(0, checksumOffset)))
+			{
+				return false;
+			}
+
+			lines = contents.substr(header.size(), checksumOffset - header.size());
+
+			return true;
+		}
+
+		/*!
+			Append a record line describing a file.
+		*/
+		inline static void AppendRecord(
+			std::string& contents,
+			uint64_t hash,
+			uint64_t size,
+			int64_t modifiedTime,
+			std::string_view key)
+		{
+			contents += ToHex(hash);
+			contents += ' ';
+			contents += std::to_string(size);
+			contents += ' ';
+			contents += std::to_string(modifiedTime);
+			contents += ' ';
+			contents += key;
+			contents += '\n';
+		}
+
+		/*!
+			Parse a record line, without its new line.
+
+			\return False if the line is not a valid record.
+		*/
+		inline static bool ParseRecord(
+			std::string_view line,
+			uint64_t& hash,
+			uint64_t& size,
+			int64_t& modifiedTime,
+			std::string_view& key)
+		{
+			std::string_view fields[3];
+			for (std::string_view& field : fields)
+			{
+				size_t separator = line.find(' ');
+				if (separator == std::string_view::npos)
+				{
+					return false;
+				}
+
+				field = line.substr(0, separator);
+				line.remove_prefix(separator + 1);
+			}
+
+			uint64_t time = 0;
+			if (line.empty() ||
+				!ParseNumber(fields[0], 16, hash) ||
+				!ParseNumber(fields[1], 10, size) ||
+				!ParseNumber(fields[2], 10, time))
+			{
+				return false;
+			}
+
+			modifiedTime = static_cast<int64_t>(time);
+			key = line;
+
+			return true;
+		}
+
+		/*!
+			Parse a number in `base`. Negative numbers are stored as their
+			two's complement.
+
+			\return False if the text is not a number as a whole.
+		*/
+		inline static bool ParseNumber(std::string_view text, int base, uint64_t& value)
+		{
+			if (text.empty() ||
+				text.size() > 20)
+			{
+				return false;
+			}
+
+			char buffer[24] = { 0 };
+			text.copy(buffer, text.size());
+
+			bool isNegative = buffer[0] == '-';
+
+			char* end = nullptr;
+			value = isNegative
+				? static_cast<uint64_t>(::strtoll(buffer, &end, base))
+				: ::strtoull(buffer, &end, base);
+
+			return end == buffer + text.size();
+		}
+
+		/*!
+			Format a number as 16 lowercase hexadecimal digits.
+		*/
+		inline static std::string ToHex(uint64_t value)
+		{
+			static const char s_Digits[] = "0123456789abcdef";
+
+			std::string result(16, '0');
+			for (size_t i = 16; i > 0; --i)
+			{
+				result[i - 1] = s_Digits[value & 0xF];
+				value >>= 4;
+			}
+
+			return result;
+		}
+
+		/*!
+			Get the key that identifies a file, which is its normalized
+			absolute path.
+		*/
+		inline static std::string GetKey(const std::filesystem::path& path)
+		{
+			std::error_code error;
+			std::filesystem::path absolute = std::filesystem::absolute(path, error);
+
+			return (error ? path : absolute).lexically_normal().generic_string();
+		}
+
+		/*!
+			Get the size and modification time of the file at `path`.
+
+			\return False if the file doesn't exist.
+		*/
+		inline static bool Stat(const std::filesystem::path& path, uint64_t& size, int64_t& modifiedTime)
+		{
+			std::error_code error;
+
+			size = std::filesystem::file_size(path, error);
+			if (error)
+			{
+				return false;
+			}
+
+			modifiedTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+			return !error;
+		}
+
+	private:
+		static constexpr std::string_view s_ChecksumPrefix = "checksum ";
+
+	};
+
+};
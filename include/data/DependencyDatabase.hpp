@@ -0,0 +1,589 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/DataFile.hpp"
+#include "data/Hash64.hpp"
+#include "data/MappedFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Records the input files every output was generated from, so
+		generators can be skipped for outputs whose inputs did not change.
+
+		\ingroup Data
+
+		For every output, the database stores the size, modification time
+		and \ref Hash64 of its input files, and the size and modification
+		time of the output itself. An output is up to date when it was
+		generated by the same version of the generator, the output was not
+		modified since and the contents of all of its inputs are unchanged.
+
+		Inputs are only hashed when their size or modification time differ
+		from what was recorded, or when they were modified at the same time or
+		after the database was last saved. Every input is hashed at most once
+		per run, no matter how many outputs depend on it.
+
+		The database is loaded from disk when it is constructed and saved
+		when it is destroyed, if it was modified. Changing the generator
+		version discards all entries. A database that can't be parsed or
+		fails its checksum is discarded as a whole.
+
+		Entries can be checked and recorded from multiple threads.
+
+		Example:
+
+		\code{.cpp}
+			DependencyDatabase dependencies("intermediate/dependencies.txt", "GameObjects 1.2");
+
+			if (!dependencies.IsUpToDate("GameObjects.hpp", { "Hierarchy.ini" }))
+			{
+				FileWriterConfig config;
+				config.targetPath = "GameObjects.hpp";
+				config.dependencies = &dependencies;
+				config.inputs = { "Hierarchy.ini" };
+
+				FileWriter writer(config);
+				GenerateGameObjects(writer);
+			}
+		\endcode
+
+		\sa CompareWriterConfig, FileWriterConfig
+	*/
+
+	class DependencyDatabase
+	{
+
+	public:
+		/*!
+			Construct a database and load its entries from `databasePath`,
+			if it exists.
+
+			\param databasePath      Path where the database is stored.
+			\param generatorVersion  Entries recorded by a different version
+			                         of the generator are discarded.
+		*/
+		inline DependencyDatabase(
+			const std::filesystem::path& databasePath,
+			std::string_view generatorVersion)
+			: m_databasePath(databasePath)
+			, m_generatorVersion(generatorVersion)
+		{
+			Load();
+		}
+
+		DependencyDatabase(const DependencyDatabase&) = delete;
+		DependencyDatabase& operator = (const DependencyDatabase&) = delete;
+
+		/*!
+			Saves the database automatically if it was modified.
+		*/
+		inline ~DependencyDatabase()
+		{
+			if (m_isModified)
+			{
+				Save();
+			}
+		}
+
+		/*!
+			Path where the database is stored.
+		*/
+		inline const std::filesystem::path& GetDatabasePath() const
+		{
+			return m_databasePath;
+		}
+
+		/*!
+			Version of the generator the entries are recorded for.
+		*/
+		inline const std::string& GetGeneratorVersion() const
+		{
+			return m_generatorVersion;
+		}
+
+		/*!
+			Check if the database on disk was discarded because it was
+			corrupted.
+		*/
+		inline bool IsCorrupted() const
+		{
+			return m_isCorrupted;
+		}
+
+		/*!
+			Number of outputs in the database.
+		*/
+		inline size_t GetEntryCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			return m_entries.size();
+		}
+
+		/*!
+			Number of times \ref IsUpToDate was called.
+		*/
+		inline uint64_t GetCheckCount() const
+		{
+			return m_checkCount.load(std::memory_order_relaxed);
+		}
+
+		/*!
+			Number of times \ref IsUpToDate found an output to be up to date.
+		*/
+		inline uint64_t GetUpToDateCount() const
+		{
+			return m_upToDateCount.load(std::memory_order_relaxed);
+		}
+
+		/*!
+			Check if the `output` is up to date with the inputs it was
+			generated from.
+
+			\param output  Path of the generated file.
+			\param inputs  Inputs the caller knows the output depends on.
+			               Every one of them must have been recorded, in
+			               addition to the inputs added while generating.
+
+			\return True if generating the output again can be skipped.
+		*/
+		inline bool IsUpToDate(
+			const std::filesystem::path& output,
+			const std::vector<std::filesystem::path>& inputs = {})
+		{
+			m_checkCount.fetch_add(1, std::memory_order_relaxed);
+
+			Entry entry;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				auto found = m_entries.find(DataFile::GetKey(output));
+				if (found == m_entries.end())
+				{
+					return false;
+				}
+
+				entry = found->second;
+
+				// an output modified in the same tick as the database was
+				// saved could have changed after it was recorded
+
+				if (entry.output.modifiedTime >= m_savedTime)
+				{
+					return false;
+				}
+			}
+
+			FileState current;
+			if (!DataFile::Stat(output, current.size, current.modifiedTime) ||
+				current.size != entry.output.size ||
+				current.modifiedTime != entry.output.modifiedTime)
+			{
+				return false;
+			}
+
+			for (const std::filesystem::path& input : inputs)
+			{
+				const std::string key = DataFile::GetKey(input);
+
+				auto found = std::find_if(entry.inputs.begin(), entry.inputs.end(), [&key](const InputState& it) {
+					return it.key == key;
+				});
+				if (found == entry.inputs.end())
+				{
+					return false;
+				}
+			}
+
+			for (const InputState& recorded : entry.inputs)
+			{
+				InputState state;
+				if (!GetInputState(recorded.key, &recorded, state) ||
+					state.file.hash != recorded.file.hash)
+				{
+					return false;
+				}
+			}
+
+			m_upToDateCount.fetch_add(1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		/*!
+			Record the `inputs` the `output` was generated from, after it was
+			written or found to be unchanged.
+
+			\return False if the output or one of the inputs could not be
+			read, in which case the entry is removed.
+		*/
+		inline bool Record(
+			const std::filesystem::path& output,
+			const std::vector<std::filesystem::path>& inputs)
+		{
+			Entry entry;
+
+			bool isValid = DataFile::Stat(output, entry.output.size, entry.output.modifiedTime);
+
+			entry.inputs.reserve(inputs.size());
+
+			for (const std::filesystem::path& input : inputs)
+			{
+				InputState state;
+				if (!isValid ||
+					!GetInputState(DataFile::GetKey(input), nullptr, state))
+				{
+					isValid = false;
+
+					break;
+				}
+
+				// inputs can be declared more than once
+
+				auto found = std::find_if(entry.inputs.begin(), entry.inputs.end(), [&state](const InputState& it) {
+					return it.key == state.key;
+				});
+				if (found == entry.inputs.end())
+				{
+					entry.inputs.push_back(std::move(state));
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (!isValid)
+			{
+				if (m_entries.erase(DataFile::GetKey(output)) > 0)
+				{
+					m_isModified = true;
+				}
+
+				return false;
+			}
+
+			m_entries[DataFile::GetKey(output)] = std::move(entry);
+			m_isModified = true;
+
+			return true;
+		}
+
+		/*!
+			Remove the entry for `output`, so it is never up to date.
+		*/
+		inline void Remove(const std::filesystem::path& output)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (m_entries.erase(DataFile::GetKey(output)) > 0)
+			{
+				m_isModified = true;
+			}
+		}
+
+		/*!
+			Write the database to disk. A temporary file is written first and
+			then renamed, so an interrupted save can't leave a partial
+			database.
+
+			\return True if the database was saved.
+		*/
+		inline bool Save()
+		{
+			if (m_databasePath.empty())
+			{
+				return false;
+			}
+
+			std::string contents;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				contents += s_Header;
+				contents += s_VersionPrefix;
+				contents += DataFile::ToHex(Hash64::Compute(m_generatorVersion));
+				contents += '\n';
+
+				for (const auto& [key, entry] : m_entries)
+				{
+					AppendState(contents, s_OutputPrefix, entry.output, key);
+
+					for (const InputState& input : entry.inputs)
+					{
+						AppendState(contents, s_InputPrefix, input.file, input.key);
+					}
+				}
+
+				m_isModified = false;
+			}
+
+			DataFile::AppendChecksum(contents);
+
+			std::filesystem::path temporaryPath = m_databasePath;
+			temporaryPath += ".tmp";
+
+			if (!DataFile::Write(m_databasePath, contents, temporaryPath))
+			{
+				return false;
+			}
+
+			std::error_code error;
+			auto savedTime = std::filesystem::last_write_time(m_databasePath, error);
+			if (!error)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				m_savedTime = savedTime.time_since_epoch().count();
+			}
+
+			return true;
+		}
+
+	private:
+		struct FileState
+		{
+			uint64_t size = 0;
+			uint64_t hash = 0;
+			int64_t modifiedTime = 0;
+		};
+
+		struct InputState
+		{
+			std::string key;
+			FileState file;
+		};
+
+		struct Entry
+		{
+			FileState output;
+			std::vector<InputState> inputs;
+		};
+
+		/*
+			Find the current state of an input, hashing its contents only
+			when it wasn't seen before in this run and the `recorded` state
+			can't be trusted.
+		*/
+		inline bool GetInputState(const std::string& key, const InputState* recorded, InputState& state)
+		{
+			state.key = key;
+
+			if (!DataFile::Stat(key, state.file.size, state.file.modifiedTime))
+			{
+				return false;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				auto found = m_inputs.find(key);
+				if (found != m_inputs.end() &&
+					found->second.size == state.file.size &&
+					found->second.modifiedTime == state.file.modifiedTime)
+				{
+					state.file.hash = found->second.hash;
+
+					return true;
+				}
+
+				if (recorded != nullptr &&
+					recorded->file.size == state.file.size &&
+					recorded->file.modifiedTime == state.file.modifiedTime &&
+					recorded->file.modifiedTime < m_savedTime)
+				{
+					state.file.hash = recorded->file.hash;
+					m_inputs[key] = state.file;
+
+					return true;
+				}
+			}
+
+			MappedFile mapped(key);
+			if (!mapped.IsOpen() ||
+				mapped.GetView().size() != state.file.size)
+			{
+				return false;
+			}
+
+			state.file.hash = Hash64::Compute(mapped.GetView());
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_inputs[key] = state.file;
+
+			return true;
+		}
+
+		inline void Load()
+		{
+			std::string contents;
+			if (!DataFile::Read(m_databasePath, contents))
+			{
+				return;
+			}
+
+			// the modification time of the database is taken before its
+			// entries are trusted, see IsUpToDate()
+
+			std::error_code error;
+			auto savedTime = std::filesystem::last_write_time(m_databasePath, error);
+			if (error)
+			{
+				return;
+			}
+
+			bool isSameVersion = false;
+			if (!Parse(contents, isSameVersion))
+			{
+				m_entries.clear();
+				m_isCorrupted = true;
+
+				return;
+			}
+
+			if (!isSameVersion)
+			{
+				m_entries.clear();
+				m_isModified = true;
+
+				return;
+			}
+
+			m_savedTime = savedTime.time_since_epoch().count();
+		}
+
+		inline bool Parse(std::string_view contents, bool& isSameVersion)
+		{
+			std::string_view lines;
+			if (!DataFile::ParseChecksum(contents, s_Header, lines))
+			{
+				return false;
+			}
+
+			// version <hash of generator version>
+
+			size_t versionEnd = lines.find('\n');
+			if (versionEnd == std::string_view::npos ||
+				lines.substr(0, s_VersionPrefix.size()) != s_VersionPrefix)
+			{
+				return false;
+			}
+
+			uint64_t version = 0;
+			if (!DataFile::ParseNumber(lines.substr(s_VersionPrefix.size(), versionEnd - s_VersionPrefix.size()), 16, version))
+			{
+				return false;
+			}
+
+			isSameVersion = version == Hash64::Compute(m_generatorVersion);
+			lines.remove_prefix(versionEnd + 1);
+
+			Entry* entry = nullptr;
+
+			while (!lines.empty())
+			{
+				size_t lineEnd = lines.find('\n');
+				if (lineEnd == std::string_view::npos)
+				{
+					return false;
+				}
+
+				std::string_view line = lines.substr(0, lineEnd);
+				lines.remove_prefix(lineEnd + 1);
+
+				// output|input <record>
+
+				const bool isOutput = line.substr(0, s_OutputPrefix.size()) == s_OutputPrefix;
+				const bool isInput = line.substr(0, s_InputPrefix.size()) == s_InputPrefix;
+				if (!isOutput && !isInput)
+				{
+					return false;
+				}
+
+				line.remove_prefix(isOutput ? s_OutputPrefix.size() : s_InputPrefix.size());
+
+				FileState state;
+				std::string_view key;
+				if (!DataFile::ParseRecord(line, state.hash, state.size, state.modifiedTime, key))
+				{
+					return false;
+				}
+
+				if (isOutput)
+				{
+					entry = &m_entries[std::string(key)];
+					entry->output = state;
+				}
+				else if (entry != nullptr)
+				{
+					entry->inputs.push_back(InputState{ std::string(key), state });
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		inline static void AppendState(std::string& contents, std::string_view prefix, const FileState& state, const std::string& key)
+		{
+			contents += prefix;
+			DataFile::AppendRecord(contents, state.hash, state.size, state.modifiedTime, key);
+		}
+
+	private:
+		static constexpr std::string_view s_Header = "panini-dependencies 1\n";
+		static constexpr std::string_view s_VersionPrefix = "version ";
+		static constexpr std::string_view s_OutputPrefix = "output ";
+		static constexpr std::string_view s_InputPrefix = "input ";
+
+		std::filesystem::path m_databasePath;
+		std::string m_generatorVersion;
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, Entry> m_entries;
+		std::unordered_map<std::string, FileState> m_inputs;
+		int64_t m_savedTime = std::numeric_limits<int64_t>::min();
+		bool m_isCorrupted = false;
+		bool m_isModified = false;
+		std::atomic<uint64_t> m_checkCount{ 0 };
+		std::atomic<uint64_t> m_upToDateCount{ 0 };
+
+	};
+
+};
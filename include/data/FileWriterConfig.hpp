@@ -21,8 +21,13 @@
 
 #pragma once
 
+#include "data/DependencyDatabase.hpp"
+#include "data/FileWriterMode.hpp"
 #include "data/WriterConfig.hpp"
 
+#include <filesystem>
+#include <vector>
+
 namespace panini
 {
 
@@ -39,6 +44,44 @@ namespace panini
 			Path to the target file.
 		*/
 		std::filesystem::path targetPath;
+
+		/*!
+			How output is written to the target file.
+
+			In FileWriterMode::Commit mode, the default, all output is kept in
+			memory until the writer is committed. In
+			FileWriterMode::Streaming mode, output is written whenever the
+			buffer fills up, which keeps memory usage constant regardless of
+			the size of the output.
+
+			In FileWriterMode::ScatterGather mode, the writer keeps references
+			to pinned chunks and only copies other chunks. All output is
+			submitted to the file in batches when the writer is committed.
+		*/
+		FileWriterMode mode = FileWriterMode::Commit;
+
+		/*!
+			Size of the buffer in bytes when the writer is in
+			FileWriterMode::Streaming mode, or the size of the blocks chunks
+			are copied to in FileWriterMode::ScatterGather mode.
+		*/
+		size_t bufferSize = 64 * 1024;
+
+		/*!
+			Optional database of the inputs outputs were generated from. When
+			the writer is committed, the \ref inputs are recorded for the
+			output, so generating it again can be skipped while they are
+			unchanged.
+
+			\sa DependencyDatabase::IsUpToDate
+		*/
+		DependencyDatabase* dependencies = nullptr;
+
+		/*!
+			Files the output is generated from, recorded in the
+			\ref dependencies database when the writer is committed.
+		*/
+		std::vector<std::filesystem::path> inputs = {};
 	};
 
 };
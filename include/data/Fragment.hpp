@@ -0,0 +1,326 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "commands/AlignPop.hpp"
+#include "commands/AlignPush.hpp"
+#include "commands/IndentPop.hpp"
+#include "commands/IndentPush.hpp"
+#include "commands/NextLine.hpp"
+#include "writers/Writer.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Output rendered by a \ref FragmentWriter that can be spliced
+		into any writer.
+
+		\ingroup Data
+
+		A fragment stores the text of every line without indentation, with
+		the changes to the indentation and comment block state between the
+		lines. Chunks written on the same line are stored as a single piece
+		of text. When the fragment is rendered, the indentation and new lines
+		are applied by the target writer, starting at its current level of
+		indentation. The output is identical to writing the same chunks to
+		the target writer directly.
+
+		\sa FragmentWriter, Splice
+	*/
+
+	class Fragment
+	{
+
+	public:
+		inline Fragment() = default;
+
+		/*!
+			Check if nothing was written to the fragment.
+		*/
+		inline bool IsEmpty() const
+		{
+			return m_operations.empty();
+		}
+
+		/*!
+			Number of bytes of text, excluding indentation and new lines.
+		*/
+		inline size_t GetTextSize() const
+		{
+			return m_text.size();
+		}
+
+		/*!
+			Check if the output depends on whether the writer was on a new
+			line before anything was written to the fragment. In that case,
+			the fragment only matches the output of writing the same chunks
+			directly when it is spliced into a writer in that state.
+
+			\sa FragmentWriterConfig::isOnNewLine
+		*/
+		inline bool IsStartOfLineDependent() const
+		{
+			return m_isStartOfLineDependent;
+		}
+
+		/*!
+			Remove all output, keeping the allocated memory.
+		*/
+		inline void Clear()
+		{
+			m_text.clear();
+			m_operations.clear();
+			m_isStartOfLineDependent = false;
+		}
+
+		/*!
+			Output the fragment to a `writer`.
+		*/
+		inline void Render(Writer& writer) const
+		{
+			size_t offset = 0;
+
+			for (const Operation& operation : m_operations)
+			{
+				switch (operation.type)
+				{
+
+				case OperationType::Text:
+					writer << std::string_view(m_text.data() + offset, operation.size);
+					offset += operation.size;
+					break;
+
+				case OperationType::NextLine:
+					writer << NextLine();
+					break;
+
+				case OperationType::IndentPush:
+					writer << IndentPush();
+					break;
+
+				case OperationType::IndentPop:
+					writer << IndentPop();
+					break;
+
+				case OperationType::AlignPush:
+					writer << AlignPush(operation.size);
+					break;
+
+				case OperationType::AlignPop:
+					writer << AlignPop();
+					break;
+
+				case OperationType::CommentBlockBegin:
+					writer.SetIsInCommentBlock(true);
+					break;
+
+				case OperationType::CommentBlockEnd:
+					writer.SetIsInCommentBlock(false);
+					break;
+
+				}
+			}
+		}
+
+		/*!
+			Append the fragment to `output` in a binary format that can be
+			read back with \ref Deserialize.
+		*/
+		inline void Serialize(std::string& output) const
+		{
+			output.reserve(output.size() + 13 + m_operations.size() * 5 + m_text.size());
+
+			output.push_back(m_isStartOfLineDependent ? 1 : 0);
+			AppendNumber(output, static_cast<uint32_t>(m_operations.size()), 4);
+			AppendNumber(output, static_cast<uint64_t>(m_text.size()), 8);
+
+			for (const Operation& operation : m_operations)
+			{
+				output.push_back(static_cast<char>(operation.type));
+				AppendNumber(output, operation.size, 4);
+			}
+
+			output.append(m_text);
+		}
+
+		/*!
+			Replace the fragment with one written by \ref Serialize.
+
+			\return False if the `input` is not a valid fragment, in which
+			case the fragment is left empty.
+		*/
+		inline bool Deserialize(std::string_view input)
+		{
+			Clear();
+
+			uint64_t operationCount = 0;
+			uint64_t textSize = 0;
+
+			if (input.size() < 13 ||
+				static_cast<uint8_t>(input[0]) > 1)
+			{
+				return false;
+			}
+
+			const bool isStartOfLineDependent = input[0] == 1;
+			operationCount = ReadNumber(input.substr(1), 4);
+			textSize = ReadNumber(input.substr(5), 8);
+			input.remove_prefix(13);
+
+			if (operationCount > input.size() / 5 ||
+				input.size() - operationCount * 5 != textSize)
+			{
+				return false;
+			}
+
+			m_operations.reserve(static_cast<size_t>(operationCount));
+
+			uint64_t totalSize = 0;
+
+			for (uint64_t i = 0; i < operationCount; ++i)
+			{
+				const uint8_t type = static_cast<uint8_t>(input[0]);
+				const uint32_t size = static_cast<uint32_t>(ReadNumber(input.substr(1), 4));
+				input.remove_prefix(5);
+
+				if (type > static_cast<uint8_t>(OperationType::AlignPop) ||
+					(type != static_cast<uint8_t>(OperationType::Text) &&
+					 type != static_cast<uint8_t>(OperationType::AlignPush) &&
+					 size != 0))
+				{
+					Clear();
+
+					return false;
+				}
+
+				m_operations.push_back(Operation{ static_cast<OperationType>(type), size });
+
+				if (type == static_cast<uint8_t>(OperationType::Text))
+				{
+					totalSize += size;
+				}
+			}
+
+			if (totalSize != textSize)
+			{
+				Clear();
+
+				return false;
+			}
+
+			m_text.assign(input);
+			m_isStartOfLineDependent = isStartOfLineDependent;
+
+			return true;
+		}
+
+	private:
+		friend class FragmentWriter;
+
+		enum class OperationType : uint8_t
+		{
+			Text,
+			NextLine,
+			IndentPush,
+			IndentPop,
+			CommentBlockBegin,
+			CommentBlockEnd,
+			AlignPush,
+			AlignPop
+		};
+
+		// size is the length of text, or the number of columns for an
+		// AlignPush operation
+
+		struct Operation
+		{
+			OperationType type;
+			uint32_t size;
+		};
+
+		inline void AddText(std::string_view text)
+		{
+			m_text.append(text);
+
+			while (!text.empty())
+			{
+				const uint32_t size = static_cast<uint32_t>(std::min<size_t>(text.size(), UINT32_MAX));
+
+				// text on the same line is merged into a single chunk
+
+				if (!m_operations.empty() &&
+					m_operations.back().type == OperationType::Text &&
+					m_operations.back().size <= UINT32_MAX - size)
+				{
+					m_operations.back().size += size;
+				}
+				else
+				{
+					m_operations.push_back(Operation{ OperationType::Text, size });
+				}
+
+				text.remove_prefix(size);
+			}
+		}
+
+		inline void AddOperation(OperationType type, uint32_t size = 0)
+		{
+			m_operations.push_back(Operation{ type, size });
+		}
+
+		// numbers are stored in little-endian order
+
+		inline static void AppendNumber(std::string& output, uint64_t value, size_t byteCount)
+		{
+			for (size_t i = 0; i < byteCount; ++i)
+			{
+				output.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+			}
+		}
+
+		inline static uint64_t ReadNumber(std::string_view input, size_t byteCount)
+		{
+			uint64_t value = 0;
+
+			for (size_t i = 0; i < byteCount; ++i)
+			{
+				value |= static_cast<uint64_t>(static_cast<uint8_t>(input[i])) << (i * 8);
+			}
+
+			return value;
+		}
+
+	private:
+		std::string m_text;
+		std::vector<Operation> m_operations;
+		bool m_isStartOfLineDependent = false;
+
+	};
+
+};
@@ -0,0 +1,49 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/WriterConfig.hpp"
+
+namespace panini
+{
+
+	/*!
+		\brief Configuration for the \ref FragmentWriter class.
+
+		\ingroup WriterConfiguration
+
+		The `chunkNewLine` and `chunkIndent` settings are not used, because
+		new lines and indentation are applied by the writer the fragment is
+		spliced into.
+	*/
+
+	struct FragmentWriterConfig
+		: public WriterConfig
+	{
+		/*!
+			Whether the writer the fragment will be spliced into is expected
+			to be on a new line.
+		*/
+		bool isOnNewLine = true;
+	};
+
+};
@@ -0,0 +1,298 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string_view>
+
+namespace panini
+{
+
+	/*!
+		\brief Incremental non-cryptographic 64-bit hash.
+
+		\ingroup Data
+
+		Implements the xxHash64 algorithm. Input can be supplied in chunks of
+		any size and the digest is identical to hashing all input at once.
+		Memory usage is constant regardless of the size of the input.
+
+		Example:
+
+		\code{.cpp}
+			Hash64 hash;
+			hash.Update("Hello, ");
+			hash.Update("World!");
+
+			uint64_t digest = hash.GetDigest();
+		\endcode
+	*/
+
+	class Hash64
+	{
+
+	public:
+		/*!
+			Construct a hash with an optional `seed`.
+		*/
+		inline explicit Hash64(uint64_t seed = 0)
+		{
+			Reset(seed);
+		}
+
+		/*!
+			Hash a string in one call.
+		*/
+		inline static uint64_t Compute(std::string_view input, uint64_t seed = 0)
+		{
+			Hash64 hash(seed);
+			hash.Update(input);
+
+			return hash.GetDigest();
+		}
+
+		/*!
+			Discard all input and start over with a `seed`.
+		*/
+		inline void Reset(uint64_t seed = 0)
+		{
+			m_seed = seed;
+			m_accumulators[0] = seed + s_Prime1 + s_Prime2;
+			m_accumulators[1] = seed + s_Prime2;
+			m_accumulators[2] = seed;
+			m_accumulators[3] = seed - s_Prime1;
+			m_totalSize = 0;
+			m_bufferSize = 0;
+		}
+
+		/*!
+			Number of bytes that were hashed.
+		*/
+		inline uint64_t GetSize() const
+		{
+			return m_totalSize;
+		}
+
+		/*!
+			Add input to the hash.
+		*/
+		inline void Update(std::string_view input)
+		{
+			// an empty view may not point anywhere
+
+			if (input.empty())
+			{
+				return;
+			}
+
+			const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+			size_t size = input.size();
+
+			m_totalSize += size;
+
+			// fill the buffer first
+
+			if (m_bufferSize > 0)
+			{
+				const size_t copied = (size < s_StripeSize - m_bufferSize)
+					? size
+					: s_StripeSize - m_bufferSize;
+
+				::memcpy(m_buffer + m_bufferSize, data, copied);
+				m_bufferSize += copied;
+				data += copied;
+				size -= copied;
+
+				if (m_bufferSize < s_StripeSize)
+				{
+					return;
+				}
+
+				ConsumeStripe(m_buffer);
+				m_bufferSize = 0;
+			}
+
+			// hash complete stripes directly from the input
+
+			while (size >= s_StripeSize)
+			{
+				ConsumeStripe(data);
+				data += s_StripeSize;
+				size -= s_StripeSize;
+			}
+
+			if (size > 0)
+			{
+				::memcpy(m_buffer, data, size);
+				m_bufferSize = size;
+			}
+		}
+
+		/*!
+			Get the digest of all input so far. More input can be added
+			afterwards.
+		*/
+		inline uint64_t GetDigest() const
+		{
+			uint64_t result = 0;
+
+			if (m_totalSize >= s_StripeSize)
+			{
+				result =
+					RotateLeft(m_accumulators[0], 1) +
+					RotateLeft(m_accumulators[1], 7) +
+					RotateLeft(m_accumulators[2], 12) +
+					RotateLeft(m_accumulators[3], 18);
+
+				for (uint64_t accumulator : m_accumulators)
+				{
+					result = MergeRound(result, accumulator);
+				}
+			}
+			else
+			{
+				result = m_seed + s_Prime5;
+			}
+
+			result += m_totalSize;
+
+			// hash the remaining bytes in the buffer
+
+			const uint8_t* data = m_buffer;
+			size_t size = m_bufferSize;
+
+			while (size >= 8)
+			{
+				result ^= Round(0, Read64(data));
+				result = RotateLeft(result, 27) * s_Prime1 + s_Prime4;
+				data += 8;
+				size -= 8;
+			}
+
+			if (size >= 4)
+			{
+				result ^= static_cast<uint64_t>(Read32(data)) * s_Prime1;
+				result = RotateLeft(result, 23) * s_Prime2 + s_Prime3;
+				data += 4;
+				size -= 4;
+			}
+
+			while (size > 0)
+			{
+				result ^= static_cast<uint64_t>(*data) * s_Prime5;
+				result = RotateLeft(result, 11) * s_Prime1;
+				data++;
+				size--;
+			}
+
+			// avalanche
+
+			result ^= result >> 33;
+			result *= s_Prime2;
+			result ^= result >> 29;
+			result *= s_Prime3;
+			result ^= result >> 32;
+
+			return result;
+		}
+
+	private:
+		static constexpr uint64_t s_Prime1 = 0x9E3779B185EBCA87ULL;
+		static constexpr uint64_t s_Prime2 = 0xC2B2AE3D27D4EB4FULL;
+		static constexpr uint64_t s_Prime3 = 0x165667B19E3779F9ULL;
+		static constexpr uint64_t s_Prime4 = 0x85EBCA77C2B2AE63ULL;
+		static constexpr uint64_t s_Prime5 = 0x27D4EB2F165667C5ULL;
+		static constexpr size_t s_StripeSize = 32;
+
+		inline static uint64_t RotateLeft(uint64_t value, int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		// input is read as little-endian
+
+		inline static uint64_t Read64(const uint8_t* data)
+		{
+		#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			uint64_t result = 0;
+			for (int i = 7; i >= 0; --i)
+			{
+				result = (result << 8) | data[i];
+			}
+		#else
+			uint64_t result;
+			::memcpy(&result, data, sizeof(result));
+		#endif
+
+			return result;
+		}
+
+		inline static uint32_t Read32(const uint8_t* data)
+		{
+		#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			uint32_t result = 0;
+			for (int i = 3; i >= 0; --i)
+			{
+				result = (result << 8) | data[i];
+			}
+		#else
+			uint32_t result;
+			::memcpy(&result, data, sizeof(result));
+		#endif
+
+			return result;
+		}
+
+		inline static uint64_t Round(uint64_t accumulator, uint64_t input)
+		{
+			accumulator += input * s_Prime2;
+			accumulator = RotateLeft(accumulator, 31);
+
+			return accumulator * s_Prime1;
+		}
+
+		inline static uint64_t MergeRound(uint64_t result, uint64_t accumulator)
+		{
+			result ^= Round(0, accumulator);
+
+			return result * s_Prime1 + s_Prime4;
+		}
+
+		inline void ConsumeStripe(const uint8_t* stripe)
+		{
+			m_accumulators[0] = Round(m_accumulators[0], Read64(stripe));
+			m_accumulators[1] = Round(m_accumulators[1], Read64(stripe + 8));
+			m_accumulators[2] = Round(m_accumulators[2], Read64(stripe + 16));
+			m_accumulators[3] = Round(m_accumulators[3], Read64(stripe + 24));
+		}
+
+	private:
+		uint64_t m_seed = 0;
+		uint64_t m_accumulators[4] = { 0, 0, 0, 0 };
+		uint64_t m_totalSize = 0;
+		uint8_t m_buffer[s_StripeSize] = { 0 };
+		size_t m_bufferSize = 0;
+
+	};
+
+};
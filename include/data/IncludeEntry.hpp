@@ -21,8 +21,14 @@
 
 #pragma once
 
+#include "data/IncludePath.hpp"
 #include "data/IncludeStyle.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <stdint.h>
+#include <string>
+
 namespace panini
 {
 
@@ -30,6 +36,14 @@ namespace panini
 		\brief Data for includes.
 
 		\ingroup Data
+
+		The path is converted to the string that is output and its number of
+		forward slashes is counted when the entry is constructed. Call
+		\ref Update after modifying the path directly.
+
+		Entries constructed from an \ref IncludePath refer to the interned
+		path and leave `path` empty. Use \ref GetPath to read the path of
+		any entry.
 	*/
 
 	struct IncludeEntry
@@ -48,6 +62,7 @@ namespace panini
 			, style(_style)
 			, priority(_priority)
 		{
+			Update();
 		}
 
 		/*!
@@ -62,6 +77,59 @@ namespace panini
 			, style(_style)
 			, priority(_priority)
 		{
+			Update();
+		}
+
+		/*!
+			Construct an IncludeEntry from an interned path, an IncludeStyle,
+			and a priority.
+		*/
+		inline IncludeEntry(
+			IncludePath _interned,
+			IncludeStyle _style = IncludeStyle::AngularBrackets,
+			int32_t _priority = 0) noexcept
+			: style(_style)
+			, priority(_priority)
+			, depth(_interned.GetDepth())
+			, interned(_interned)
+		{
+		}
+
+		/*!
+			Update the cached string and depth after the path was modified.
+
+			Setting a path on an interned entry replaces the interned path.
+		*/
+		inline void Update()
+		{
+			if (interned &&
+				path.empty())
+			{
+				pathString.clear();
+				depth = interned.GetDepth();
+
+				return;
+			}
+
+			interned = IncludePath();
+			pathString = path.string();
+			depth = static_cast<int32_t>(std::count(pathString.begin(), pathString.end(), '/'));
+		}
+
+		/*!
+			Get the path for the include statement.
+		*/
+		inline const std::filesystem::path& GetPath() const
+		{
+			return interned ? interned.GetPath() : path;
+		}
+
+		/*!
+			Get the path as it is output.
+		*/
+		inline const std::string& GetString() const
+		{
+			return interned ? interned.GetString() : pathString;
 		}
 
 		/*!
@@ -78,6 +146,21 @@ namespace panini
 			Priority ranking of this entry in the set.
 		*/
 		int32_t priority = 0;
+
+		/*!
+			Path as it is output, cached by \ref Update.
+		*/
+		std::string pathString;
+
+		/*!
+			Number of forward slashes in the path, cached by \ref Update.
+		*/
+		int32_t depth = 0;
+
+		/*!
+			Interned path, used instead of `path` when set.
+		*/
+		IncludePath interned;
 	};
 
 };
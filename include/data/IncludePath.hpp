@@ -0,0 +1,185 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/IncludeStyle.hpp"
+
+#include <filesystem>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+namespace panini
+{
+
+	/*!
+		\brief Interned data for an include path, owned by an
+		\ref IncludePathPool.
+
+		\ingroup Data
+	*/
+
+	struct IncludePathRecord
+	{
+		/*!
+			Path as it was interned.
+		*/
+		std::filesystem::path path;
+
+		/*!
+			Path as it is output.
+		*/
+		std::string string;
+
+		/*!
+			Complete include statements for double quotes, single quotes, and
+			angular brackets.
+		*/
+		std::string lines[3];
+
+		/*!
+			Hash of the path, equivalent paths have the same hash.
+		*/
+		size_t hash = 0;
+
+		/*!
+			Number of forward slashes in the path.
+		*/
+		int32_t depth = 0;
+	};
+
+	/*!
+		\brief Handle to a path interned by an \ref IncludePathPool.
+
+		\ingroup Data
+
+		Handles are the size of a pointer and can be copied freely. They stay
+		valid for as long as the pool that created them. Handles from the
+		same pool are equal when their paths are equal.
+
+		An empty handle returns empty values.
+	*/
+
+	class IncludePath
+	{
+
+	public:
+		inline IncludePath() = default;
+
+		inline explicit IncludePath(const IncludePathRecord* record)
+			: m_record(record)
+		{
+		}
+
+		/*!
+			Check if the handle refers to a path.
+		*/
+		inline bool IsValid() const
+		{
+			return m_record != nullptr;
+		}
+
+		inline explicit operator bool () const
+		{
+			return IsValid();
+		}
+
+		/*!
+			Get the path.
+		*/
+		inline const std::filesystem::path& GetPath() const
+		{
+			static const std::filesystem::path empty;
+			return m_record ? m_record->path : empty;
+		}
+
+		/*!
+			Get the path as it is output.
+		*/
+		inline const std::string& GetString() const
+		{
+			static const std::string empty;
+			return m_record ? m_record->string : empty;
+		}
+
+		/*!
+			Get the complete include statement for an include style.
+
+			Returns an empty string for IncludeStyle::Inherit.
+		*/
+		inline std::string_view GetLine(IncludeStyle style) const
+		{
+			if (!m_record)
+			{
+				return {};
+			}
+
+			switch (style)
+			{
+
+			case IncludeStyle::DoubleQuotes:
+				return m_record->lines[0];
+
+			case IncludeStyle::SingleQuotes:
+				return m_record->lines[1];
+
+			case IncludeStyle::AngularBrackets:
+				return m_record->lines[2];
+
+			default:
+				return {};
+
+			}
+		}
+
+		/*!
+			Get the hash of the path.
+		*/
+		inline size_t GetHash() const
+		{
+			return m_record ? m_record->hash : 0;
+		}
+
+		/*!
+			Get the number of forward slashes in the path.
+		*/
+		inline int32_t GetDepth() const
+		{
+			return m_record ? m_record->depth : 0;
+		}
+
+		inline bool operator == (const IncludePath& other) const
+		{
+			return m_record == other.m_record;
+		}
+
+		inline bool operator != (const IncludePath& other) const
+		{
+			return m_record != other.m_record;
+		}
+
+	private:
+		const IncludePathRecord* m_record = nullptr;
+
+	};
+
+};
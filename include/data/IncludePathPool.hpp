@@ -0,0 +1,163 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/IncludePath.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace panini
+{
+
+	/*!
+		\brief Thread-safe collection of interned include paths.
+
+		\ingroup Data
+
+		Generated files tend to include the same headers. Interning a path
+		stores it once, together with its complete include statements, and
+		returns an \ref IncludePath handle that can be stored in an
+		\ref IncludeSet or an \ref Include command instead of a copy of the
+		path.
+
+		A pool can be shared between threads that generate files at the same
+		time. Paths that were interned before are found under a shared lock.
+
+		Example:
+
+		\code{.cpp}
+			IncludePathPool pool;
+
+			jobs.Add("Audio.h", [&pool](Writer& writer) {
+				IncludeSet set(pool);
+				set.Add("Engine/Types.h");
+				set.Add("vector", IncludeStyle::AngularBrackets);
+
+				writer << IncludeBlock(set);
+			});
+		\endcode
+	*/
+
+	class IncludePathPool
+	{
+
+	public:
+		inline IncludePathPool() = default;
+
+		IncludePathPool(const IncludePathPool&) = delete;
+		IncludePathPool& operator = (const IncludePathPool&) = delete;
+
+		/*!
+			Get a handle to a path, adding it to the pool if it wasn't interned
+			before. Equivalent paths return the same handle.
+		*/
+		inline IncludePath Intern(const std::filesystem::path& path)
+		{
+			const size_t hash = std::filesystem::hash_value(path);
+
+			{
+				std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+				if (const IncludePathRecord* record = FindRecord(path, hash))
+				{
+					return IncludePath(record);
+				}
+			}
+
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+			// another thread may have added the path while the lock was released
+
+			if (const IncludePathRecord* record = FindRecord(path, hash))
+			{
+				return IncludePath(record);
+			}
+
+			IncludePathRecord& record = m_records.emplace_back();
+			record.path = path;
+			record.string = path.string();
+			record.lines[0] = "#include \"" + record.string + "\"";
+			record.lines[1] = "#include '" + record.string + "'";
+			record.lines[2] = "#include <" + record.string + ">";
+			record.hash = hash;
+			record.depth = static_cast<int32_t>(std::count(record.string.begin(), record.string.end(), '/'));
+
+			m_index.emplace(hash, &record);
+
+			return IncludePath(&record);
+		}
+
+		/*!
+			Get a handle to a path that was interned before.
+
+			Returns an empty handle if the path is not in the pool.
+		*/
+		inline IncludePath Find(const std::filesystem::path& path) const
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+			return IncludePath(FindRecord(path, std::filesystem::hash_value(path)));
+		}
+
+		/*!
+			Get the number of paths in the pool.
+		*/
+		inline size_t GetCount() const
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+			return m_records.size();
+		}
+
+	private:
+		inline const IncludePathRecord* FindRecord(
+			const std::filesystem::path& path,
+			size_t hash) const
+		{
+			auto range = m_index.equal_range(hash);
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				if (it->second->path == path)
+				{
+					return it->second;
+				}
+			}
+
+			return nullptr;
+		}
+
+	private:
+		mutable std::shared_mutex m_mutex;
+
+		// a deque does not move its elements when it grows, so handles stay
+		// valid
+		std::deque<IncludePathRecord> m_records;
+		std::unordered_multimap<size_t, const IncludePathRecord*> m_index;
+
+	};
+
+};
@@ -22,8 +22,12 @@
 #pragma once
 
 #include "data/IncludeEntry.hpp"
+#include "data/IncludePathPool.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <unordered_map>
+#include <vector>
 
 namespace panini
 {
@@ -40,6 +44,15 @@ namespace panini
 
 		\note Duplicate paths are not allowed in the collection, unless they
 		differ in IncludeStyle.
+
+		Paths are found in a hash index, so adding a path takes constant time
+		regardless of the size of the set. Entries are kept in the order
+		they were added until the set is sorted. Sorting a set that was
+		already sorted with the same style does nothing.
+
+		A set constructed with an \ref IncludePathPool interns every path
+		that is added, so its entries store a handle instead of a copy of
+		the path.
 	*/
 
 	class IncludeSet
@@ -48,6 +61,47 @@ namespace panini
 	public:
 		inline IncludeSet() = default;
 
+		/*!
+			Construct an IncludeSet that interns its paths in a pool. The
+			pool must outlive the set.
+		*/
+		inline explicit IncludeSet(IncludePathPool& pool)
+			: m_pool(&pool)
+		{
+		}
+
+		/*!
+			Copy the entries of another set. The index is rebuilt when a path
+			is added to the copy.
+		*/
+		inline IncludeSet(const IncludeSet& other)
+			: m_entries(other.m_entries)
+			, m_pool(other.m_pool)
+			, m_sortedStyle(other.m_sortedStyle)
+			, m_isIndexed(false)
+			, m_isModified(other.m_isModified)
+		{
+		}
+
+		inline IncludeSet(IncludeSet&& other) noexcept = default;
+
+		inline IncludeSet& operator = (const IncludeSet& other)
+		{
+			if (this != &other)
+			{
+				m_entries = other.m_entries;
+				m_index.clear();
+				m_pool = other.m_pool;
+				m_sortedStyle = other.m_sortedStyle;
+				m_isIndexed = false;
+				m_isModified = other.m_isModified;
+			}
+
+			return *this;
+		}
+
+		inline IncludeSet& operator = (IncludeSet&& other) noexcept = default;
+
 		/*!
 			Construct an IncludeSet from a list of IncludeEntry.
 		*/
@@ -55,7 +109,14 @@ namespace panini
 		{
 			for (const IncludeEntry& entry : entries)
 			{
-				Add(entry.path, entry.style);
+				if (entry.interned)
+				{
+					Add(entry.interned, entry.style);
+				}
+				else
+				{
+					Add(entry.path, entry.style);
+				}
 			}
 		}
 
@@ -72,6 +133,14 @@ namespace panini
 			}
 		}
 
+		/*!
+			Get the pool paths are interned in, if any.
+		*/
+		inline IncludePathPool* GetPool() const
+		{
+			return m_pool;
+		}
+
 		/*!
 			Get entries as an std::vector.
 		*/
@@ -95,6 +164,10 @@ namespace panini
 		*/
 		inline std::vector<IncludeEntry>::iterator begin()
 		{
+			// entries may be modified through the iterator
+
+			m_isModified = true;
+
 			return m_entries.begin();
 		}
 
@@ -113,6 +186,8 @@ namespace panini
 		*/
 		inline std::vector<IncludeEntry>::iterator end()
 		{
+			m_isModified = true;
+
 			return m_entries.end();
 		}
 
@@ -126,23 +201,60 @@ namespace panini
 			const std::filesystem::path& path,
 			IncludeStyle style = IncludeStyle::Inherit)
 		{
+			if (m_pool != nullptr)
+			{
+				Add(m_pool->Intern(path), style);
+
+				return;
+			}
+
+			Prepare();
+
 			// check if the path is not already known
 
-			auto found = std::find_if(
-				m_entries.begin(),
-				m_entries.end(),
-				[&path, &style](const IncludeEntry& it) {
-					return it.path == path && it.style == style;
-				}
-			);
-			if (found != m_entries.end())
+			const size_t hash = GetHash(std::filesystem::hash_value(path), style);
+			if (Contains(path, style, hash))
+			{
+				return;
+			}
+
+			// add new entry to list
+
+			m_index.emplace(hash, m_entries.size());
+			m_entries.emplace_back(IncludeEntry{ path, style });
+			m_sortedStyle = IncludeStyle::Inherit;
+		}
+
+		/*!
+			Add an interned path to the set with an include style.
+
+			\note Duplicate paths will note be added, unless they differ in
+			IncludeStyle.
+		*/
+		inline void Add(
+			IncludePath path,
+			IncludeStyle style = IncludeStyle::Inherit)
+		{
+			if (!path)
+			{
+				return;
+			}
+
+			Prepare();
+
+			// check if the path is not already known
+
+			const size_t hash = GetHash(path.GetHash(), style);
+			if (Contains(path.GetPath(), style, hash))
 			{
 				return;
 			}
 
 			// add new entry to list
 
+			m_index.emplace(hash, m_entries.size());
 			m_entries.emplace_back(IncludeEntry{ path, style });
+			m_sortedStyle = IncludeStyle::Inherit;
 		}
 
 		/*!
@@ -169,7 +281,17 @@ namespace panini
 				return;
 			}
 
-			// resolve priority for all entries
+			if (m_isModified)
+			{
+				Update();
+			}
+			else if (m_sortedStyle == resolvedStyle)
+			{
+				return;
+			}
+
+			// resolve priority for all entries, paths with folders should come
+			// before files
 
 			for (IncludeEntry& entry : m_entries)
 			{
@@ -178,41 +300,7 @@ namespace panini
 						? resolvedStyle
 						: entry.style;
 
-				// base priority on include style
-
-				entry.priority = 1000;
-
-				switch (style)
-				{
-
-				case IncludeStyle::AngularBrackets:
-					entry.priority = 0;
-					break;
-
-				case IncludeStyle::DoubleQuotes:
-					entry.priority = 100;
-					break;
-
-				case IncludeStyle::SingleQuotes:
-					entry.priority = 200;
-					break;
-
-				default:
-					break;
-
-				}
-
-				// paths with folders should come before files
-
-				const std::string path = entry.path.string();
-
-				size_t offset = 0;
-				size_t next = 0;
-				while ((next = path.find_first_of('/', offset)) != std::string::npos)
-				{
-					entry.priority--;
-					offset = next + 1;
-				}
+				entry.priority = GetStylePriority(style) - entry.depth;
 			}
 
 			// sort by priority and path
@@ -220,21 +308,173 @@ namespace panini
 			std::sort(
 				m_entries.begin(),
 				m_entries.end(),
-				[](IncludeEntry& left, IncludeEntry& right) {
+				[](const IncludeEntry& left, const IncludeEntry& right) {
 					if (left.priority != right.priority)
 					{
 						return left.priority < right.priority;
 					}
 					else
 					{
-						return left.path < right.path;
+						return ComparePaths(left.GetString(), right.GetString()) < 0;
 					}
 				}
 			);
+
+			m_sortedStyle = resolvedStyle;
+			m_isIndexed = false;
+		}
+
+	private:
+		// the hash of a path is equal for paths that compare equal
+
+		inline static size_t GetHash(size_t pathHash, IncludeStyle style)
+		{
+			return pathHash ^ (static_cast<size_t>(style) * 0x9E3779B97F4A7C15ULL);
+		}
+
+		inline static size_t GetHash(const IncludeEntry& entry)
+		{
+			const size_t pathHash =
+				entry.interned
+					? entry.interned.GetHash()
+					: std::filesystem::hash_value(entry.path);
+
+			return GetHash(pathHash, entry.style);
+		}
+
+		inline static int32_t GetStylePriority(IncludeStyle style)
+		{
+			switch (style)
+			{
+
+			case IncludeStyle::AngularBrackets:
+				return 0;
+
+			case IncludeStyle::DoubleQuotes:
+				return 100;
+
+			case IncludeStyle::SingleQuotes:
+				return 200;
+
+			default:
+				return 1000;
+
+			}
+		}
+
+		/*
+			Compares paths in the same order as comparing their elements,
+			without splitting them. A separator ends an element, so it sorts
+			before any other character.
+		*/
+		inline static int ComparePaths(const std::string& left, const std::string& right)
+		{
+			const size_t length = std::min(left.size(), right.size());
+
+			for (size_t i = 0; i < length; ++i)
+			{
+				const unsigned char leftCharacter = static_cast<unsigned char>(left[i]);
+				const unsigned char rightCharacter = static_cast<unsigned char>(right[i]);
+				if (leftCharacter == rightCharacter)
+				{
+					continue;
+				}
+
+				if (IsSeparator(leftCharacter))
+				{
+					return -1;
+				}
+				else if (IsSeparator(rightCharacter))
+				{
+					return 1;
+				}
+
+				return (leftCharacter < rightCharacter) ? -1 : 1;
+			}
+
+			if (left.size() == right.size())
+			{
+				return 0;
+			}
+
+			return (left.size() < right.size()) ? -1 : 1;
+		}
+
+		inline static bool IsSeparator(unsigned char character)
+		{
+			return
+				character == '/' ||
+				character == static_cast<unsigned char>(std::filesystem::path::preferred_separator);
+		}
+
+		/*
+			Entries were modified through an iterator, so their cached values
+			and the index can't be trusted.
+		*/
+		inline void Update()
+		{
+			for (IncludeEntry& entry : m_entries)
+			{
+				entry.Update();
+			}
+
+			m_sortedStyle = IncludeStyle::Inherit;
+			m_isIndexed = false;
+			m_isModified = false;
+		}
+
+		inline void Prepare()
+		{
+			if (m_isModified)
+			{
+				Update();
+			}
+
+			if (!m_isIndexed)
+			{
+				BuildIndex();
+			}
+		}
+
+		inline bool Contains(
+			const std::filesystem::path& path,
+			IncludeStyle style,
+			size_t hash) const
+		{
+			auto range = m_index.equal_range(hash);
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				const IncludeEntry& entry = m_entries[it->second];
+				if (entry.style == style &&
+					entry.GetPath() == path)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		inline void BuildIndex()
+		{
+			m_index.clear();
+			m_index.reserve(m_entries.size());
+
+			for (size_t i = 0; i < m_entries.size(); ++i)
+			{
+				m_index.emplace(GetHash(m_entries[i]), i);
+			}
+
+			m_isIndexed = true;
 		}
 
 	private:
 		std::vector<IncludeEntry> m_entries;
+		std::unordered_multimap<size_t, size_t> m_index;
+		IncludePathPool* m_pool = nullptr;
+		IncludeStyle m_sortedStyle = IncludeStyle::Inherit;
+		bool m_isIndexed = true;
+		bool m_isModified = false;
 
 	};
 
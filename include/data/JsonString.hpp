@@ -0,0 +1,67 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+
+namespace panini
+{
+
+	/*!
+		\brief Writes text to a stream escaped for use inside a JSON string.
+
+		The surrounding quotes are not written.
+	*/
+	inline void WriteJsonString(std::ostream& stream, std::string_view text)
+	{
+		for (char character : text)
+		{
+			switch (character)
+			{
+
+			case '"':
+				stream << "\\\"";
+				break;
+
+			case '\\':
+				stream << "\\\\";
+				break;
+
+			default:
+				if (static_cast<unsigned char>(character) < 0x20)
+				{
+					stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+						<< static_cast<int>(character) << std::dec << std::setfill(' ');
+				}
+				else
+				{
+					stream << character;
+				}
+				break;
+
+			}
+		}
+	}
+
+};
@@ -0,0 +1,221 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace panini
+{
+
+	/*!
+		\brief Read-only view of a file that is mapped into memory.
+
+		\ingroup Data
+
+		The contents of the file are paged in by the operating system when
+		they are accessed, instead of being read into a buffer up front.
+
+		Empty files are considered open, but have an empty view.
+	*/
+
+	class MappedFile
+	{
+
+	public:
+		inline MappedFile() = default;
+
+		/*!
+			Map the file at `path` into memory.
+		*/
+		inline explicit MappedFile(const std::filesystem::path& path)
+		{
+		#ifdef _WIN32
+			HANDLE file = ::CreateFileW(
+				path.c_str(),
+				GENERIC_READ,
+				FILE_SHARE_READ,
+				nullptr,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+				nullptr
+			);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return;
+			}
+
+			LARGE_INTEGER size;
+			if (!::GetFileSizeEx(file, &size))
+			{
+				::CloseHandle(file);
+
+				return;
+			}
+
+			m_isOpen = true;
+			m_size = static_cast<size_t>(size.QuadPart);
+
+			if (m_size > 0)
+			{
+				HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping != nullptr)
+				{
+					m_data = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					::CloseHandle(mapping);
+				}
+
+				if (m_data == nullptr)
+				{
+					m_isOpen = false;
+					m_size = 0;
+				}
+			}
+
+			::CloseHandle(file);
+		#else
+			const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (descriptor < 0)
+			{
+				return;
+			}
+
+			struct stat status;
+			if (::fstat(descriptor, &status) == 0 &&
+				S_ISREG(status.st_mode))
+			{
+				m_isOpen = true;
+				m_size = static_cast<size_t>(status.st_size);
+
+				if (m_size > 0)
+				{
+					void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+					if (data != MAP_FAILED)
+					{
+						// the file is read from start to end
+
+						::madvise(data, m_size, MADV_SEQUENTIAL);
+
+						m_data = static_cast<const char*>(data);
+					}
+					else
+					{
+						m_isOpen = false;
+						m_size = 0;
+					}
+				}
+			}
+
+			::close(descriptor);
+		#endif
+		}
+
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator = (const MappedFile& other) = delete;
+
+		inline MappedFile(MappedFile&& other) noexcept
+			: m_data(std::exchange(other.m_data, nullptr))
+			, m_size(std::exchange(other.m_size, 0))
+			, m_isOpen(std::exchange(other.m_isOpen, false))
+		{
+		}
+
+		inline MappedFile& operator = (MappedFile&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Close();
+
+				m_data = std::exchange(other.m_data, nullptr);
+				m_size = std::exchange(other.m_size, 0);
+				m_isOpen = std::exchange(other.m_isOpen, false);
+			}
+
+			return *this;
+		}
+
+		inline ~MappedFile()
+		{
+			Close();
+		}
+
+		/*!
+			Check whether the file was mapped successfully.
+		*/
+		inline bool IsOpen() const
+		{
+			return m_isOpen;
+		}
+
+		/*!
+			Get a view of the contents of the file.
+		*/
+		inline std::string_view GetView() const
+		{
+			return std::string_view(m_data, m_size);
+		}
+
+		/*!
+			Unmap the file from memory, invalidating any views.
+		*/
+		inline void Close()
+		{
+			if (m_data != nullptr)
+			{
+			#ifdef _WIN32
+				::UnmapViewOfFile(m_data);
+			#else
+				::munmap(const_cast<char*>(m_data), m_size);
+			#endif
+			}
+
+			m_data = nullptr;
+			m_size = 0;
+			m_isOpen = false;
+		}
+
+	private:
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+		bool m_isOpen = false;
+
+	};
+
+};
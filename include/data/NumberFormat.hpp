@@ -0,0 +1,41 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+namespace panini
+{
+
+	/*!
+		\brief Format used to output arithmetic values.
+
+		\ingroup Globals
+	*/
+
+	enum class NumberFormat
+	{
+		Default,       //!< Decimal, floating-point values with six digits after the decimal point like `std::to_string`
+		Hexadecimal,   //!< Hexadecimal with a "0x" prefix, floating-point values as hexadecimal floating literals
+		Fixed,         //!< Decimal, floating-point values with a configurable number of digits after the decimal point
+		Shortest       //!< Decimal, floating-point values with the fewest digits that convert back to the same value
+	};
+
+};
@@ -0,0 +1,338 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/DataFile.hpp"
+#include "data/Hash64.hpp"
+
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace panini
+{
+
+	/*!
+		\brief Size and hash of an output that was committed to disk.
+
+		\ingroup Data
+	*/
+
+	struct OutputManifestEntry
+	{
+		/*!
+			Size of the output in bytes.
+		*/
+		uint64_t size = 0;
+
+		/*!
+			\ref Hash64 digest of the output.
+		*/
+		uint64_t hash = 0;
+
+		/*!
+			Time the output was last modified on disk, in ticks of
+			`std::filesystem::file_time_type`.
+		*/
+		int64_t modifiedTime = 0;
+	};
+
+	/*!
+		\brief Records the size and hash of outputs that were committed, so
+		they don't have to be read again to find out if they changed.
+
+		\ingroup Data
+
+		The manifest is loaded from disk when it is constructed and saved
+		when it is destroyed, if it was modified.
+
+		An entry is only trusted when the size and modification time of the
+		file on disk still match what was recorded. Files that were modified
+		at the same time or after the manifest was last saved are never
+		trusted, because a later modification in the same tick of the file
+		system clock can't be detected. A manifest that can't be parsed or
+		fails its checksum is discarded as a whole.
+
+		Entries can be found and updated from multiple threads.
+
+		\sa CompareWriterConfig
+	*/
+
+	class OutputManifest
+	{
+
+	public:
+		/*!
+			Construct a manifest and load its entries from `manifestPath`,
+			if it exists.
+		*/
+		inline explicit OutputManifest(const std::filesystem::path& manifestPath)
+			: m_manifestPath(manifestPath)
+		{
+			Load();
+		}
+
+		OutputManifest(const OutputManifest&) = delete;
+		OutputManifest& operator = (const OutputManifest&) = delete;
+
+		/*!
+			Saves the manifest automatically if it was modified.
+		*/
+		inline ~OutputManifest()
+		{
+			if (m_isModified)
+			{
+				Save();
+			}
+		}
+
+		/*!
+			Path where the manifest is stored.
+		*/
+		inline const std::filesystem::path& GetManifestPath() const
+		{
+			return m_manifestPath;
+		}
+
+		/*!
+			Check if the manifest on disk was discarded because it was
+			corrupted.
+		*/
+		inline bool IsCorrupted() const
+		{
+			return m_isCorrupted;
+		}
+
+		/*!
+			Number of entries in the manifest.
+		*/
+		inline size_t GetEntryCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			return m_entries.size();
+		}
+
+		/*!
+			Find a trusted entry for the output at `path`.
+
+			\return True if the entry was found and it matches the file on
+			disk.
+		*/
+		inline bool Find(const std::filesystem::path& path, OutputManifestEntry& entry) const
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				auto found = m_entries.find(DataFile::GetKey(path));
+				if (found == m_entries.end())
+				{
+					return false;
+				}
+
+				entry = found->second;
+
+				if (entry.modifiedTime >= m_savedTime)
+				{
+					return false;
+				}
+			}
+
+			OutputManifestEntry current;
+			if (!DataFile::Stat(path, current.size, current.modifiedTime))
+			{
+				return false;
+			}
+
+			return
+				current.size == entry.size &&
+				current.modifiedTime == entry.modifiedTime;
+		}
+
+		/*!
+			Record the `size` and `hash` of the output that was committed to
+			`path`. The entry is removed instead when the file on disk doesn't
+			have the expected size.
+		*/
+		inline void Update(const std::filesystem::path& path, uint64_t size, uint64_t hash)
+		{
+			OutputManifestEntry entry;
+			if (!DataFile::Stat(path, entry.size, entry.modifiedTime) ||
+				entry.size != size)
+			{
+				Remove(path);
+
+				return;
+			}
+
+			entry.hash = hash;
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_entries[DataFile::GetKey(path)] = entry;
+			m_isModified = true;
+		}
+
+		/*!
+			Remove the entry for `path`.
+		*/
+		inline void Remove(const std::filesystem::path& path)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (m_entries.erase(DataFile::GetKey(path)) > 0)
+			{
+				m_isModified = true;
+			}
+		}
+
+		/*!
+			Write the manifest to disk. A temporary file is written first and
+			then renamed, so an interrupted save can't leave a partial
+			manifest.
+
+			\return True if the manifest was saved.
+		*/
+		inline bool Save()
+		{
+			if (m_manifestPath.empty())
+			{
+				return false;
+			}
+
+			std::string contents;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				contents.reserve(s_Header.size() + m_entries.size() * 64);
+				contents += s_Header;
+
+				for (const auto& [key, entry] : m_entries)
+				{
+					DataFile::AppendRecord(contents, entry.hash, entry.size, entry.modifiedTime, key);
+				}
+
+				m_isModified = false;
+			}
+
+			DataFile::AppendChecksum(contents);
+
+			std::filesystem::path temporaryPath = m_manifestPath;
+			temporaryPath += ".tmp";
+
+			if (!DataFile::Write(m_manifestPath, contents, temporaryPath))
+			{
+				return false;
+			}
+
+			std::error_code error;
+			auto savedTime = std::filesystem::last_write_time(m_manifestPath, error);
+			if (!error)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				m_savedTime = savedTime.time_since_epoch().count();
+			}
+
+			return true;
+		}
+
+	private:
+		inline void Load()
+		{
+			std::string contents;
+			if (!DataFile::Read(m_manifestPath, contents))
+			{
+				return;
+			}
+
+			// the modification time of the manifest is taken before its
+			// entries are trusted, see Find()
+
+			std::error_code error;
+			auto savedTime = std::filesystem::last_write_time(m_manifestPath, error);
+			if (error)
+			{
+				return;
+			}
+
+			if (!Parse(contents))
+			{
+				m_entries.clear();
+				m_isCorrupted = true;
+
+				return;
+			}
+
+			m_savedTime = savedTime.time_since_epoch().count();
+		}
+
+		inline bool Parse(std::string_view contents)
+		{
+			std::string_view lines;
+			if (!DataFile::ParseChecksum(contents, s_Header, lines))
+			{
+				return false;
+			}
+
+			while (!lines.empty())
+			{
+				size_t lineEnd = lines.find('\n');
+				if (lineEnd == std::string_view::npos)
+				{
+					return false;
+				}
+
+				std::string_view line = lines.substr(0, lineEnd);
+				lines.remove_prefix(lineEnd + 1);
+
+				OutputManifestEntry entry;
+				std::string_view key;
+				if (!DataFile::ParseRecord(line, entry.hash, entry.size, entry.modifiedTime, key))
+				{
+					return false;
+				}
+
+				m_entries[std::string(key)] = entry;
+			}
+
+			return true;
+		}
+
+	private:
+		static constexpr std::string_view s_Header = "panini-manifest 1\n";
+
+		std::filesystem::path m_manifestPath;
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, OutputManifestEntry> m_entries;
+		int64_t m_savedTime = std::numeric_limits<int64_t>::min();
+		bool m_isCorrupted = false;
+		bool m_isModified = false;
+
+	};
+
+};
@@ -0,0 +1,307 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+#endif
+
+namespace panini
+{
+
+	/*!
+		\brief Collection of references to chunks that are written to a file
+		in a single pass.
+
+		\ingroup Data
+
+		Pinned chunks are referenced instead of copied, while other chunks are
+		copied into blocks of a fixed size. Neighboring chunks in the same
+		block are merged into a single segment.
+
+		On POSIX systems, the segments are submitted to the file with `writev`
+		in batches. Other platforms write each segment in turn.
+	*/
+
+	class ScatterGatherBuffer
+	{
+
+	public:
+		/*!
+			Construct a buffer that copies chunks into blocks of `blockSize`
+			bytes.
+		*/
+		inline explicit ScatterGatherBuffer(size_t blockSize = 64 * 1024)
+			: m_blockSize(std::max<size_t>(blockSize, 1))
+		{
+		}
+
+		/*!
+			Size in bytes of the blocks that chunks are copied into.
+		*/
+		inline size_t GetBlockSize() const
+		{
+			return m_blockSize;
+		}
+
+		/*!
+			Total size of the output in bytes.
+		*/
+		inline size_t GetSize() const
+		{
+			return m_size;
+		}
+
+		/*!
+			Number of bytes that were copied into the buffer.
+		*/
+		inline size_t GetCopiedSize() const
+		{
+			return m_copiedSize;
+		}
+
+		/*!
+			Number of segments that will be submitted to the file.
+		*/
+		inline size_t GetSegmentCount() const
+		{
+			return m_segments.size();
+		}
+
+		/*!
+			Copy a chunk into the buffer.
+		*/
+		inline void Append(std::string_view chunk)
+		{
+			if (chunk.empty())
+			{
+				return;
+			}
+
+			if (m_usedBlockCount == 0 ||
+				m_blocks[m_usedBlockCount - 1].size() + chunk.size() > m_blocks[m_usedBlockCount - 1].capacity())
+			{
+				NextBlock(chunk.size());
+			}
+
+			// the block has enough capacity, so appending won't move it
+
+			std::string& block = m_blocks[m_usedBlockCount - 1];
+			const char* data = block.data() + block.size();
+			block.append(chunk);
+
+			m_copiedSize += chunk.size();
+
+			AddSegment(data, chunk.size());
+		}
+
+		/*!
+			Add a reference to a chunk whose storage remains valid until the
+			buffer is written or cleared.
+		*/
+		inline void AppendPinned(std::string_view chunk)
+		{
+			if (chunk.empty())
+			{
+				return;
+			}
+
+			AddSegment(chunk.data(), chunk.size());
+		}
+
+		/*!
+			Remove all segments and copied chunks. The blocks are kept and
+			reused for the next output.
+		*/
+		inline void Clear()
+		{
+			m_segments.clear();
+			m_usedBlockCount = 0;
+			m_size = 0;
+			m_copiedSize = 0;
+		}
+
+		/*!
+			Write all segments to the file at `path`, replacing its contents.
+
+			\return False if the file could not be opened or written.
+		*/
+		inline bool WriteTo(const std::filesystem::path& path) const
+		{
+		#ifdef _WIN32
+			std::ofstream stream(path, std::ios::out | std::ios::binary);
+			if (!stream.is_open())
+			{
+				return false;
+			}
+
+			for (const Segment& segment : m_segments)
+			{
+				stream.write(segment.data, segment.size);
+			}
+
+			return stream.good();
+		#else
+			const int descriptor = ::open(
+				path.c_str(),
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+				0644
+			);
+			if (descriptor < 0)
+			{
+				return false;
+			}
+
+			const long maxVectors = ::sysconf(_SC_IOV_MAX);
+			const size_t batchSize = maxVectors > 0 ? static_cast<size_t>(maxVectors) : 1024;
+
+			std::vector<iovec> vectors;
+			vectors.reserve(std::min(batchSize, m_segments.size()));
+
+			bool success = true;
+			size_t index = 0;
+			size_t offset = 0;
+
+			while (index < m_segments.size())
+			{
+				// gather the next batch, starting in the middle of a segment
+				// after a partial write
+
+				vectors.clear();
+
+				for (size_t i = index; i < m_segments.size() && vectors.size() < batchSize; ++i)
+				{
+					const size_t skip = (i == index) ? offset : 0;
+
+					iovec& vector = vectors.emplace_back();
+					vector.iov_base = const_cast<char*>(m_segments[i].data + skip);
+					vector.iov_len = m_segments[i].size - skip;
+				}
+
+				const ssize_t written = ::writev(
+					descriptor,
+					vectors.data(),
+					static_cast<int>(vectors.size())
+				);
+				if (written < 0 &&
+					errno == EINTR)
+				{
+					continue;
+				}
+
+				if (written <= 0)
+				{
+					success = false;
+
+					break;
+				}
+
+				// advance past the written bytes
+
+				size_t remaining = static_cast<size_t>(written);
+				while (remaining > 0)
+				{
+					const size_t left = m_segments[index].size - offset;
+					if (remaining < left)
+					{
+						offset += remaining;
+
+						break;
+					}
+
+					remaining -= left;
+					offset = 0;
+					index++;
+				}
+			}
+
+			return (::close(descriptor) == 0) && success;
+		#endif
+		}
+
+	private:
+		/*
+			Start copying into a block with room for at least `size` bytes,
+			reusing a block from a previous output when possible.
+		*/
+		inline void NextBlock(size_t size)
+		{
+			const size_t capacity = std::max(m_blockSize, size);
+
+			if (m_usedBlockCount == m_blocks.size())
+			{
+				m_blocks.emplace_back();
+			}
+
+			std::string& block = m_blocks[m_usedBlockCount++];
+			block.clear();
+			block.reserve(capacity);
+		}
+
+		inline void AddSegment(const char* data, size_t size)
+		{
+			m_size += size;
+
+			// merge with the previous segment when they are contiguous
+
+			if (!m_segments.empty())
+			{
+				Segment& last = m_segments.back();
+				if (last.data + last.size == data)
+				{
+					last.size += size;
+
+					return;
+				}
+			}
+
+			m_segments.push_back(Segment{ data, size });
+		}
+
+	private:
+		struct Segment
+		{
+			const char* data;
+			size_t size;
+		};
+
+		size_t m_blockSize = 0;
+		size_t m_size = 0;
+		size_t m_copiedSize = 0;
+		std::vector<Segment> m_segments;
+		std::deque<std::string> m_blocks;
+		size_t m_usedBlockCount = 0;
+
+	};
+
+};
@@ -0,0 +1,75 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+namespace panini
+{
+
+	/*!
+		\brief Span of time recorded by a \ref TraceRecorder.
+
+		\ingroup Data
+
+		Events are exported as complete events in the Chrome trace-event
+		format. When the event has a label, the label is shown as the name of
+		the span and the name is added as an argument.
+	*/
+
+	struct TraceEvent
+	{
+		/*!
+			Name of the span, like the type of a command. Must refer to a
+			string that outlives the recorder.
+		*/
+		std::string_view name;
+
+		/*!
+			Category of the span, like "command" or "commit".
+		*/
+		const char* category = "";
+
+		/*!
+			Optional label, like the name of a scope or the path of a file.
+		*/
+		std::string label;
+
+		/*!
+			Index of the thread that recorded the span, starting at 1.
+		*/
+		uint32_t threadId = 0;
+
+		/*!
+			Start of the span, in nanoseconds since the recorder was created.
+		*/
+		int64_t start = 0;
+
+		/*!
+			Duration of the span, in nanoseconds.
+		*/
+		int64_t duration = 0;
+	};
+
+};
@@ -0,0 +1,78 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#if defined(__GNUG__)
+	#include <cxxabi.h>
+	#include <cstdlib>
+#endif
+
+namespace panini
+{
+
+	/*!
+		\brief Readable name of a type, used to report commands by their class.
+
+		The name is demangled where the compiler supports it. Template
+		arguments and the "class " and "struct " prefixes added by some
+		compilers are removed, so all instantiations of a class template
+		share the same name.
+	*/
+	inline std::string GetTypeName(const std::type_info& type)
+	{
+		std::string name = type.name();
+
+	#if defined(__GNUG__)
+		int status = 0;
+		if (char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status))
+		{
+			name = demangled;
+			std::free(demangled);
+		}
+	#endif
+
+		// remove template arguments
+
+		const size_t templateStart = name.find('<');
+		if (templateStart != std::string::npos)
+		{
+			name.erase(templateStart);
+		}
+
+		// remove "class " and "struct " added by some compilers
+
+		for (std::string_view prefix : { std::string_view("class "), std::string_view("struct ") })
+		{
+			if (name.compare(0, prefix.size(), prefix) == 0)
+			{
+				name.erase(0, prefix.size());
+			}
+		}
+
+		return name;
+	}
+
+};
@@ -0,0 +1,68 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace panini
+{
+
+	/*!
+		\brief Outcome of a single job run by \ref GenerationJobs.
+
+		\ingroup Jobs
+	*/
+
+	enum class GenerationJobStatus
+	{
+		Unchanged,  //!< The output matched the file on disk.
+		Changed,    //!< The output was written to the file.
+		Failed,     //!< The job threw an exception or the file could not be written.
+		Skipped,    //!< The file was up to date with its inputs, the job was not run.
+	};
+
+	/*!
+		\brief Result of a single job run by \ref GenerationJobs.
+
+		\ingroup Jobs
+	*/
+
+	struct GenerationJobResult
+	{
+		/*!
+			File the job generated.
+		*/
+		std::filesystem::path filePath;
+
+		/*!
+			Outcome of the job.
+		*/
+		GenerationJobStatus status = GenerationJobStatus::Unchanged;
+
+		/*!
+			Reason the job failed, empty otherwise.
+		*/
+		std::string error;
+	};
+
+};
@@ -0,0 +1,265 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "jobs/GenerationJobResult.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "tracing/Tracing.hpp"
+#include "writers/CompareWriter.hpp"
+#include "writers/WriterPool.hpp"
+
+namespace panini
+{
+
+	/*!
+		\brief Generates many independent files in parallel.
+
+		\ingroup Jobs
+
+		Every job is a callback that writes the contents of a single file.
+		When the jobs are run, each job is given its own \ref CompareWriter
+		for its file, so a file is only written when its contents changed.
+		The jobs run on a \ref ThreadPool, but the results are always
+		reported in the order the jobs were added.
+
+		A job that throws an exception is reported as failed and its file is
+		left untouched.
+
+		When a \ref DependencyDatabase is configured, jobs can declare the
+		input files their output is generated from. A job whose output is up
+		to date with its inputs is skipped without calling its callback and
+		reported as GenerationJobStatus::Skipped. The inputs in the
+		configuration are added to the inputs of every job.
+
+		Jobs may run at the same time, so callbacks must not modify state
+		they share with other jobs.
+
+		Example:
+
+		\code{.cpp}
+			GenerationJobs jobs;
+
+			for (const Model& model : models)
+			{
+				jobs.Add(model.GetHeaderPath(), [&model](Writer& writer) {
+					WriteModelHeader(writer, model);
+				});
+			}
+
+			for (const GenerationJobResult& result : jobs.Run())
+			{
+				if (result.status == GenerationJobStatus::Failed)
+				{
+					std::cerr << result.filePath << ": " << result.error << std::endl;
+				}
+			}
+		\endcode
+
+		\sa CompareWriter
+	*/
+
+	class GenerationJobs
+	{
+
+	public:
+		using TCallback = std::function<void(Writer&)>;
+
+		/*!
+			Construct the jobs.
+
+			\param config  Configuration for the writer of every job. The
+			               `filePath` is replaced by the path of the job.
+		*/
+		inline explicit GenerationJobs(const CompareWriterConfig& config = {})
+			: m_config(config)
+		{
+		}
+
+		/*!
+			Add a job that writes the file at `filePath`.
+		*/
+		inline void Add(const std::filesystem::path& filePath, TCallback&& callback)
+		{
+			m_jobs.push_back(Job{ filePath, {}, std::move(callback) });
+		}
+
+		/*!
+			Add a job that writes the file at `filePath` from the `inputs`.
+			The job is skipped when the file is up to date with its inputs in
+			the configured \ref DependencyDatabase.
+		*/
+		inline void Add(
+			const std::filesystem::path& filePath,
+			std::vector<std::filesystem::path> inputs,
+			TCallback&& callback)
+		{
+			m_jobs.push_back(Job{ filePath, std::move(inputs), std::move(callback) });
+		}
+
+		/*!
+			Number of jobs that were added.
+		*/
+		inline size_t GetJobCount() const
+		{
+			return m_jobs.size();
+		}
+
+		/*!
+			Run all jobs on a new thread pool with one thread per hardware
+			thread.
+
+			\return Results in the order the jobs were added.
+		*/
+		inline const std::vector<GenerationJobResult>& Run()
+		{
+			ThreadPool pool;
+
+			return Run(pool);
+		}
+
+		/*!
+			Run all jobs on an existing thread pool. Only waits for the jobs
+			of this instance, so the pool can be shared with other work and
+			this method can be called from a task.
+
+			\return Results in the order the jobs were added.
+		*/
+		inline const std::vector<GenerationJobResult>& Run(ThreadPool& pool)
+		{
+			m_results.clear();
+			m_results.resize(m_jobs.size());
+
+			ThreadPool::TaskGroup group;
+
+			for (size_t i = 0; i < m_jobs.size(); ++i)
+			{
+				pool.Submit(group, [this, i] {
+					RunJob(m_jobs[i], m_results[i]);
+				});
+			}
+
+			pool.Wait(group);
+
+			return m_results;
+		}
+
+		/*!
+			Results of the last run, in the order the jobs were added.
+		*/
+		inline const std::vector<GenerationJobResult>& GetResults() const
+		{
+			return m_results;
+		}
+
+		/*!
+			Number of results of the last run with the specified status.
+		*/
+		inline size_t GetResultCount(GenerationJobStatus status) const
+		{
+			return static_cast<size_t>(std::count_if(m_results.begin(), m_results.end(), [status](const GenerationJobResult& result) {
+				return result.status == status;
+			}));
+		}
+
+	private:
+		struct Job
+		{
+			std::filesystem::path filePath;
+			std::vector<std::filesystem::path> inputs;
+			TCallback callback;
+		};
+
+		inline void RunJob(const Job& job, GenerationJobResult& result) const
+		{
+			PANINI_TRACE_SPAN_LABEL("job", "GenerationJob", job.filePath.string());
+
+			result.filePath = job.filePath;
+
+			CompareWriterConfig config = m_config;
+			config.filePath = job.filePath;
+			config.inputs.insert(config.inputs.end(), job.inputs.begin(), job.inputs.end());
+
+			if (config.dependencies != nullptr &&
+				config.dependencies->IsUpToDate(job.filePath, config.inputs))
+			{
+				result.status = GenerationJobStatus::Skipped;
+
+				return;
+			}
+
+			try
+			{
+				// writers are reused by the jobs that run on the same thread
+
+				WriterPool<CompareWriter>::Lease lease = WriterPool<CompareWriter>::GetThreadLocal().Acquire(config);
+				CompareWriter& writer = *lease;
+
+				try
+				{
+					job.callback(writer);
+				}
+				catch (...)
+				{
+					writer.Discard();
+
+					throw;
+				}
+
+				if (!writer.IsChanged())
+				{
+					writer.Commit();
+					result.status = GenerationJobStatus::Unchanged;
+				}
+				else if (writer.Commit())
+				{
+					result.status = GenerationJobStatus::Changed;
+				}
+				else
+				{
+					result.status = GenerationJobStatus::Failed;
+					result.error = "Failed to write file.";
+				}
+
+				// the result is final, nothing is left to commit on destruction
+
+				writer.Discard();
+			}
+			catch (const std::exception& exception)
+			{
+				result.status = GenerationJobStatus::Failed;
+				result.error = exception.what();
+			}
+			catch (...)
+			{
+				result.status = GenerationJobStatus::Failed;
+				result.error = "Unknown exception.";
+			}
+		}
+
+	private:
+		CompareWriterConfig m_config;
+		std::vector<Job> m_jobs;
+		std::vector<GenerationJobResult> m_results;
+
+	};
+
+};
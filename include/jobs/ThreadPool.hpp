@@ -0,0 +1,415 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Runs tasks on a fixed number of worker threads.
+
+		\ingroup Jobs
+
+		Every worker owns a queue of tasks. Workers take tasks from the back
+		of their own queue and steal from the front of the other queues when
+		their own queue is empty. Tasks submitted from outside the pool are
+		distributed over the queues in turn, while tasks submitted from a
+		worker are added to its own queue.
+
+		Waiting runs queued tasks on the calling thread until the awaited
+		tasks are finished. A task that needs to wait for tasks of its own
+		should submit them to a \ref TaskGroup and wait for the group,
+		because waiting for the whole pool includes the waiting task itself.
+
+		Example:
+
+		\code{.cpp}
+			ThreadPool pool;
+
+			for (const Model& model : models)
+			{
+				pool.Submit([&model] {
+					GenerateModel(model);
+				});
+			}
+
+			pool.Wait();
+		\endcode
+	*/
+
+	class ThreadPool
+	{
+
+	public:
+		using TTask = std::function<void()>;
+
+		/*!
+			\brief Tasks that can be waited for separately from the rest of
+			the pool.
+		*/
+		class TaskGroup
+		{
+
+		public:
+			TaskGroup() = default;
+			TaskGroup(const TaskGroup&) = delete;
+			TaskGroup& operator = (const TaskGroup&) = delete;
+
+		private:
+			friend class ThreadPool;
+
+			std::atomic<size_t> m_pendingCount = 0;
+			std::exception_ptr m_exception;
+
+		};
+
+		/*!
+			Start `threadCount` worker threads. When `threadCount` is zero,
+			one thread is started for every hardware thread.
+		*/
+		inline explicit ThreadPool(size_t threadCount = 0)
+		{
+			if (threadCount == 0)
+			{
+				threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+			}
+
+			m_queues.reserve(threadCount);
+			for (size_t i = 0; i < threadCount; ++i)
+			{
+				m_queues.push_back(std::make_unique<Queue>());
+			}
+
+			m_threads.reserve(threadCount);
+			for (size_t i = 0; i < threadCount; ++i)
+			{
+				m_threads.emplace_back([this, i] {
+					Work(i);
+				});
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator = (const ThreadPool&) = delete;
+
+		/*!
+			Pool shared by all commands that were not given a pool of their
+			own, with one thread per hardware thread. Started on first use.
+		*/
+		inline static ThreadPool& GetShared()
+		{
+			static ThreadPool s_Shared;
+
+			return s_Shared;
+		}
+
+		/*!
+			Pool of the worker thread that calls this function, or `nullptr`
+			when it is not called from a worker thread.
+		*/
+		inline static ThreadPool* GetCurrent()
+		{
+			return s_CurrentPool;
+		}
+
+		/*!
+			Finishes all tasks before stopping the worker threads.
+		*/
+		inline ~ThreadPool()
+		{
+			Wait(m_pendingCount);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_isStopping = true;
+			}
+			m_wake.notify_all();
+
+			for (std::thread& thread : m_threads)
+			{
+				thread.join();
+			}
+		}
+
+		/*!
+			Number of worker threads.
+		*/
+		inline size_t GetThreadCount() const
+		{
+			return m_threads.size();
+		}
+
+		/*!
+			Queue a task to run on one of the worker threads.
+		*/
+		inline void Submit(TTask&& task)
+		{
+			Submit(m_group, std::move(task));
+		}
+
+		/*!
+			Queue a task that belongs to a group.
+		*/
+		inline void Submit(TaskGroup& group, TTask&& task)
+		{
+			const size_t queueIndex = (s_CurrentPool == this)
+				? s_CurrentWorker
+				: m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+			group.m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+			m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+			// counted before the task can be taken, so taking it can't
+			// make the count wrap around
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_queuedCount++;
+			}
+
+			{
+				Queue& queue = *m_queues[queueIndex];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.tasks.push_back(Task{ std::move(task), &group });
+			}
+
+			m_wake.notify_one();
+			m_finished.notify_all();
+		}
+
+		/*!
+			Wait until all submitted tasks are finished, running tasks on the
+			calling thread in the meantime. Must not be called from a task.
+
+			If a task that was not submitted to a group threw an exception,
+			the first of those exceptions is rethrown.
+		*/
+		inline void Wait()
+		{
+			Wait(m_pendingCount);
+			Rethrow(m_group);
+		}
+
+		/*!
+			Wait until all tasks of the group are finished, running tasks on
+			the calling thread in the meantime. Can be called from a task.
+
+			If a task of the group threw an exception, the first exception is
+			rethrown.
+		*/
+		inline void Wait(TaskGroup& group)
+		{
+			Wait(group.m_pendingCount);
+			Rethrow(group);
+		}
+
+	private:
+		struct Task
+		{
+			TTask callback;
+			TaskGroup* group = nullptr;
+		};
+
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		inline void Wait(const std::atomic<size_t>& pendingCount)
+		{
+			const size_t start = (s_CurrentPool == this) ? s_CurrentWorker : 0;
+
+			while (pendingCount.load(std::memory_order_acquire) > 0)
+			{
+				Task task;
+				if (TryTake(start, task))
+				{
+					Run(task);
+
+					continue;
+				}
+
+				// remaining tasks are running on other threads
+
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_finished.wait(lock, [this, &pendingCount] {
+					return
+						pendingCount.load(std::memory_order_acquire) == 0 ||
+						m_queuedCount > 0;
+				});
+			}
+		}
+
+		inline void Rethrow(TaskGroup& group)
+		{
+			std::exception_ptr exception;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				exception = std::exchange(group.m_exception, nullptr);
+			}
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+
+		inline void Work(size_t workerIndex)
+		{
+			s_CurrentPool = this;
+			s_CurrentWorker = workerIndex;
+
+			while (true)
+			{
+				Task task;
+				if (TryTake(workerIndex, task))
+				{
+					Run(task);
+
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this] {
+					return m_isStopping || m_queuedCount > 0;
+				});
+
+				if (m_isStopping &&
+					m_queuedCount == 0)
+				{
+					break;
+				}
+			}
+		}
+
+		inline bool TryTake(size_t queueIndex, Task& task)
+		{
+			// own queue first, newest task
+
+			{
+				Queue& queue = *m_queues[queueIndex];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					task = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+
+					OnTaken();
+
+					return true;
+				}
+			}
+
+			// steal the oldest task from another queue
+
+			for (size_t offset = 1; offset < m_queues.size(); ++offset)
+			{
+				Queue& queue = *m_queues[(queueIndex + offset) % m_queues.size()];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					task = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+
+					OnTaken();
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		inline void OnTaken()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queuedCount--;
+		}
+
+		inline void Run(Task& task)
+		{
+			TaskGroup& group = *task.group;
+
+			try
+			{
+				task.callback();
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (!group.m_exception)
+				{
+					group.m_exception = std::current_exception();
+				}
+			}
+
+			task.callback = nullptr;
+
+			// the group may be destroyed by its waiter as soon as its count drops to zero
+
+			const bool isGroupFinished = group.m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+			const bool isPoolFinished = m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+
+			if (isGroupFinished ||
+				isPoolFinished)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_finished.notify_all();
+			}
+		}
+
+	private:
+		inline static thread_local ThreadPool* s_CurrentPool = nullptr;
+		inline static thread_local size_t s_CurrentWorker = 0;
+
+		std::vector<std::unique_ptr<Queue>> m_queues;
+		std::vector<std::thread> m_threads;
+		std::atomic<size_t> m_nextQueue = 0;
+		std::atomic<size_t> m_pendingCount = 0;
+		TaskGroup m_group;
+
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_finished;
+		size_t m_queuedCount = 0;
+		bool m_isStopping = false;
+
+	};
+
+};
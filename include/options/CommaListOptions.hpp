@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include "data/NumberFormat.hpp"
+
 #include <string>
 
 namespace panini
@@ -64,6 +66,17 @@ namespace panini
 			Skip adding the end separator to the last item in the list.
 		*/
 		bool skipLastItemEndSeparator = true;
+
+		/*!
+			Format used by the default transform for arithmetic items.
+		*/
+		NumberFormat numberFormat = NumberFormat::Default;
+
+		/*!
+			Number of digits after the decimal point for floating-point items
+			when \ref numberFormat is set to NumberFormat::Fixed.
+		*/
+		int precision = 6;
 	};
 
 };
@@ -0,0 +1,73 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Sink that appends output to a buffer of characters.
+
+		\ingroup Sinks
+
+		Unlike the \ref StringSink, the buffer is not null-terminated.
+
+		\sa SinkWriter
+	*/
+
+	class BufferSink
+	{
+
+	public:
+		/*!
+			Construct a sink that appends to a `target` buffer.
+		*/
+		inline explicit BufferSink(std::vector<char>& target)
+			: m_target(target)
+		{
+		}
+
+		/*!
+			Append a chunk to the target buffer.
+		*/
+		inline void Append(std::string_view chunk)
+		{
+			m_target.insert(m_target.end(), chunk.begin(), chunk.end());
+		}
+
+		/*!
+			Buffers don't need to be flushed.
+		*/
+		inline bool Flush()
+		{
+			return true;
+		}
+
+	private:
+		std::vector<char>& m_target;
+
+	};
+
+};
@@ -0,0 +1,228 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+	#include <fcntl.h>
+	#include <io.h>
+	#include <sys/stat.h>
+#else
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace panini
+{
+
+	/*!
+		\brief Sink that writes output to a file descriptor.
+
+		\ingroup Sinks
+
+		Chunks are collected in a buffer of a fixed size, which is written to
+		the file descriptor whenever it fills up and when the sink is flushed.
+		Chunks that are larger than the buffer are written directly.
+
+		The sink closes the file descriptor when it is destroyed, but only if
+		it opened the file itself.
+
+		\sa SinkWriter
+	*/
+
+	class FileDescriptorSink
+	{
+
+	public:
+		/*!
+			Open the file at `path` for writing, replacing its contents.
+
+			\param path        Path to the target file.
+			\param bufferSize  Size of the buffer in bytes.
+		*/
+		inline explicit FileDescriptorSink(
+			const std::filesystem::path& path,
+			size_t bufferSize = 64 * 1024)
+			: m_isOwned(true)
+		{
+		#ifdef _WIN32
+			m_descriptor = ::_wopen(
+				path.c_str(),
+				_O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+				_S_IREAD | _S_IWRITE
+			);
+		#else
+			m_descriptor = ::open(
+				path.c_str(),
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+				0644
+			);
+		#endif
+
+			m_buffer.reserve(bufferSize);
+		}
+
+		/*!
+			Write to a file descriptor that is owned by the caller.
+
+			\param descriptor  Open file descriptor.
+			\param bufferSize  Size of the buffer in bytes.
+		*/
+		inline explicit FileDescriptorSink(
+			int descriptor,
+			size_t bufferSize = 64 * 1024)
+			: m_descriptor(descriptor)
+			, m_isOwned(false)
+		{
+			m_buffer.reserve(bufferSize);
+		}
+
+		FileDescriptorSink(const FileDescriptorSink& other) = delete;
+		FileDescriptorSink& operator = (const FileDescriptorSink& other) = delete;
+
+		inline FileDescriptorSink(FileDescriptorSink&& other) noexcept
+			: m_descriptor(std::exchange(other.m_descriptor, -1))
+			, m_isOwned(std::exchange(other.m_isOwned, false))
+			, m_isFailed(other.m_isFailed)
+			, m_buffer(std::move(other.m_buffer))
+		{
+		}
+
+		/*!
+			Flushes remaining output and closes the file descriptor if it is
+			owned by the sink.
+		*/
+		inline ~FileDescriptorSink()
+		{
+			Flush();
+
+			if (m_isOwned &&
+				m_descriptor >= 0)
+			{
+			#ifdef _WIN32
+				::_close(m_descriptor);
+			#else
+				::close(m_descriptor);
+			#endif
+			}
+		}
+
+		/*!
+			Check whether the file descriptor is valid.
+		*/
+		inline bool IsOpen() const
+		{
+			return m_descriptor >= 0;
+		}
+
+		/*!
+			Append a chunk to the buffer, writing the buffer to the file
+			descriptor when it is full.
+		*/
+		inline void Append(std::string_view chunk)
+		{
+			if (m_buffer.size() + chunk.size() > m_buffer.capacity())
+			{
+				Flush();
+
+				if (chunk.size() >= m_buffer.capacity())
+				{
+					WriteAll(chunk.data(), chunk.size());
+
+					return;
+				}
+			}
+
+			m_buffer.insert(m_buffer.end(), chunk.begin(), chunk.end());
+		}
+
+		/*!
+			Write the buffer to the file descriptor.
+
+			\return False if any write to the file descriptor has failed.
+		*/
+		inline bool Flush()
+		{
+			if (!m_buffer.empty())
+			{
+				WriteAll(m_buffer.data(), m_buffer.size());
+				m_buffer.clear();
+			}
+
+			return IsOpen() && !m_isFailed;
+		}
+
+	private:
+		inline void WriteAll(const char* data, size_t size)
+		{
+			if (!IsOpen())
+			{
+				m_isFailed = true;
+
+				return;
+			}
+
+			while (size > 0)
+			{
+			#ifdef _WIN32
+				const int written = ::_write(
+					m_descriptor,
+					data,
+					static_cast<unsigned int>(std::min<size_t>(size, INT_MAX))
+				);
+			#else
+				const ssize_t written = ::write(m_descriptor, data, size);
+				if (written < 0 &&
+					errno == EINTR)
+				{
+					continue;
+				}
+			#endif
+
+				if (written <= 0)
+				{
+					m_isFailed = true;
+
+					return;
+				}
+
+				data += written;
+				size -= static_cast<size_t>(written);
+			}
+		}
+
+	private:
+		int m_descriptor = -1;
+		bool m_isOwned = false;
+		bool m_isFailed = false;
+		std::vector<char> m_buffer;
+
+	};
+
+};
@@ -0,0 +1,71 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace panini
+{
+
+	/*!
+		\brief Sink that appends output to a string.
+
+		\ingroup Sinks
+
+		\sa SinkWriter
+	*/
+
+	class StringSink
+	{
+
+	public:
+		/*!
+			Construct a sink that appends to a `target` string.
+		*/
+		inline explicit StringSink(std::string& target)
+			: m_target(target)
+		{
+		}
+
+		/*!
+			Append a chunk to the target string.
+		*/
+		inline void Append(std::string_view chunk)
+		{
+			m_target.append(chunk);
+		}
+
+		/*!
+			Strings don't need to be flushed.
+		*/
+		inline bool Flush()
+		{
+			return true;
+		}
+
+	private:
+		std::string& m_target;
+
+	};
+
+};
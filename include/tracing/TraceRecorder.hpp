@@ -0,0 +1,401 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/JsonString.hpp"
+#include "data/TraceEvent.hpp"
+#include "data/TypeName.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Collects spans of time from all threads and exports them as a
+		Chrome trace-event timeline.
+
+		\ingroup Tracing
+
+		Writers only record spans when the library is compiled with
+		`PANINI_ENABLE_TRACING` defined, which is done by enabling the
+		`PANINI_ENABLE_TRACING` option in CMake. Without it, the hooks compile
+		to nothing. When enabled, command visits, scopes, commits and
+		generation jobs are recorded while a recorder is started.
+
+		Every thread records into its own buffer, so recording does not
+		contend on a lock. The events should only be read, cleared or exported
+		once the traced work has finished.
+
+		The exported JSON can be opened in Perfetto (https://ui.perfetto.dev)
+		or in `chrome://tracing`.
+
+		\code{.cpp}
+			TraceRecorder recorder;
+			recorder.Start();
+
+			GenerationJobs jobs;
+			// ...
+			jobs.Run();
+
+			recorder.Stop();
+			recorder.WriteChromeTrace("generation.trace.json");
+		\endcode
+
+		\sa TraceSpan
+	*/
+
+	class TraceRecorder
+	{
+
+	public:
+		inline TraceRecorder()
+			: m_epoch(std::chrono::steady_clock::now())
+			, m_id(++s_lastId)
+		{
+		}
+
+		TraceRecorder(const TraceRecorder&) = delete;
+		TraceRecorder& operator = (const TraceRecorder&) = delete;
+
+		inline ~TraceRecorder()
+		{
+			Stop();
+		}
+
+		/*!
+			Make this the recorder that spans on all threads are recorded to.
+			Replaces the recorder that was started before.
+		*/
+		inline void Start()
+		{
+			s_active.store(this, std::memory_order_release);
+		}
+
+		/*!
+			Stop recording new spans to this recorder. Spans that already
+			started are still recorded when they end.
+		*/
+		inline void Stop()
+		{
+			TraceRecorder* expected = this;
+			s_active.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+		}
+
+		/*!
+			Check if this recorder is the one spans are recorded to.
+		*/
+		inline bool IsStarted() const
+		{
+			return s_active.load(std::memory_order_acquire) == this;
+		}
+
+		/*!
+			Recorder that spans are recorded to, or `nullptr` when tracing is
+			stopped.
+		*/
+		inline static TraceRecorder* GetActive()
+		{
+			return s_active.load(std::memory_order_acquire);
+		}
+
+		/*!
+			Limit how deep nested commands are recorded. A depth of 1 only
+			records commands written directly to a writer, 0 records all of
+			them.
+		*/
+		inline void SetMaxCommandDepth(uint32_t depth)
+		{
+			m_maxCommandDepth = depth;
+		}
+
+		/*!
+			How deep nested commands are recorded, 0 when unlimited.
+		*/
+		inline uint32_t GetMaxCommandDepth() const
+		{
+			return m_maxCommandDepth;
+		}
+
+		/*!
+			Name the timeline of the calling thread in the exported trace.
+		*/
+		inline void SetThreadName(std::string_view name)
+		{
+			GetThreadBuffer().name = name;
+		}
+
+		/*!
+			Nanoseconds since the recorder was created.
+		*/
+		inline int64_t GetTimestamp() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - m_epoch).count();
+		}
+
+		/*!
+			Record a span on the calling thread.
+
+			\param name Name of the span, must outlive the recorder.
+			\param category Category of the span.
+			\param label Optional label, copied into the event.
+			\param start Start of the span, from \ref GetTimestamp.
+			\param end End of the span, from \ref GetTimestamp.
+		*/
+		inline void AddEvent(
+			std::string_view name,
+			const char* category,
+			std::string_view label,
+			int64_t start,
+			int64_t end)
+		{
+			ThreadBuffer& buffer = GetThreadBuffer();
+
+			TraceEvent& event = buffer.events.emplace_back();
+			event.name = name;
+			event.category = category;
+			event.label = label;
+			event.threadId = buffer.threadId;
+			event.start = start;
+			event.duration = end - start;
+		}
+
+		/*!
+			Readable name for a type of command. The name is cached per
+			thread and remains valid until the recorder is destroyed.
+		*/
+		inline std::string_view GetCommandName(const std::type_info& type)
+		{
+			ThreadBuffer& buffer = GetThreadBuffer();
+
+			auto found = buffer.commandNames.find(type);
+			if (found == buffer.commandNames.end())
+			{
+				found = buffer.commandNames.emplace(type, GetTypeName(type)).first;
+			}
+
+			return found->second;
+		}
+
+		/*!
+			Number of spans recorded on all threads.
+		*/
+		inline size_t GetEventCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+			size_t count = 0;
+			for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+			{
+				count += buffer->events.size();
+			}
+
+			return count;
+		}
+
+		/*!
+			Spans recorded on all threads, sorted by their start.
+		*/
+		inline std::vector<TraceEvent> GetEvents() const
+		{
+			std::vector<TraceEvent> events;
+
+			{
+				std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+				for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+				{
+					events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+				}
+			}
+
+			// parents start before their children, or at the same time while lasting longer
+
+			std::stable_sort(events.begin(), events.end(), [](const TraceEvent& left, const TraceEvent& right) {
+				return
+					left.start < right.start ||
+					(left.start == right.start && left.duration > right.duration);
+			});
+
+			return events;
+		}
+
+		/*!
+			Remove all recorded spans.
+		*/
+		inline void Clear()
+		{
+			std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+			for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+			{
+				buffer->events.clear();
+			}
+		}
+
+		/*!
+			Write the recorded spans as Chrome trace-event JSON.
+		*/
+		inline void WriteChromeTrace(std::ostream& stream) const
+		{
+			const std::vector<TraceEvent> events = GetEvents();
+
+			stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+			bool first = true;
+
+			{
+				std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+				for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+				{
+					stream << (first ? "\n" : ",\n");
+					first = false;
+
+					stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+						<< ",\"args\":{\"name\":\"";
+
+					if (buffer->name.empty())
+					{
+						stream << "Thread " << buffer->threadId;
+					}
+					else
+					{
+						WriteJsonString(stream, buffer->name);
+					}
+
+					stream << "\"}}";
+				}
+			}
+
+			for (const TraceEvent& event : events)
+			{
+				stream << (first ? "\n" : ",\n");
+				first = false;
+
+				stream << "{\"name\":\"";
+				WriteJsonString(stream, event.label.empty() ? event.name : std::string_view(event.label));
+				stream << "\",\"cat\":\"";
+				WriteJsonString(stream, event.category);
+				stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":";
+				WriteMicroseconds(stream, event.start);
+				stream << ",\"dur\":";
+				WriteMicroseconds(stream, event.duration);
+
+				if (!event.label.empty())
+				{
+					stream << ",\"args\":{\"type\":\"";
+					WriteJsonString(stream, event.name);
+					stream << "\"}";
+				}
+
+				stream << '}';
+			}
+
+			stream << "\n]}\n";
+		}
+
+		/*!
+			Write the recorded spans as Chrome trace-event JSON to a file.
+
+			\return Returns true if the file was written.
+		*/
+		inline bool WriteChromeTrace(const std::filesystem::path& filePath) const
+		{
+			std::ofstream stream(filePath.string(), std::ios::binary);
+			if (!stream.is_open())
+			{
+				return false;
+			}
+
+			WriteChromeTrace(stream);
+
+			return stream.good();
+		}
+
+	private:
+		struct ThreadBuffer
+		{
+			uint32_t threadId = 0;
+			std::string name;
+			std::vector<TraceEvent> events;
+			std::unordered_map<std::type_index, std::string> commandNames;
+		};
+
+		struct ThreadCache
+		{
+			uint64_t recorderId = 0;
+			ThreadBuffer* buffer = nullptr;
+		};
+
+		inline ThreadBuffer& GetThreadBuffer()
+		{
+			// recorders are identified by id, because a new recorder can be
+			// created at the address of one that was destroyed
+
+			thread_local ThreadCache t_cache;
+
+			if (t_cache.recorderId != m_id)
+			{
+				std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+				std::unique_ptr<ThreadBuffer>& buffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+				buffer->threadId = static_cast<uint32_t>(m_buffers.size());
+
+				t_cache.recorderId = m_id;
+				t_cache.buffer = buffer.get();
+			}
+
+			return *t_cache.buffer;
+		}
+
+		inline static void WriteMicroseconds(std::ostream& stream, int64_t nanoseconds)
+		{
+			stream << (nanoseconds / 1000) << '.'
+				<< std::setw(3) << std::setfill('0') << (nanoseconds % 1000) << std::setfill(' ');
+		}
+
+	private:
+		inline static std::atomic<TraceRecorder*> s_active{ nullptr };
+		inline static std::atomic<uint64_t> s_lastId{ 0 };
+
+		std::chrono::steady_clock::time_point m_epoch;
+		uint64_t m_id = 0;
+		uint32_t m_maxCommandDepth = 0;
+		mutable std::mutex m_buffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+	};
+
+};
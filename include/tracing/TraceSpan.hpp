@@ -0,0 +1,161 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "tracing/TraceRecorder.hpp"
+
+namespace panini
+{
+
+	/*!
+		\brief Records the time between its construction and destruction to
+		the active \ref TraceRecorder.
+
+		\ingroup Tracing
+
+		When no recorder is started, the span does nothing. The label is only
+		copied when the span is recorded.
+
+		\code{.cpp}
+			{
+				TraceSpan span("io", "WriteManifest", manifestPath.string());
+
+				manifest.Write(manifestPath);
+			}
+		\endcode
+	*/
+
+	class TraceSpan
+	{
+
+	public:
+		/*!
+			\param category Category of the span, must outlive the recorder.
+			\param name Name of the span, must outlive the recorder.
+			\param label Optional label shown instead of the name.
+		*/
+		inline TraceSpan(
+			const char* category,
+			std::string_view name,
+			std::string_view label = {})
+			: m_recorder(TraceRecorder::GetActive())
+		{
+			if (m_recorder != nullptr)
+			{
+				m_category = category;
+				m_name = name;
+				m_label = label;
+				m_start = m_recorder->GetTimestamp();
+			}
+		}
+
+		TraceSpan(const TraceSpan&) = delete;
+		TraceSpan& operator = (const TraceSpan&) = delete;
+
+		inline ~TraceSpan()
+		{
+			if (m_recorder != nullptr)
+			{
+				m_recorder->AddEvent(m_name, m_category, m_label, m_start, m_recorder->GetTimestamp());
+			}
+		}
+
+	private:
+		TraceRecorder* m_recorder = nullptr;
+		const char* m_category = "";
+		std::string_view m_name;
+		std::string m_label;
+		int64_t m_start = 0;
+
+	};
+
+	/*!
+		\brief Records the visit of a command to the active
+		\ref TraceRecorder, named after the type of the command.
+
+		\ingroup Tracing
+
+		Commands nested deeper than the maximum command depth of the recorder
+		are not recorded. Depth is only counted while a recorder is started.
+	*/
+
+	class TraceCommandSpan
+	{
+
+	public:
+		inline TraceCommandSpan(const std::type_info& type)
+			: m_recorder(TraceRecorder::GetActive())
+		{
+			if (m_recorder == nullptr)
+			{
+				return;
+			}
+
+			const uint32_t depth = ++GetDepth();
+			m_isCounted = true;
+
+			const uint32_t maxDepth = m_recorder->GetMaxCommandDepth();
+			if (maxDepth > 0 &&
+				depth > maxDepth)
+			{
+				m_recorder = nullptr;
+
+				return;
+			}
+
+			m_name = m_recorder->GetCommandName(type);
+			m_start = m_recorder->GetTimestamp();
+		}
+
+		TraceCommandSpan(const TraceCommandSpan&) = delete;
+		TraceCommandSpan& operator = (const TraceCommandSpan&) = delete;
+
+		inline ~TraceCommandSpan()
+		{
+			if (m_isCounted)
+			{
+				--GetDepth();
+			}
+
+			if (m_recorder != nullptr)
+			{
+				m_recorder->AddEvent(m_name, "command", {}, m_start, m_recorder->GetTimestamp());
+			}
+		}
+
+	private:
+		inline static uint32_t& GetDepth()
+		{
+			thread_local uint32_t t_depth = 0;
+
+			return t_depth;
+		}
+
+	private:
+		TraceRecorder* m_recorder = nullptr;
+		bool m_isCounted = false;
+		std::string_view m_name;
+		int64_t m_start = 0;
+
+	};
+
+};
@@ -0,0 +1,57 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+/*!
+	\file Tracing.hpp
+	\brief Hooks that record spans to the active \ref panini::TraceRecorder.
+
+	The hooks are only compiled when `PANINI_ENABLE_TRACING` is defined,
+	otherwise they expand to nothing and their arguments are not evaluated.
+*/
+
+#if defined(PANINI_ENABLE_TRACING)
+
+	#include "tracing/TraceSpan.hpp"
+
+	#define PANINI_TRACE_CONCAT_IMPL(left, right) left##right
+	#define PANINI_TRACE_CONCAT(left, right) PANINI_TRACE_CONCAT_IMPL(left, right)
+
+	//! Record a span with a name until the end of the enclosing block.
+	#define PANINI_TRACE_SPAN(category, name) \
+		::panini::TraceSpan PANINI_TRACE_CONCAT(panini_trace_span_, __LINE__)(category, name)
+
+	//! Record a span with a name and a label until the end of the enclosing block.
+	#define PANINI_TRACE_SPAN_LABEL(category, name, label) \
+		::panini::TraceSpan PANINI_TRACE_CONCAT(panini_trace_span_, __LINE__)(category, name, label)
+
+	//! Record the visit of a command until the end of the enclosing block.
+	#define PANINI_TRACE_COMMAND(command) \
+		::panini::TraceCommandSpan PANINI_TRACE_CONCAT(panini_trace_command_, __LINE__)(typeid(command))
+
+#else
+
+	#define PANINI_TRACE_SPAN(category, name) (void)0
+	#define PANINI_TRACE_SPAN_LABEL(category, name, label) (void)0
+	#define PANINI_TRACE_COMMAND(command) (void)0
+
+#endif
@@ -22,8 +22,12 @@
 #pragma once
 
 #include "data/CompareWriterConfig.hpp"
+#include "data/MappedFile.hpp"
+#include "tracing/Tracing.hpp"
 #include "writers/Writer.hpp"
 
+#include <string.h>
+
 namespace panini
 {
 
@@ -33,9 +37,19 @@ namespace panini
 
 		\ingroup Writers
 
-		The CompareWriter stores the contents of the target path first. When
-		the new output differs from what was seen before, the output will be
-		committed to the path.
+		The CompareWriter maps the contents of the target path into memory
+		first and compares each chunk against it as it arrives. While the
+		output matches, only an offset into the previous contents is kept.
+		The output is copied to a buffer from the first difference onward.
+		When the new output differs from what was seen before, the output
+		will be committed to the path.
+
+		When an \ref OutputManifest is configured, the output is hashed as
+		well. If the manifest has a trusted entry for the path, the previous
+		output is not read at all and the output is considered changed only
+		when its size or hash differ from the entry. The manifest is updated
+		with the size and hash of every output that is committed or found to
+		be unchanged.
 
 		\sa CompareWriterConfig
 	*/
@@ -51,8 +65,9 @@ namespace panini
 			\param config    Configuration instance.
 		*/
 		inline explicit CompareWriter(const CompareWriterConfig& config = {})
-			: CompareWriter(config.filePath, config)
+			: ConfiguredWriter(config)
 		{
+			Open();
 		}
 
 		/*!
@@ -68,24 +83,9 @@ namespace panini
 		inline explicit CompareWriter(
 			const std::filesystem::path& filePath,
 			const WriterConfig& config = WriterConfig())
-			: ConfiguredWriter(CompareWriterConfig{ config })
+			: ConfiguredWriter(CompareWriterConfig{ config, filePath })
 		{
-			m_config.filePath = filePath;
-
-			// read the previous output, if available
-
-			std::ifstream stream(m_config.filePath.string(), std::ios::binary);
-			m_pathExists = stream.is_open();
-			if (m_pathExists)
-			{
-				stream.seekg(0, std::ios::end);
-				m_writtenPrevious.resize(static_cast<size_t>(stream.tellg()));
-				stream.seekg(0, std::ios::beg);
-				stream.read(&m_writtenPrevious[0], m_writtenPrevious.size());
-				stream.close();
-
-				m_writtenCurrent.reserve(m_writtenPrevious.size());
-			}
+			Open();
 		}
 
 		/*!
@@ -102,37 +102,343 @@ namespace panini
 		*/
 		inline bool IsChanged() const override
 		{
-			return m_writtenPrevious != m_writtenCurrent;
+			if (m_isDiscarded)
+			{
+				return false;
+			}
+
+			if (m_isTrusted)
+			{
+				return
+					m_hash.GetSize() != m_trusted.size ||
+					m_hash.GetDigest() != m_trusted.hash;
+			}
+
+			return m_isDiverged || m_matchedSize != m_previous.size();
+		}
+
+		/*!
+			Commits the output to the path if it was changed. Unchanged output
+			is recorded in the manifest, if one was configured.
+
+			Nothing happens when no output was written since the last
+			commit, unless the commit is forced.
+		*/
+		inline bool Commit(bool force = false) override
+		{
+			if (m_isCommitted &&
+				!force)
+			{
+				return false;
+			}
+
+			if (force || IsChanged())
+			{
+				m_isCommitted = OnCommit(force);
+
+				return m_isCommitted;
+			}
+
+			if (m_config.manifest != nullptr &&
+				!m_isTrusted &&
+				!m_isDiscarded &&
+				m_pathExists)
+			{
+				m_config.manifest->Update(m_config.filePath, m_hash.GetSize(), m_hash.GetDigest());
+			}
+
+			if (!m_isDiscarded &&
+				m_pathExists)
+			{
+				RecordInputs();
+			}
+
+			m_isCommitted = true;
+
+			return false;
+		}
+
+		/*!
+			Add a file the output is generated from, in addition to the
+			inputs in the configuration. The inputs are recorded in the
+			dependency database when the writer is committed.
+		*/
+		inline void AddInput(const std::filesystem::path& path)
+		{
+			m_config.inputs.push_back(path);
+		}
+
+		/*!
+			Commit the output written so far and compare against a different
+			file, keeping the configuration and the memory allocated by the
+			writer.
+
+			\note Inputs added with \ref AddInput are removed.
+
+			\param filePath  File that will be compared against the output.
+		*/
+		inline void Reset(const std::filesystem::path& filePath)
+		{
+			Commit();
+
+			m_config.filePath = filePath;
+			m_config.inputs.clear();
+
+			ResetState();
+			ResetComparison();
+			Open();
+		}
+
+		/*!
+			Commit the output written so far and reconfigure the writer,
+			keeping the memory allocated by the writer.
+
+			\param config  Configuration instance.
+		*/
+		inline void Reset(const CompareWriterConfig& config)
+		{
+			Commit();
+
+			ResetConfig(config);
+			ResetComparison();
+			Open();
+		}
+
+		/*!
+			Drops the output written so far. The path is left untouched and
+			nothing is committed when the writer is destroyed.
+		*/
+		inline void Discard()
+		{
+			// the previous output is no longer needed, so the file is not
+			// kept mapped until the writer is destroyed
+
+			m_mapped.Close();
+			m_previous = std::string_view();
+			m_matchedSize = 0;
+
+			m_writtenCurrent.clear();
+			m_isDiscarded = true;
+		}
+
+		/*!
+			Forget the previous output, the manifest and the dependency
+			database after the output was committed. A writer that was
+			released to a \ref WriterPool then doesn't keep the file mapped
+			or point to a manifest or database that may be destroyed.
+
+			Nothing is committed until the writer is reset, which must
+			happen before it is used again.
+		*/
+		inline void Detach()
+		{
+			ResetComparison();
+
+			m_config.manifest = nullptr;
+			m_config.dependencies = nullptr;
+			m_config.inputs.clear();
+
+			m_isDiscarded = true;
+			m_isCommitted = true;
 		}
 
 	protected:
-		inline void Write(const std::string& chunk) override
+		/*!
+			Compares the chunk against the previous output, copying it only
+			once the output has diverged.
+		*/
+		inline void Write(std::string_view chunk) override
 		{
-			m_writtenCurrent += chunk;
+			if (chunk.empty())
+			{
+				return;
+			}
+
+			m_isCommitted = false;
+
+			if (m_config.manifest != nullptr)
+			{
+				m_hash.Update(chunk);
+			}
+
+			if (!m_isDiverged)
+			{
+				if (chunk.size() <= m_previous.size() - m_matchedSize &&
+					::memcmp(m_previous.data() + m_matchedSize, chunk.data(), chunk.size()) == 0)
+				{
+					m_matchedSize += chunk.size();
+
+					return;
+				}
+
+				Diverge(chunk.size());
+			}
+
+			m_writtenCurrent.append(chunk);
 		}
 
 		inline bool OnCommit(bool force = false) override
 		{
 			(void)force;
 
+			PANINI_TRACE_SPAN_LABEL("commit", "CompareWriter::OnCommit", m_config.filePath.string());
+
+			if (!m_isDiverged)
+			{
+				Diverge(0);
+			}
+
+			// the previous output must be unmapped before it is overwritten
+
+			m_mapped.Close();
+
 			std::ofstream stream(m_config.filePath.string(), std::ios::binary);
 			if (!stream.is_open())
 			{
+				RemoveRecords();
+
 				return false;
 			}
 
+			// output that was only partially written must not be recorded
+			// as up to date
+
 			stream.write(m_writtenCurrent.c_str(), m_writtenCurrent.length());
 			stream.close();
 
-			m_writtenPrevious = m_writtenCurrent;
+			if (stream.fail())
+			{
+				RemoveRecords();
+
+				return false;
+			}
+
+			if (m_config.manifest != nullptr)
+			{
+				m_config.manifest->Update(m_config.filePath, m_hash.GetSize(), m_hash.GetDigest());
+			}
+
+			RecordInputs();
+
+			// the committed output becomes the previous output
+
+			m_writtenPrevious = std::move(m_writtenCurrent);
+			m_writtenCurrent.clear();
+			m_previous = m_writtenPrevious;
+			m_matchedSize = m_previous.size();
+			m_isDiverged = false;
+			m_isTrusted = false;
+			m_isDiscarded = false;
+			m_pathExists = true;
 
 			return true;
 		}
 
+		/*!
+			Record the inputs of the output in the dependency database, if
+			one was configured.
+		*/
+		inline void RecordInputs()
+		{
+			if (m_config.dependencies != nullptr)
+			{
+				m_config.dependencies->Record(m_config.filePath, m_config.inputs);
+			}
+		}
+
+		/*!
+			Remove the output from the manifest and the dependency database,
+			if they were configured, after it failed to be written.
+		*/
+		inline void RemoveRecords()
+		{
+			if (m_config.manifest != nullptr)
+			{
+				m_config.manifest->Remove(m_config.filePath);
+			}
+
+			if (m_config.dependencies != nullptr)
+			{
+				m_config.dependencies->Remove(m_config.filePath);
+			}
+		}
+
+		/*!
+			Forget the previous output and the output written so far, keeping
+			the largest buffer for the next output.
+		*/
+		inline void ResetComparison()
+		{
+			m_mapped.Close();
+			m_previous = std::string_view();
+			m_matchedSize = 0;
+			m_isDiverged = false;
+
+			if (m_writtenPrevious.capacity() > m_writtenCurrent.capacity())
+			{
+				m_writtenCurrent.swap(m_writtenPrevious);
+			}
+
+			m_writtenPrevious.clear();
+			m_writtenCurrent.clear();
+
+			m_hash.Reset();
+			m_trusted = OutputManifestEntry();
+			m_isTrusted = false;
+			m_isDiscarded = false;
+			m_isCommitted = false;
+			m_pathExists = false;
+		}
+
+		/*!
+			Map the previous output into memory, if available and not already
+			known from the manifest.
+		*/
+		inline void Open()
+		{
+			if (m_config.manifest != nullptr &&
+				m_config.manifest->Find(m_config.filePath, m_trusted))
+			{
+				// all output is buffered, in case it needs to be committed
+
+				m_writtenCurrent.reserve(static_cast<size_t>(m_trusted.size));
+				m_pathExists = true;
+				m_isDiverged = true;
+				m_isTrusted = true;
+
+				return;
+			}
+
+			m_mapped = MappedFile(m_config.filePath);
+			m_pathExists = m_mapped.IsOpen();
+			m_previous = m_mapped.GetView();
+		}
+
+		/*!
+			Copy the matching part of the previous output to the current output
+			and stop comparing chunks.
+		*/
+		inline void Diverge(size_t nextChunkSize)
+		{
+			m_writtenCurrent.reserve(std::max(m_previous.size(), m_matchedSize + nextChunkSize));
+			m_writtenCurrent.assign(m_previous.data(), m_matchedSize);
+
+			m_isDiverged = true;
+		}
+
 	protected:
 		bool m_pathExists = false;
+		MappedFile m_mapped;
+		std::string_view m_previous;
+		size_t m_matchedSize = 0;
+		bool m_isDiverged = false;
 		std::string m_writtenPrevious;
 		std::string m_writtenCurrent;
+		Hash64 m_hash;
+		OutputManifestEntry m_trusted;
+		bool m_isTrusted = false;
+		bool m_isDiscarded = false;
+		bool m_isCommitted = false;
 
 	};
 
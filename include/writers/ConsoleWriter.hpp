@@ -36,6 +36,9 @@ namespace panini
 		default output stream for console programs. You can write to a different
 		stream by supplying it as the first argument to the constructor.
 
+		Each line is assembled before it is written to the stream, which is
+		flushed after every line.
+
 		\sa ConsoleWriterConfig
 	*/
 
@@ -67,17 +70,36 @@ namespace panini
 			: ConfiguredWriter(config)
 			, m_outputStream(outputStream)
 		{
+			EnableLineAssembly(0);
+		}
+
+		/*!
+			Writes the remainder of an incomplete line when the writer is
+			destroyed.
+		*/
+		inline ~ConsoleWriter() override
+		{
+			FlushLines();
 		}
 
 	protected:
 		/*!
 			Writes the chunk to the console stream.
 		*/
-		inline void Write(const std::string& chunk) override
+		inline void Write(std::string_view chunk) override
 		{
 			m_outputStream << chunk;
 		}
 
+		/*
+			Writes complete lines to the console stream and flushes it.
+		*/
+		inline void WriteLines(std::string_view lines) override
+		{
+			m_outputStream.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+			m_outputStream.flush();
+		}
+
 		/*
 			Flush the console output on a new line.
 		*/
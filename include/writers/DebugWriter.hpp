@@ -146,37 +146,47 @@ namespace panini
 
 	protected:
 		/*!
-			Writes the chunk to the console.
+			Writes the line number when a new line starts.
 		*/
-		inline void Write(const std::string& chunk) override
+		inline void OnLineStart() override
 		{
 			if (!m_initialized)
 			{
 				return;
 			}
 
-			// line numbers
+			std::string padded = std::to_string(m_cursorY + 1);
+			for (size_t i = padded.length(); i < m_debugConfig.lineNumberPadding; ++i)
+			{
+				padded.insert(padded.begin(), ' ');
+			}
 
-			if (IsOnNewLine())
+			padded += ' ';
+
+			SetColor(Colors::White, Colors::Black);
+			WriteChunk(padded);
+			ResetStyles();
+		}
+
+		/*!
+			Writes the chunk to the console.
+		*/
+		inline void Write(std::string_view chunk) override
+		{
+			if (!m_initialized)
 			{
-				std::string padded = std::to_string(m_cursorY + 1);
-				for (size_t i = padded.length(); i < m_debugConfig.lineNumberPadding; ++i)
-				{
-					padded.insert(padded.begin(), ' ');
-				}
-				
-				SetColor(Colors::White, Colors::Black);
-				WriteChunk(padded + " ");
-				ResetStyles();
+				return;
 			}
 
 			const std::string& indentStr = GetConfig().chunkIndent;
 
 			// indentation
 
-			if (chunk.substr(0, indentStr.length()) == indentStr)
+			size_t offset = 0;
+
+			if (!indentStr.empty() &&
+				chunk.substr(0, indentStr.length()) == indentStr)
 			{
-				size_t offset = 0;
 				int32_t count = 0;
 
 				while (chunk.substr(offset, indentStr.length()) == indentStr)
@@ -194,11 +204,11 @@ namespace panini
 				ResetStyles();
 			}
 
-			// other chunks
+			// other chunks, including the comment prefix after indentation
 
-			else
+			if (offset < chunk.length())
 			{
-				WriteChunk(chunk);
+				WriteChunk(chunk.substr(offset));
 			}
 		}
 
@@ -274,7 +284,7 @@ namespace panini
 			Internal method for writing a chunk to the console window, clipping
 			it and pushing it to the next line if it's too long.
 		*/
-		inline void WriteChunk(const std::string& chunk)
+		inline void WriteChunk(std::string_view chunk)
 		{
 			size_t offsetX = static_cast<size_t>(m_cursorX) + chunk.length();
 			size_t maxWidth = static_cast<size_t>(m_consoleWidth);
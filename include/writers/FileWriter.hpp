@@ -22,8 +22,13 @@
 #pragma once
 
 #include "data/FileWriterConfig.hpp"
+#include "data/ScatterGatherBuffer.hpp"
+#include "tracing/Tracing.hpp"
 #include "writers/Writer.hpp"
 
+#include <algorithm>
+#include <stdint.h>
+
 namespace panini
 {
 
@@ -34,7 +39,21 @@ namespace panini
 
 		Unlike the \ref CompareWriter, the FileWriter will always write to the
 		target file regardless of whether the output has changed.
-		
+
+		By default, output is kept in memory and written to the file when the
+		writer is committed. Set the mode to FileWriterMode::Streaming in the
+		\ref FileWriterConfig to write output through a buffer of a fixed size
+		instead, which keeps memory usage constant for large files.
+
+		In FileWriterMode::ScatterGather mode, the writer references
+		\ref PinnedChunk chunks instead of copying them and writes all output
+		in batches of segments when it is committed. This avoids copying
+		large chunks that already exist in memory.
+
+		Outside of FileWriterMode::ScatterGather mode, lines are assembled
+		in a buffer before they are written. In FileWriterMode::Commit mode,
+		this buffer holds all output until the writer is committed.
+
 		The file stream is closed when the writer is committed, which happens
 		automatically when the writer is destroyed.
 
@@ -52,8 +71,9 @@ namespace panini
 			\param config    Configuration instance.
 		*/
 		inline FileWriter(const FileWriterConfig& config = {})
-			: FileWriter(config.targetPath, config)
+			: ConfiguredWriter(config)
 		{
+			Open();
 		}
 
 		/*!
@@ -69,11 +89,9 @@ namespace panini
 		inline FileWriter(
 			const std::filesystem::path& path,
 			const WriterConfig& config = WriterConfig())
-			: ConfiguredWriter(FileWriterConfig{ config })
+			: ConfiguredWriter(FileWriterConfig{ config, path })
 		{
-			m_config.targetPath = path;
-
-			m_target.open(m_config.targetPath.string(), std::ios::out | std::ios::binary);
+			Open();
 		}
 
 		/*!
@@ -85,25 +103,117 @@ namespace panini
 		}
 
 		/*!
-			Always close the stream when \ref Commit is called.
+			Commit the output written so far and write to a different file,
+			keeping the configuration and the memory allocated by the
+			writer.
+
+			\note Inputs added with \ref AddInput are removed.
+
+			\param path  Path to the target file.
+		*/
+		inline void Reset(const std::filesystem::path& path)
+		{
+			Commit();
+
+			m_config.targetPath = path;
+			m_config.inputs.clear();
+
+			ResetState();
+			Open();
+		}
+
+		/*!
+			Commit the output written so far and reconfigure the writer,
+			keeping the memory allocated by the writer.
+
+			\param config  Configuration instance.
+		*/
+		inline void Reset(const FileWriterConfig& config)
+		{
+			Commit();
+
+			ResetConfig(config);
+			Open();
+		}
+
+		/*!
+			Forget the dependency database and the inputs after the output
+			was committed, so a writer that was released to a
+			\ref WriterPool doesn't point to a database that may be
+			destroyed. The writer must be reset before it is used again.
+		*/
+		inline void Detach()
+		{
+			m_config.dependencies = nullptr;
+			m_config.inputs.clear();
+		}
+
+		/*!
+			Always close the file when \ref Commit is called.
 		*/
 		inline bool IsChanged() const override
 		{
-			return m_target.is_open();
+			return m_isOpen;
+		}
+
+		/*!
+			Add a file the output is generated from, in addition to the
+			inputs in the configuration. The inputs are recorded in the
+			dependency database when the writer is committed.
+		*/
+		inline void AddInput(const std::filesystem::path& path)
+		{
+			m_config.inputs.push_back(path);
 		}
 
 	protected:
 		/*!
-			Writes the chunk to the file stream.
+			Writes the chunk to the file stream. Outside of
+			FileWriterMode::ScatterGather mode, chunks are the batches of
+			assembled lines.
+		*/
+		inline void Write(std::string_view chunk) override
+		{
+			if (!m_isOpen)
+			{
+				return;
+			}
+
+			if (m_config.mode == FileWriterMode::ScatterGather)
+			{
+				m_scatter.Append(chunk);
+
+				return;
+			}
+
+			m_target.write(chunk.data(), chunk.size());
+		}
+
+		/*!
+			Keeps a reference to pinned chunks in FileWriterMode::ScatterGather
+			mode.
 		*/
-		inline void Write(const std::string& chunk) override
+		inline void WritePinned(std::string_view chunk) override
 		{
-			if (!m_target.is_open())
+			if (m_config.mode == FileWriterMode::ScatterGather)
 			{
+				if (m_isOpen)
+				{
+					m_scatter.AppendPinned(chunk);
+				}
+
 				return;
 			}
 
-			m_written += chunk;
+			Write(chunk);
+		}
+
+		/*!
+			The new line chunk is owned by the writer, so it can be pinned.
+		*/
+		inline void WriteNewLine() override
+		{
+			WritePinned(m_config.chunkNewLine);
 		}
 
 		/*!
@@ -113,15 +223,122 @@ namespace panini
 		{
 			(void)force;
 
-			m_target.write(m_written.c_str(), m_written.length());
+			PANINI_TRACE_SPAN_LABEL("commit", "FileWriter::OnCommit", m_config.targetPath.string());
+
+			if (!m_isOpen)
+			{
+				return false;
+			}
+
+			m_isOpen = false;
+
+			if (m_config.mode == FileWriterMode::ScatterGather)
+			{
+				const bool written = m_scatter.WriteTo(m_config.targetPath);
+				m_scatter.Clear();
+
+				RecordInputs(written);
+
+				return written;
+			}
+
+			// output that was only partially written must not be recorded
+			// as up to date
+
+			bool written = !m_target.fail();
+
 			m_target.close();
+			written = written && !m_target.fail();
 
-			return true;
+			RecordInputs(written);
+
+			return written;
+		}
+
+		/*!
+			Record the inputs of the output in the dependency database, if
+			one was configured. Output that failed to be written is removed
+			from the database instead.
+		*/
+		inline void RecordInputs(bool written)
+		{
+			if (m_config.dependencies == nullptr)
+			{
+				return;
+			}
+
+			if (written)
+			{
+				m_config.dependencies->Record(m_config.targetPath, m_config.inputs);
+			}
+			else
+			{
+				m_config.dependencies->Remove(m_config.targetPath);
+			}
+		}
+
+		/*!
+			Open the file stream for the target path. In
+			FileWriterMode::ScatterGather mode, the file is opened when the
+			writer is committed instead.
+
+			Every mode sets up line assembly and the buffering of the file
+			stream itself, because a writer that is reset may have been used
+			in a different mode before.
+		*/
+		inline void Open()
+		{
+			if (m_config.mode == FileWriterMode::ScatterGather)
+			{
+				// pinned chunks must reach the writer without being copied
+
+				DisableLineAssembly();
+
+				// blocks are kept when the writer is reset, unless their
+				// size changed
+
+				m_scatter.Clear();
+
+				if (m_scatter.GetBlockSize() != std::max<size_t>(m_config.bufferSize, 1))
+				{
+					m_scatter = ScatterGatherBuffer(m_config.bufferSize);
+				}
+
+				// the file is only opened when the segments are written
+
+				m_isOpen = true;
+
+				return;
+			}
+
+			// the assembled lines are the only buffer, output is written in
+			// batches of the streaming buffer size or when committed
+
+			if (m_config.mode == FileWriterMode::Streaming)
+			{
+				// long lines are written before they end, so the memory
+				// used doesn't depend on the size of the output
+
+				EnableLineAssembly(m_config.bufferSize, m_config.bufferSize);
+			}
+			else
+			{
+				EnableLineAssembly(SIZE_MAX);
+			}
+
+			// the stream doesn't need a buffer of its own
+
+			m_target = std::ofstream();
+			m_target.rdbuf()->pubsetbuf(nullptr, 0);
+
+			m_target.open(m_config.targetPath.string(), std::ios::out | std::ios::binary);
+			m_isOpen = m_target.is_open();
 		}
 
 	protected:
 		std::ofstream m_target;
-		std::string m_written;
+		ScatterGatherBuffer m_scatter;
+		bool m_isOpen = false;
 
 	};
 
@@ -0,0 +1,232 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/Fragment.hpp"
+#include "data/FragmentWriterConfig.hpp"
+#include "writers/Writer.hpp"
+
+namespace panini
+{
+
+	/*!
+		\brief Writes output to a \ref Fragment, without applying
+		indentation or new lines.
+
+		\ingroup Writers
+
+		Commands are processed as usual, but indentation, new lines and
+		comment blocks are only recorded. They are applied when the fragment
+		is spliced into another writer with \ref Splice, relative to the
+		indentation of that writer at that point. This means a fragment can
+		be rendered before its position in the output is known, for example
+		on another thread.
+
+		The writer starts on a new line, unless configured otherwise. When a
+		command checks whether the writer is on a new line before anything
+		was written, the fragment is marked with
+		\ref Fragment::IsStartOfLineDependent. Commands that depend on the
+		brace breaking style or include style use the configuration of this
+		writer, so it should match the writer the fragment is spliced into.
+
+		Example:
+
+		\code{.cpp}
+			std::vector<Fragment> sections(models.size());
+
+			for (size_t i = 0; i < models.size(); ++i)
+			{
+				pool.Submit([&models, &sections, i] {
+					FragmentWriter writer(sections[i]);
+					WriteModel(writer, models[i]);
+				});
+			}
+
+			pool.Wait();
+
+			for (const Fragment& section : sections)
+			{
+				writer << Splice(section);
+			}
+		\endcode
+
+		\sa Fragment, Splice, FragmentWriterConfig
+	*/
+
+	class FragmentWriter
+		: public ConfiguredWriter<FragmentWriterConfig>
+	{
+
+	public:
+		/*!
+			Construct and configure the writer.
+
+			\param target  Fragment that output will be added to.
+			\param config  Configuration instance.
+		*/
+		inline explicit FragmentWriter(
+			Fragment& target,
+			const FragmentWriterConfig& config = FragmentWriterConfig())
+			: ConfiguredWriter(config)
+			, m_target(target)
+			, m_isOnNewLine(config.isOnNewLine)
+		{
+		}
+
+		inline bool IsOnNewLine() const override
+		{
+			if (m_isAtStart)
+			{
+				m_target.m_isStartOfLineDependent = true;
+			}
+
+			return m_isOnNewLine;
+		}
+
+		inline Writer& operator << (std::string_view chunk) override
+		{
+			Write(chunk);
+
+			return *this;
+		}
+
+		inline Writer& operator << (const std::string& chunk) override
+		{
+			Write(chunk);
+
+			return *this;
+		}
+
+		inline Writer& operator << (const char* chunkString) override
+		{
+			Write(chunkString);
+
+			return *this;
+		}
+
+		inline Writer& operator << (char chunkCharacter) override
+		{
+			Write(std::string_view(&chunkCharacter, 1));
+
+			return *this;
+		}
+
+		inline Writer& operator << (const PinnedChunk& command) override
+		{
+			Write(command.chunk);
+
+			return *this;
+		}
+
+		inline Writer& operator << (const NextLine&) override
+		{
+			WriteNewLine();
+
+			return *this;
+		}
+
+		inline Writer& operator << (const IndentPush&) override
+		{
+			m_target.AddOperation(Fragment::OperationType::IndentPush);
+
+			return *this;
+		}
+
+		inline Writer& operator << (const IndentPop&) override
+		{
+			m_target.AddOperation(Fragment::OperationType::IndentPop);
+
+			return *this;
+		}
+
+		inline Writer& operator << (const AlignPush& command) override
+		{
+			m_target.AddOperation(Fragment::OperationType::AlignPush, command.columns);
+
+			return *this;
+		}
+
+		inline Writer& operator << (const AlignPop&) override
+		{
+			m_target.AddOperation(Fragment::OperationType::AlignPop);
+
+			return *this;
+		}
+
+		inline Writer& operator << (Command&& command) override
+		{
+			command.Visit(*this);
+
+			return *this;
+		}
+
+		inline void SetIsInCommentBlock(bool value) override
+		{
+			m_target.AddOperation(value
+				? Fragment::OperationType::CommentBlockBegin
+				: Fragment::OperationType::CommentBlockEnd);
+		}
+
+	protected:
+		/*
+			Adds the chunk to the text of the current line.
+		*/
+		inline void Write(std::string_view chunk) override
+		{
+			if (chunk.empty())
+			{
+				return;
+			}
+
+			m_target.AddText(chunk);
+
+			m_isOnNewLine = false;
+			m_isAtStart = false;
+		}
+
+		inline void WriteNewLine() override
+		{
+			m_target.AddOperation(Fragment::OperationType::NextLine);
+
+			m_isOnNewLine = true;
+			m_isAtStart = false;
+		}
+
+		/*!
+			Called when the writer is committed.
+		*/
+		inline bool OnCommit(bool force) override
+		{
+			(void)force;
+
+			return true;
+		}
+
+	protected:
+		//! Target fragment that will be written to.
+		Fragment& m_target;
+		bool m_isOnNewLine;
+		bool m_isAtStart = true;
+
+	};
+
+};
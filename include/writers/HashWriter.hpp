@@ -0,0 +1,133 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/Hash64.hpp"
+#include "data/HashWriterConfig.hpp"
+#include "writers/Writer.hpp"
+
+namespace panini
+{
+
+	/*!
+		\brief Fingerprints output without storing it.
+
+		\ingroup Writers
+
+		Every chunk is fed into a \ref Hash64 as it is written, so the writer
+		uses the same amount of memory regardless of the size of the output.
+		The digest is identical to hashing the output of a \ref StringWriter
+		with the same configuration.
+
+		Example:
+
+		\code{.cpp}
+			HashWriter w;
+			w << Scope("int main()", [](Writer& w) {
+				w << "return 0;" << NextLine();
+			});
+
+			uint64_t digest = w.GetDigest();
+		\endcode
+
+		\sa HashWriterConfig
+	*/
+
+	class HashWriter
+		: public ConfiguredWriter<HashWriterConfig>
+	{
+
+	public:
+		/*!
+			Construct and configure the writer.
+
+			\param config  Configuration instance.
+		*/
+		inline explicit HashWriter(const HashWriterConfig& config = HashWriterConfig())
+			: ConfiguredWriter(config)
+			, m_hash(config.seed)
+		{
+		}
+
+		/*!
+			Digest of the output written so far.
+		*/
+		inline uint64_t GetDigest() const
+		{
+			return m_hash.GetDigest();
+		}
+
+		/*!
+			Number of bytes written so far.
+		*/
+		inline uint64_t GetByteCount() const
+		{
+			return m_hash.GetSize();
+		}
+
+		/*!
+			Number of lines written so far. The last line is only counted when
+			it is not empty.
+		*/
+		inline uint64_t GetLineCount() const
+		{
+			return m_newLineCount + (m_hash.GetSize() > m_lineStart ? 1 : 0);
+		}
+
+	protected:
+		/*!
+			Adds the chunk to the hash.
+		*/
+		inline void Write(std::string_view chunk) override
+		{
+			m_hash.Update(chunk);
+		}
+
+		/*!
+			Adds the new line to the hash and counts it.
+		*/
+		inline void WriteNewLine() override
+		{
+			m_hash.Update(m_config.chunkNewLine);
+
+			m_newLineCount++;
+			m_lineStart = m_hash.GetSize();
+		}
+
+		/*!
+			Called when the writer is committed.
+		*/
+		inline bool OnCommit(bool force) override
+		{
+			(void)force;
+
+			return true;
+		}
+
+	protected:
+		Hash64 m_hash;
+		uint64_t m_newLineCount = 0;
+		uint64_t m_lineStart = 0;
+
+	};
+
+};
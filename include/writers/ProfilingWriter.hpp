@@ -0,0 +1,432 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/CommandProfile.hpp"
+#include "data/JsonString.hpp"
+#include "data/TypeName.hpp"
+#include "writers/Writer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Measures the cost of every type of command written to
+		another writer.
+
+		\ingroup Writers
+
+		The ProfilingWriter passes everything it receives to the target
+		writer, so the output is unchanged. Commands are visited with the
+		ProfilingWriter itself, which means commands written from inside
+		other commands are measured as well. For every type of command, the
+		number of invocations, the time spent and the chunks and bytes
+		written are collected into a \ref CommandProfile.
+
+		Commands of the same class template are collected under the same
+		name, so all \ref BasicScope instantiations are reported as one.
+
+		Only writers wrapped by a ProfilingWriter are measured, other writers
+		are not affected.
+
+		Example:
+
+		\code{.cpp}
+			FileWriter file(config);
+			ProfilingWriter writer(file);
+
+			GenerateHierarchy(writer);
+
+			writer.WriteReport(std::cout);
+		\endcode
+
+		\sa CommandProfile
+	*/
+
+	class ProfilingWriter
+		: public Writer
+	{
+
+	public:
+		using TClock = std::chrono::steady_clock;
+
+		/*!
+			Construct the writer.
+
+			\param target  Writer that receives the output.
+		*/
+		inline explicit ProfilingWriter(Writer& target)
+			: m_target(target)
+		{
+		}
+
+		/*!
+			Profiles of all command types that were visited, sorted by
+			inclusive time from most to least expensive.
+		*/
+		inline std::vector<CommandProfile> GetProfiles() const
+		{
+			std::vector<CommandProfile> profiles = m_profiles;
+
+			std::stable_sort(profiles.begin(), profiles.end(), [](const CommandProfile& left, const CommandProfile& right) {
+				return left.inclusiveTime > right.inclusiveTime;
+			});
+
+			return profiles;
+		}
+
+		/*!
+			Remove all collected profiles.
+		*/
+		inline void Reset()
+		{
+			m_profiles.clear();
+			m_profileByType.clear();
+			m_profileByName.clear();
+		}
+
+		/*!
+			Write a table of the profiles, sorted by inclusive time.
+		*/
+		inline void WriteReport(std::ostream& stream) const
+		{
+			const std::vector<CommandProfile> profiles = GetProfiles();
+
+			size_t nameWidth = 7;
+			for (const CommandProfile& profile : profiles)
+			{
+				nameWidth = std::max(nameWidth, profile.name.size());
+			}
+
+			stream << std::left << std::setw(static_cast<int>(nameWidth)) << "Command" << std::right
+				<< std::setw(12) << "Calls"
+				<< std::setw(14) << "Incl. us"
+				<< std::setw(14) << "Excl. us"
+				<< std::setw(12) << "Chunks"
+				<< std::setw(14) << "Bytes" << '\n';
+			stream << std::string(nameWidth + 66, '-') << '\n';
+
+			for (const CommandProfile& profile : profiles)
+			{
+				stream << std::left << std::setw(static_cast<int>(nameWidth)) << profile.name << std::right
+					<< std::setw(12) << profile.invocationCount
+					<< std::fixed << std::setprecision(1)
+					<< std::setw(14) << static_cast<double>(profile.inclusiveTime) / 1000.0
+					<< std::setw(14) << static_cast<double>(profile.exclusiveTime) / 1000.0
+					<< std::setw(12) << profile.inclusiveChunkCount
+					<< std::setw(14) << profile.inclusiveByteCount << '\n';
+			}
+		}
+
+		/*!
+			Write the profiles as a JSON array, sorted by inclusive time.
+			Times are in nanoseconds.
+		*/
+		inline void WriteJson(std::ostream& stream) const
+		{
+			const std::vector<CommandProfile> profiles = GetProfiles();
+
+			stream << '[';
+
+			for (size_t i = 0; i < profiles.size(); ++i)
+			{
+				const CommandProfile& profile = profiles[i];
+
+				stream << (i > 0 ? "," : "") << "\n\t{ \"name\": \"";
+				WriteJsonString(stream, profile.name);
+				stream << "\", \"invocationCount\": " << profile.invocationCount
+					<< ", \"inclusiveTime\": " << profile.inclusiveTime
+					<< ", \"exclusiveTime\": " << profile.exclusiveTime
+					<< ", \"inclusiveChunkCount\": " << profile.inclusiveChunkCount
+					<< ", \"exclusiveChunkCount\": " << profile.exclusiveChunkCount
+					<< ", \"inclusiveByteCount\": " << profile.inclusiveByteCount
+					<< ", \"exclusiveByteCount\": " << profile.exclusiveByteCount
+					<< " }";
+			}
+
+			stream << (profiles.empty() ? "]" : "\n]") << '\n';
+		}
+
+		inline const WriterConfig& GetConfig() const override
+		{
+			return m_target.GetConfig();
+		}
+
+		inline BraceBreakingStyle GetBraceBreakingStyle() const override
+		{
+			return m_target.GetBraceBreakingStyle();
+		}
+
+		inline IncludeStyle GetIncludeStyle() const override
+		{
+			return m_target.GetIncludeStyle();
+		}
+
+		inline bool IsOnNewLine() const override
+		{
+			return m_target.IsOnNewLine();
+		}
+
+		inline Writer& operator << (std::string_view chunk) override
+		{
+			CountChunk(chunk.size());
+			m_target << chunk;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const std::string& chunk) override
+		{
+			CountChunk(chunk.size());
+			m_target << chunk;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const char* chunkString) override
+		{
+			return *this << std::string_view(chunkString);
+		}
+
+		inline Writer& operator << (char chunkCharacter) override
+		{
+			CountChunk(1);
+			m_target << chunkCharacter;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const PinnedChunk& command) override
+		{
+			CountChunk(command.chunk.size());
+			m_target << command;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const NextLine& command) override
+		{
+			m_target << command;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const IndentPush& command) override
+		{
+			m_target << command;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const IndentPop& command) override
+		{
+			m_target << command;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const AlignPush& command) override
+		{
+			m_target << command;
+
+			return *this;
+		}
+
+		inline Writer& operator << (const AlignPop& command) override
+		{
+			m_target << command;
+
+			return *this;
+		}
+
+		/*!
+			Visit the command with this writer and add its cost to the
+			profile of its type.
+		*/
+		inline Writer& operator << (Command&& command) override
+		{
+			PANINI_TRACE_COMMAND(command);
+
+			Frame frame;
+			frame.profile = GetProfileIndex(typeid(command));
+			m_frames.push_back(frame);
+			m_frames.back().start = TClock::now();
+
+			try
+			{
+				command.Visit(*this);
+			}
+			catch (...)
+			{
+				PopFrame();
+
+				throw;
+			}
+
+			PopFrame();
+
+			return *this;
+		}
+
+		inline void SetIsInCommentBlock(bool value) override
+		{
+			m_target.SetIsInCommentBlock(value);
+		}
+
+		inline bool IsChanged() const override
+		{
+			return m_target.IsChanged();
+		}
+
+		inline bool Commit(bool force = false) override
+		{
+			return m_target.Commit(force);
+		}
+
+	protected:
+		inline void Write(std::string_view chunk) override
+		{
+			*this << chunk;
+		}
+
+		inline void WritePinned(std::string_view chunk) override
+		{
+			*this << PinnedChunk{ chunk };
+		}
+
+		inline void WriteNewLine() override
+		{
+			*this << NextLine();
+		}
+
+		inline bool OnCommit(bool force = false) override
+		{
+			return m_target.Commit(force);
+		}
+
+	private:
+		/*
+			A command that is being visited. The first frame collects output
+			written outside of commands.
+		*/
+		struct Frame
+		{
+			size_t profile = SIZE_MAX;
+			TClock::time_point start;
+			uint64_t childTime = 0;
+			uint64_t chunkCount = 0;
+			uint64_t childChunkCount = 0;
+			uint64_t byteCount = 0;
+			uint64_t childByteCount = 0;
+		};
+
+		inline void CountChunk(size_t size)
+		{
+			Frame& frame = m_frames.back();
+			frame.chunkCount++;
+			frame.byteCount += size;
+		}
+
+		inline void PopFrame()
+		{
+			const Frame frame = m_frames.back();
+			m_frames.pop_back();
+
+			const uint64_t time = static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(TClock::now() - frame.start).count());
+			const uint64_t chunkCount = frame.chunkCount + frame.childChunkCount;
+			const uint64_t byteCount = frame.byteCount + frame.childByteCount;
+
+			CommandProfile& profile = m_profiles[frame.profile];
+			profile.invocationCount++;
+			profile.exclusiveTime += time - std::min(time, frame.childTime);
+			profile.exclusiveChunkCount += frame.chunkCount;
+			profile.exclusiveByteCount += frame.byteCount;
+
+			// recursive commands of the same type are only counted once,
+			// by the outermost command
+
+			const bool isNested = std::any_of(m_frames.begin(), m_frames.end(), [&frame](const Frame& it) {
+				return it.profile == frame.profile;
+			});
+			if (!isNested)
+			{
+				profile.inclusiveTime += time;
+				profile.inclusiveChunkCount += chunkCount;
+				profile.inclusiveByteCount += byteCount;
+			}
+
+			Frame& parent = m_frames.back();
+			parent.childTime += time;
+			parent.childChunkCount += chunkCount;
+			parent.childByteCount += byteCount;
+		}
+
+		inline size_t GetProfileIndex(const std::type_info& type)
+		{
+			auto found = m_profileByType.find(type);
+			if (found != m_profileByType.end())
+			{
+				return found->second;
+			}
+
+			// instantiations of the same template share a profile
+
+			std::string name = GetTypeName(type);
+
+			size_t index = 0;
+
+			auto foundName = m_profileByName.find(name);
+			if (foundName != m_profileByName.end())
+			{
+				index = foundName->second;
+			}
+			else
+			{
+				index = m_profiles.size();
+				m_profiles.push_back(CommandProfile{ name });
+				m_profileByName.emplace(std::move(name), index);
+			}
+
+			m_profileByType.emplace(type, index);
+
+			return index;
+		}
+
+	private:
+		Writer& m_target;
+		std::vector<Frame> m_frames = std::vector<Frame>(1);
+		std::vector<CommandProfile> m_profiles;
+		std::unordered_map<std::type_index, size_t> m_profileByType;
+		std::unordered_map<std::string, size_t> m_profileByName;
+
+	};
+
+};
@@ -0,0 +1,237 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "data/WriterConfig.hpp"
+#include "writers/Writer.hpp"
+
+#include <type_traits>
+
+namespace panini
+{
+
+	/*!
+		\brief Writes output to a sink that is known at compile time.
+
+		\ingroup Writers
+
+		A sink is any type that implements the following methods:
+
+		\code{.cpp}
+			void Append(std::string_view chunk);
+			bool Flush();
+		\endcode
+
+		Because the writer is final and the sink is a template parameter,
+		chunks written directly to a SinkWriter do not pass through virtual
+		calls and the sink inlines into the indentation and new line logic.
+		The writer can still be used wherever a \ref Writer is expected, e.g.
+		as the target of commands.
+
+		The sink is flushed when the writer is committed, which happens
+		automatically when the writer is destroyed.
+
+		Example:
+
+		\code{.cpp}
+			std::string output;
+			SinkWriter writer(StringSink{ output });
+
+			writer << "int main()" << NextLine();
+		\endcode
+
+		\sa StringSink, BufferSink, FileDescriptorSink
+	*/
+
+	template <typename TSink, typename TConfig = WriterConfig>
+	class SinkWriter final
+		: public ConfiguredWriter<TConfig>
+	{
+
+		static_assert(
+			std::is_void_v<decltype(std::declval<TSink&>().Append(std::string_view()))>,
+			"TSink must implement void Append(std::string_view chunk)"
+		);
+		static_assert(
+			std::is_same_v<decltype(std::declval<TSink&>().Flush()), bool>,
+			"TSink must implement bool Flush()"
+		);
+
+		using TBase = ConfiguredWriter<TConfig>;
+
+	public:
+		/*!
+			Construct and configure the writer with a `sink` that is moved into
+			the instance.
+
+			\param sink    Target for the output.
+			\param config  Configuration instance.
+		*/
+		inline explicit SinkWriter(
+			TSink&& sink,
+			const TConfig& config = TConfig{})
+			: TBase(config)
+			, m_sink(std::move(sink))
+		{
+		}
+
+		/*!
+			Will call Commit() automatically when the writer is destroyed.
+		*/
+		inline ~SinkWriter() override
+		{
+			this->Commit();
+		}
+
+		/*!
+			Get a reference to the sink.
+		*/
+		inline TSink& GetSink()
+		{
+			return m_sink;
+		}
+
+		/*!
+			Check if output was appended to the sink since the last commit.
+		*/
+		inline bool IsChanged() const override
+		{
+			return m_isChanged;
+		}
+
+		inline SinkWriter& operator << (std::string_view chunk) override
+		{
+			this->ProcessChunk(chunk, [this](std::string_view output) {
+				Append(output);
+			});
+
+			return *this;
+		}
+
+		inline SinkWriter& operator << (const std::string& chunk) override
+		{
+			return *this << std::string_view(chunk);
+		}
+
+		inline SinkWriter& operator << (const char* chunkString) override
+		{
+			return *this << std::string_view(chunkString);
+		}
+
+		inline SinkWriter& operator << (char chunkCharacter) override
+		{
+			return *this << std::string_view(&chunkCharacter, 1);
+		}
+
+		inline SinkWriter& operator << (const PinnedChunk& command) override
+		{
+			return *this << command.chunk;
+		}
+
+		inline SinkWriter& operator << (const NextLine& command) override
+		{
+			(void)command;
+
+			this->ProcessNewLine(
+				[this](std::string_view output) {
+					Append(output);
+				},
+				[this]() {
+					Append(this->m_config.chunkNewLine);
+				}
+			);
+
+			return *this;
+		}
+
+		inline SinkWriter& operator << (const IndentPush& command) override
+		{
+			TBase::operator << (command);
+
+			return *this;
+		}
+
+		inline SinkWriter& operator << (const IndentPop& command) override
+		{
+			TBase::operator << (command);
+
+			return *this;
+		}
+
+		inline SinkWriter& operator << (const AlignPush& command) override
+		{
+			TBase::operator << (command);
+
+			return *this;
+		}
+
+		inline SinkWriter& operator << (const AlignPop& command) override
+		{
+			TBase::operator << (command);
+
+			return *this;
+		}
+
+		inline SinkWriter& operator << (Command&& command) override
+		{
+			PANINI_TRACE_COMMAND(command);
+
+			command.Visit(*this);
+
+			return *this;
+		}
+
+	protected:
+		inline void Write(std::string_view chunk) override
+		{
+			Append(chunk);
+		}
+
+		inline void WriteNewLine() override
+		{
+			Append(this->m_config.chunkNewLine);
+		}
+
+		inline bool OnCommit(bool force) override
+		{
+			(void)force;
+
+			m_isChanged = false;
+
+			return m_sink.Flush();
+		}
+
+	private:
+		inline void Append(std::string_view chunk)
+		{
+			m_sink.Append(chunk);
+
+			m_isChanged = true;
+		}
+
+	private:
+		TSink m_sink;
+		bool m_isChanged = false;
+
+	};
+
+};
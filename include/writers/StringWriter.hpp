@@ -50,17 +50,56 @@ namespace panini
 			std::string& target,
 			const StringWriterConfig& config = StringWriterConfig())
 			: ConfiguredWriter(config)
-			, m_target(target)
+			, m_target(&target)
 		{
 		}
 
+		/*!
+			Write to a different string, keeping the configuration and the
+			memory allocated by the writer.
+
+			\param target  String that output will be written to.
+		*/
+		inline void Reset(std::string& target)
+		{
+			m_target = &target;
+
+			ResetState();
+		}
+
+		/*!
+			Write to a different string with a different configuration,
+			keeping the memory allocated by the writer.
+
+			\param target  String that output will be written to.
+			\param config  Configuration instance.
+		*/
+		inline void Reset(
+			std::string& target,
+			const StringWriterConfig& config)
+		{
+			m_target = &target;
+
+			ResetConfig(config);
+		}
+
+		/*!
+			Forget the target string, so a writer that was released to a
+			\ref WriterPool doesn't point to a string that may be destroyed.
+			The writer must be reset before it is used again.
+		*/
+		inline void Detach()
+		{
+			m_target = nullptr;
+		}
+
 	protected:
 		/*
 			Writes the chunk to the target string.
 		*/
-		inline void Write(const std::string& chunk) override
+		inline void Write(std::string_view chunk) override
 		{
-			m_target += chunk;
+			m_target->append(chunk);
 		}
 
 		/*!
@@ -75,7 +114,7 @@ namespace panini
 
 	protected:
 		//! Target string that will be written to.
-		std::string& m_target;
+		std::string* m_target;
 
 	};
 
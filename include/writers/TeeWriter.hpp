@@ -0,0 +1,299 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "writers/Writer.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Writes the output of a single pass to multiple writers.
+
+		\ingroup Writers
+
+		The TeeWriter forwards chunks, new lines, indentation and comment
+		blocks to every target writer. Commands are visited only once, with
+		the TeeWriter itself, so a generator runs a single time no matter
+		how many writers receive its output.
+
+		Every target applies its own configuration to what it receives, so
+		targets can use a different `chunkNewLine` or `chunkIndent`. Decisions
+		made by commands, like the brace breaking style and the include
+		style, are based on the first target, because the command is only
+		visited once.
+
+		Example:
+
+		\code{.cpp}
+			CompareWriter file(config);
+			HashWriter digest;
+			ConsoleWriter preview;
+			TeeWriter writer({ file, digest, preview });
+
+			GenerateHierarchy(writer);
+
+			writer.Commit();
+		\endcode
+	*/
+
+	class TeeWriter
+		: public Writer
+	{
+
+	public:
+		/*!
+			Construct the writer without targets.
+		*/
+		inline TeeWriter() = default;
+
+		/*!
+			Construct the writer with a list of targets. The first target
+			determines the configuration used by commands.
+		*/
+		inline TeeWriter(std::initializer_list<std::reference_wrapper<Writer>> targets)
+		{
+			m_targets.reserve(targets.size());
+
+			for (Writer& target : targets)
+			{
+				m_targets.push_back(&target);
+			}
+		}
+
+		/*!
+			Add a writer that receives the output from now on.
+		*/
+		inline void Add(Writer& target)
+		{
+			m_targets.push_back(&target);
+		}
+
+		/*!
+			Number of writers that receive the output.
+		*/
+		inline size_t GetTargetCount() const
+		{
+			return m_targets.size();
+		}
+
+		inline const WriterConfig& GetConfig() const override
+		{
+			static const WriterConfig s_DefaultConfig;
+
+			return m_targets.empty() ? s_DefaultConfig : m_targets.front()->GetConfig();
+		}
+
+		inline BraceBreakingStyle GetBraceBreakingStyle() const override
+		{
+			return m_targets.empty() ? GetConfig().braceBreakingStyle : m_targets.front()->GetBraceBreakingStyle();
+		}
+
+		inline IncludeStyle GetIncludeStyle() const override
+		{
+			return m_targets.empty() ? GetConfig().includeStyle : m_targets.front()->GetIncludeStyle();
+		}
+
+		inline bool IsOnNewLine() const override
+		{
+			return m_targets.empty() || m_targets.front()->IsOnNewLine();
+		}
+
+		inline Writer& operator << (std::string_view chunk) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << chunk;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const std::string& chunk) override
+		{
+			return *this << std::string_view(chunk);
+		}
+
+		inline Writer& operator << (const char* chunkString) override
+		{
+			return *this << std::string_view(chunkString);
+		}
+
+		inline Writer& operator << (char chunkCharacter) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << chunkCharacter;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const PinnedChunk& command) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << command;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const NextLine& command) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << command;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const IndentPush& command) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << command;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const IndentPop& command) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << command;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const AlignPush& command) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << command;
+			}
+
+			return *this;
+		}
+
+		inline Writer& operator << (const AlignPop& command) override
+		{
+			for (Writer* target : m_targets)
+			{
+				*target << command;
+			}
+
+			return *this;
+		}
+
+		/*!
+			Visit the command once with this writer, which passes its output
+			to every target.
+		*/
+		inline Writer& operator << (Command&& command) override
+		{
+			PANINI_TRACE_COMMAND(command);
+
+			command.Visit(*this);
+
+			return *this;
+		}
+
+		inline void SetIsInCommentBlock(bool value) override
+		{
+			for (Writer* target : m_targets)
+			{
+				target->SetIsInCommentBlock(value);
+			}
+		}
+
+		/*!
+			Check if the output was changed for any of the targets.
+		*/
+		inline bool IsChanged() const override
+		{
+			for (const Writer* target : m_targets)
+			{
+				if (target->IsChanged())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/*!
+			Commits the output of every target.
+
+			\param force Force writing the output even if it was not changed.
+
+			\return Returns true if any of the targets committed its output.
+		*/
+		inline bool Commit(bool force = false) override
+		{
+			return OnCommit(force);
+		}
+
+	protected:
+		inline void Write(std::string_view chunk) override
+		{
+			*this << chunk;
+		}
+
+		inline void WritePinned(std::string_view chunk) override
+		{
+			*this << PinnedChunk{ chunk };
+		}
+
+		inline void WriteNewLine() override
+		{
+			*this << NextLine();
+		}
+
+		inline bool OnCommit(bool force = false) override
+		{
+			// every target is committed, even after one of them failed
+
+			bool committed = false;
+
+			for (Writer* target : m_targets)
+			{
+				committed = target->Commit(force) || committed;
+			}
+
+			return committed;
+		}
+
+	private:
+		std::vector<Writer*> m_targets;
+
+	};
+
+};
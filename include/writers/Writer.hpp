@@ -21,11 +21,20 @@
 
 #pragma once
 
+#include "commands/AlignPop.hpp"
+#include "commands/AlignPush.hpp"
 #include "commands/Command.hpp"
 #include "commands/IndentPop.hpp"
 #include "commands/IndentPush.hpp"
 #include "commands/NextLine.hpp"
+#include "commands/PinnedChunk.hpp"
 #include "data/WriterConfig.hpp"
+#include "tracing/Tracing.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include <string_view>
+#include <vector>
 
 namespace panini
 {
@@ -75,6 +84,16 @@ namespace panini
 		*/
 		virtual bool IsOnNewLine() const = 0;
 
+		/*!
+			Write an `std::string_view` chunk to the output.
+
+			Will add indentation if the writer is on a new line. The chunk is
+			not copied before it reaches the target of the writer.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		virtual Writer& operator << (std::string_view chunk) = 0;
+
 		/*!
 			Write an `std::string` chunk to the output.
 
@@ -93,6 +112,25 @@ namespace panini
 		*/
 		virtual Writer& operator << (const char* chunkString) = 0;
 
+		/*!
+			Write a single character chunk to the output.
+
+			Will add indentation if the writer is on a new line.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		virtual Writer& operator << (char chunkCharacter) = 0;
+
+		/*!
+			Write a chunk whose storage outlives the writer to the output.
+
+			Will add indentation if the writer is on a new line. Writers may
+			keep a reference to the chunk instead of copying it.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		virtual Writer& operator << (const PinnedChunk& command) = 0;
+
 		/*!
 			Write a new line chunk to the output.
 
@@ -121,6 +159,22 @@ namespace panini
 		*/
 		virtual Writer& operator << (const IndentPop& command) = 0;
 
+		/*!
+			Add columns to the alignment of new lines, which is written as
+			spaces after the indentation.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		virtual Writer& operator << (const AlignPush& command) = 0;
+
+		/*!
+			Undo the last \ref AlignPush. Does nothing if no alignment was
+			pushed.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		virtual Writer& operator << (const AlignPop& command) = 0;
+
 		/*!
 			Visit a command.
 
@@ -158,8 +212,16 @@ namespace panini
 	protected:
 		/*!
 			Writes chunks to the output.
+
+			\note The chunk is only valid for the duration of the call.
 		*/
-		virtual void Write(const std::string& chunk) = 0;
+		virtual void Write(std::string_view chunk) = 0;
+
+		/*!
+			Writes chunks that remain valid until the writer is committed to
+			the output.
+		*/
+		virtual void WritePinned(std::string_view chunk) = 0;
 
 		/*!
 			Writes a new line chunk to the output.
@@ -178,6 +240,19 @@ namespace panini
 
 		When making your own writer, you should inherit from this class and
 		supply a config struct that inherits from \ref WriterConfig.
+
+		The indentation and comment prefix of a line are written as a single
+		chunk. Override \ref OnLineStart to act on the start of a new line.
+
+		Indentation and alignment are views into a single slab of indent
+		chunks followed by spaces, which only grows when the writer reaches
+		a deeper level than before. Changing the level of indentation does
+		not allocate or copy outside of comment blocks.
+
+		Writers that only read their output when they are committed can
+		call \ref EnableLineAssembly. Lines are then assembled in a buffer
+		and handed to \ref WriteLines in batches, instead of calling
+		\ref Write for every chunk.
 	*/
 	template <typename TConfig>
 	class ConfiguredWriter
@@ -193,25 +268,12 @@ namespace panini
 		inline explicit ConfiguredWriter(const TConfig& config = TConfig{})
 			: m_config(config)
 		{
-			// reserve cached strings
-
-			const size_t indentReserveSize = 8 * m_config.chunkIndent.size();
-			m_lineIndentCached.reserve(indentReserveSize);
-			m_commentIndentCached.reserve(indentReserveSize);
+			// reserve indentation for typical levels of nesting
 
-			// inherit is not allowed on the config
+			ReserveIndentation(16, 64);
+			m_alignments.reserve(8);
 
-			if (m_config.braceBreakingStyle == BraceBreakingStyle::Inherit)
-			{
-				TConfig defaultConfig;
-				m_config.braceBreakingStyle = defaultConfig.braceBreakingStyle;
-			}
-
-			if (m_config.includeStyle == IncludeStyle::Inherit)
-			{
-				WriterConfig defaultConfig;
-				m_config.includeStyle = defaultConfig.includeStyle;
-			}
+			ResolveConfig();
 		}
 
 		virtual ~ConfiguredWriter() = default;
@@ -264,45 +326,41 @@ namespace panini
 		}
 
 		/*!
-			Write an `std::string` chunk to the output.
+			Write an `std::string_view` chunk to the output.
 
-			Will add indentation if the writer is on a new line.
+			Will add indentation if the writer is on a new line. The chunk is
+			not copied before it reaches the target of the writer.
 
 			\return Reference to itself to allow for chaining.
 		*/
-		inline Writer& operator << (const std::string& chunk) override
+		inline Writer& operator << (std::string_view chunk) override
 		{
-			if (m_state == State::NewLine)
+			if (m_isAssemblingLines)
 			{
-				if (!m_lineIndentCached.empty())
-				{
-					Write(m_lineIndentCached);
-				}
-				else
-				{
-					// allow writers to act on new lines
+				ProcessChunk(chunk, [this](std::string_view output) {
+					AssembleChunk(output);
+				});
 
-					Write("");
-				}
+				return *this;
+			}
 
-				m_state = State::Chunk;
+			ProcessChunk(chunk, [this](std::string_view output) {
+				Write(output);
+			});
 
-				if (m_isInCommentBlock)
-				{
-					Write(" * ");
-
-					if (!m_commentIndentCached.empty())
-					{
-						Write(m_commentIndentCached);
-					}
-				}
-			}
+			return *this;
+		}
 
-			Write(chunk);
+		/*!
+			Write an `std::string` chunk to the output.
 
-			m_lineChunkCountWritten += chunk.size();
+			Will add indentation if the writer is on a new line.
 
-			return *this;
+			\return Reference to itself to allow for chaining.
+		*/
+		inline Writer& operator << (const std::string& chunk) override
+		{
+			return *this << std::string_view(chunk);
 		}
 
 		/*!
@@ -314,7 +372,47 @@ namespace panini
 		*/
 		inline Writer& operator << (const char* chunkString) override
 		{
-			return *this << std::string(chunkString);
+			return *this << std::string_view(chunkString);
+		}
+
+		/*!
+			Write a single character chunk to the output.
+
+			Will add indentation if the writer is on a new line.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		inline Writer& operator << (char chunkCharacter) override
+		{
+			return *this << std::string_view(&chunkCharacter, 1);
+		}
+
+		/*!
+			Write a chunk whose storage outlives the writer to the output.
+
+			Will add indentation if the writer is on a new line. Writers may
+			keep a reference to the chunk instead of copying it.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		inline Writer& operator << (const PinnedChunk& command) override
+		{
+			if (m_isAssemblingLines)
+			{
+				return *this << command.chunk;
+			}
+
+			ProcessChunk(
+				command.chunk,
+				[this](std::string_view output) {
+					Write(output);
+				},
+				[this](std::string_view output) {
+					WritePinned(output);
+				}
+			);
+
+			return *this;
 		}
 
 		/*!
@@ -328,19 +426,33 @@ namespace panini
 		{
 			(void)command;
 
-			// edge-case for empty lines within a comment block
-
-			if (m_isInCommentBlock &&
-				m_lineChunkCountWritten == 0)
+			if (m_isAssemblingLines)
 			{
-				Write(" *");
-			}
-
-			WriteNewLine();
+				ProcessNewLine(
+					[this](std::string_view output) {
+						m_assembledLines.append(output);
+					},
+					[this]() {
+						m_assembledLines.append(m_config.chunkNewLine);
+
+						if (m_assembledLines.size() >= m_assemblyBatchSize)
+						{
+							FlushLines();
+						}
+					}
+				);
 
-			m_state = State::NewLine;
+				return *this;
+			}
 
-			m_lineChunkCountWritten = 0;
+			ProcessNewLine(
+				[this](std::string_view output) {
+					Write(output);
+				},
+				[this]() {
+					WriteNewLine();
+				}
+			);
 
 			return *this;
 		}
@@ -358,13 +470,15 @@ namespace panini
 
 			if (!m_isInCommentBlock)
 			{
-				CacheIndentation(m_lineIndentCached, ++m_lineIndentCount);
+				++m_lineIndentCount;
 			}
 			else
 			{
-				CacheIndentation(m_commentIndentCached, ++m_commentIndentCount);
+				++m_commentIndentCount;
 			}
 
+			CacheLinePrefix();
+
 			return *this;
 		}
 
@@ -384,23 +498,57 @@ namespace panini
 			{
 				if (m_lineIndentCount > 0)
 				{
-					CacheIndentation(
-						m_lineIndentCached,
-						--m_lineIndentCount
-					);
+					--m_lineIndentCount;
 				}
 			}
 			else
 			{
 				if (m_commentIndentCount > 0)
 				{
-					CacheIndentation(
-						m_commentIndentCached,
-						--m_commentIndentCount
-					);
+					--m_commentIndentCount;
 				}
 			}
 
+			CacheLinePrefix();
+
+			return *this;
+		}
+
+		/*!
+			Add columns to the alignment of new lines.
+
+			Alignment is written as spaces after the indentation, and after
+			the comment prefix in a comment block.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		inline Writer& operator << (const AlignPush& command) override
+		{
+			m_alignments.push_back(command.columns);
+			m_alignColumns += command.columns;
+
+			CacheLinePrefix();
+
+			return *this;
+		}
+
+		/*!
+			Undo the last \ref AlignPush.
+
+			\return Reference to itself to allow for chaining.
+		*/
+		inline Writer& operator << (const AlignPop& command) override
+		{
+			(void)command;
+
+			if (!m_alignments.empty())
+			{
+				m_alignColumns -= m_alignments.back();
+				m_alignments.pop_back();
+
+				CacheLinePrefix();
+			}
+
 			return *this;
 		}
 
@@ -415,6 +563,8 @@ namespace panini
 		*/
 		inline Writer& operator << (Command&& command) override
 		{
+			PANINI_TRACE_COMMAND(command);
+
 			command.Visit(*this);
 
 			return *this;
@@ -429,7 +579,8 @@ namespace panini
 			m_isInCommentBlock = value;
 
 			m_commentIndentCount = 0;
-			m_commentIndentCached.clear();
+
+			CacheLinePrefix();
 		}
 
 		/*!
@@ -452,10 +603,137 @@ namespace panini
 		*/
 		inline bool Commit(bool force = false) override
 		{
+			FlushLines();
+
 			return (force || IsChanged()) && OnCommit(force);
 		}
 
 	protected:
+		/*!
+			Called before the first output of a line is written, while
+			\ref IsOnNewLine still returns true. Does nothing by default.
+		*/
+		virtual void OnLineStart()
+		{
+		}
+
+		/*!
+			Writes assembled output when line assembly is enabled. The output
+			contains one or more lines, including their new line chunks.
+			\ref WriteNewLine is not called for these lines. When the size of
+			the buffer is limited, the output may end or start in the middle
+			of a line.
+
+			The output is written as a single chunk by default.
+
+			\note The output is only valid for the duration of the call.
+		*/
+		virtual void WriteLines(std::string_view lines)
+		{
+			Write(lines);
+		}
+
+		/*!
+			Assemble output in a buffer and hand it to \ref WriteLines when
+			a line ends and the buffer holds at least `batchSize` bytes. A
+			batch size of zero hands over every line separately, `SIZE_MAX`
+			hands over all output at once when the writer is committed.
+
+			Output is also handed over in the middle of a line once the
+			buffer holds at least `maxSize` bytes, so a long line doesn't
+			have to fit in memory. Chunks of at least `maxSize` bytes are
+			handed over without being copied.
+
+			The buffer is flushed when the writer is committed. Writers that
+			override \ref Commit should call \ref FlushLines first.
+
+			\note Pinned chunks are copied into the buffer.
+		*/
+		inline void EnableLineAssembly(size_t batchSize, size_t maxSize = SIZE_MAX)
+		{
+			m_isAssemblingLines = true;
+			m_assemblyBatchSize = batchSize;
+			m_assemblyMaxSize = maxSize;
+			m_assembledLines.reserve(std::min<size_t>(batchSize, 64 * 1024) + 256);
+		}
+
+		/*!
+			Hand assembled output to \ref WriteLines and write every chunk
+			with \ref Write again. The memory of the buffer is kept.
+		*/
+		inline void DisableLineAssembly()
+		{
+			FlushLines();
+
+			m_isAssemblingLines = false;
+			m_assemblyBatchSize = 0;
+			m_assemblyMaxSize = SIZE_MAX;
+		}
+
+		/*!
+			Return the writer to the start of a new output, at the first line
+			without indentation, alignment or a comment block. Output that
+			was assembled but not written yet is dropped.
+
+			Allocated memory is kept, so a writer can be reused for many
+			outputs without allocating again.
+		*/
+		inline void ResetState()
+		{
+			m_lineChunkCountWritten = 0;
+			m_lineIndentCount = 0;
+			m_state = State::NewLine;
+			m_isInCommentBlock = false;
+			m_commentIndentCount = 0;
+			m_alignments.clear();
+			m_alignColumns = 0;
+			m_linePrefixCached.clear();
+			m_assembledLines.clear();
+		}
+
+		/*!
+			Replace the configuration and reset the state of the writer.
+
+			\sa ResetState
+		*/
+		inline void ResetConfig(const TConfig& config)
+		{
+			const bool isIndentChanged = config.chunkIndent != m_config.chunkIndent;
+
+			m_config = config;
+			ResolveConfig();
+
+			if (isIndentChanged)
+			{
+				// the slab is rebuilt with the new indentation chunk
+
+				const size_t indentCount = m_slabIndentCount;
+				const size_t alignCount = m_slabAlignCount;
+				m_slabIndentCount = 0;
+				m_slabAlignCount = 0;
+
+				ReserveIndentation(indentCount, alignCount);
+			}
+
+			ResetState();
+		}
+
+		/*!
+			Hand assembled output that was not written yet to
+			\ref WriteLines, including an incomplete line.
+		*/
+		inline void FlushLines()
+		{
+			if (m_assembledLines.empty())
+			{
+				return;
+			}
+
+			WriteLines(m_assembledLines);
+
+			m_assembledLines.clear();
+		}
+
 		/*!
 			Writes a new line chunk to the output.
 		*/
@@ -464,20 +742,210 @@ namespace panini
 			Write(m_config.chunkNewLine);
 		}
 
+		/*!
+			Writes pinned chunks to the output, copying them by default.
+		*/
+		void WritePinned(std::string_view chunk) override
+		{
+			Write(chunk);
+		}
+
+		/*!
+			Processes a chunk and passes the resulting output to a callable,
+			which is called with an `std::string_view` for every piece of
+			output, including indentation.
+
+			Derived writers can use this method to skip the virtual
+			\ref Write method when their target is known at compile time.
+		*/
+		template <typename TOutput>
+		inline void ProcessChunk(std::string_view chunk, TOutput&& output)
+		{
+			ProcessChunk(chunk, output, output);
+		}
+
+		/*!
+			Processes a chunk, passing indentation to the `output` callable and
+			the chunk itself to the `chunkOutput` callable.
+
+			\sa ProcessChunk
+		*/
+		template <typename TOutput, typename TChunkOutput>
+		inline void ProcessChunk(
+			std::string_view chunk,
+			TOutput&& output,
+			TChunkOutput&& chunkOutput)
+		{
+			if (m_state == State::NewLine)
+			{
+				OnLineStart();
+
+				m_state = State::Chunk;
+
+				// indentation and comment prefix are cached as one chunk
+
+				const std::string_view linePrefix = GetLinePrefix();
+				if (!linePrefix.empty())
+				{
+					output(linePrefix);
+				}
+			}
+
+			chunkOutput(chunk);
+
+			m_lineChunkCountWritten += chunk.size();
+		}
+
+		/*!
+			Processes a new line, passing output to the `output` callable and
+			calling `newLine` to write the new line chunk itself.
+
+			\sa ProcessChunk
+		*/
+		template <typename TOutput, typename TNewLine>
+		inline void ProcessNewLine(TOutput&& output, TNewLine&& newLine)
+		{
+			// edge-case for empty lines within a comment block
+
+			if (m_isInCommentBlock &&
+				m_lineChunkCountWritten == 0)
+			{
+				if (m_state == State::NewLine)
+				{
+					OnLineStart();
+				}
+
+				output(std::string_view(" *"));
+			}
+
+			newLine();
+
+			m_state = State::NewLine;
+
+			m_lineChunkCountWritten = 0;
+		}
+
 	protected:
 		TConfig m_config;
 
 	private:
 		/*!
-			Cache the indentation level to the target string.
+			Replace settings that are not allowed to inherit with defaults.
+		*/
+		inline void ResolveConfig()
+		{
+			if (m_config.braceBreakingStyle == BraceBreakingStyle::Inherit)
+			{
+				TConfig defaultConfig;
+				m_config.braceBreakingStyle = defaultConfig.braceBreakingStyle;
+			}
+
+			if (m_config.includeStyle == IncludeStyle::Inherit)
+			{
+				WriterConfig defaultConfig;
+				m_config.includeStyle = defaultConfig.includeStyle;
+			}
+		}
+
+		/*!
+			Make sure the slab holds at least `indentCount` indent chunks
+			followed by `alignCount` spaces. The slab at least doubles in size
+			when it grows.
+		*/
+		inline void ReserveIndentation(size_t indentCount, size_t alignCount)
+		{
+			if (indentCount <= m_slabIndentCount &&
+				alignCount <= m_slabAlignCount)
+			{
+				return;
+			}
+
+			m_slabIndentCount = std::max(indentCount, 2 * m_slabIndentCount);
+			m_slabAlignCount = std::max(alignCount, 2 * m_slabAlignCount);
+
+			std::string slab;
+			slab.reserve(m_slabIndentCount * m_config.chunkIndent.size() + m_slabAlignCount);
+
+			for (size_t i = 0; i < m_slabIndentCount; ++i)
+			{
+				slab += m_config.chunkIndent;
+			}
+
+			slab.append(m_slabAlignCount, ' ');
+
+			m_indentSlab = std::move(slab);
+		}
+
+		/*!
+			Get a view of `indentCount` indent chunks followed by `alignCount`
+			spaces from the slab.
 		*/
-		inline void CacheIndentation(std::string& target, int32_t count)
+		inline std::string_view GetIndentation(size_t indentCount, size_t alignCount) const
 		{
-			target.clear();
+			const size_t indentSize = indentCount * m_config.chunkIndent.size();
+			const size_t alignStart = m_slabIndentCount * m_config.chunkIndent.size();
+
+			return std::string_view(m_indentSlab).substr(alignStart - indentSize, indentSize + alignCount);
+		}
 
-			for (int32_t i = 0; i < count; ++i)
+		/*!
+			Get the indentation, alignment and comment prefix written at the
+			start of a line.
+
+			Outside of a comment block, the prefix is a view into the slab.
+		*/
+		inline std::string_view GetLinePrefix() const
+		{
+			if (!m_isInCommentBlock)
 			{
-				target += m_config.chunkIndent;
+				return GetIndentation(static_cast<size_t>(m_lineIndentCount), m_alignColumns);
+			}
+
+			return m_linePrefixCached;
+		}
+
+		/*!
+			Grow the slab for the current level of indentation and alignment,
+			and cache the line prefix for comment blocks.
+		*/
+		inline void CacheLinePrefix()
+		{
+			const size_t lineIndentCount = static_cast<size_t>(m_lineIndentCount);
+			const size_t commentIndentCount = static_cast<size_t>(m_commentIndentCount);
+
+			ReserveIndentation(std::max(lineIndentCount, commentIndentCount), m_alignColumns);
+
+			if (!m_isInCommentBlock)
+			{
+				return;
+			}
+
+			m_linePrefixCached.assign(GetIndentation(lineIndentCount, 0));
+			m_linePrefixCached += " * ";
+			m_linePrefixCached += GetIndentation(commentIndentCount, m_alignColumns);
+		}
+
+		/*!
+			Add output to the assembled lines, handing them over in the
+			middle of a line when the buffer is full.
+		*/
+		inline void AssembleChunk(std::string_view output)
+		{
+			// large chunks are handed over after the pending output
+
+			if (output.size() >= m_assemblyMaxSize)
+			{
+				FlushLines();
+				WriteLines(output);
+
+				return;
+			}
+
+			m_assembledLines.append(output);
+
+			if (m_assembledLines.size() >= m_assemblyMaxSize)
+			{
+				FlushLines();
 			}
 		}
 
@@ -485,7 +953,6 @@ namespace panini
 		size_t m_lineChunkCountWritten = 0;
 
 		int32_t m_lineIndentCount = 0;
-		std::string m_lineIndentCached;
 
 		enum class State
 		{
@@ -496,7 +963,20 @@ namespace panini
 
 		bool m_isInCommentBlock = false;
 		int32_t m_commentIndentCount = 0;
-		std::string m_commentIndentCached;
+
+		std::vector<uint32_t> m_alignments;
+		size_t m_alignColumns = 0;
+
+		std::string m_indentSlab;
+		size_t m_slabIndentCount = 0;
+		size_t m_slabAlignCount = 0;
+
+		std::string m_linePrefixCached;
+
+		bool m_isAssemblingLines = false;
+		size_t m_assemblyBatchSize = 0;
+		size_t m_assemblyMaxSize = SIZE_MAX;
+		std::string m_assembledLines;
 
 	};
 
@@ -0,0 +1,215 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace panini
+{
+
+	/*!
+		\brief Reuses writers for many outputs.
+
+		\ingroup Writers
+
+		Creating a writer for every output allocates its configuration,
+		indentation and output buffers again. A pool keeps writers that were
+		released and resets them to a new target when they are acquired, so
+		their memory is reused.
+
+		The arguments to \ref Acquire are passed to the constructor of a new
+		writer, or to the `Reset` method of a released one. Released writers
+		are detached from their target with their `Detach` method, so they
+		don't keep files open. Writers that support pooling are the
+		\ref StringWriter, \ref FileWriter and \ref CompareWriter.
+
+		\note A released writer forgets its manifest and dependency
+		database, so acquire it with a configuration to use them.
+
+		Pools are not thread-safe. Use \ref GetThreadLocal to get a pool for
+		the current thread.
+
+		Example:
+
+		\code{.cpp}
+			for (const Model& model : models)
+			{
+				CompareWriterConfig config;
+				config.filePath = model.GetHeaderPath();
+
+				auto writer = WriterPool<CompareWriter>::GetThreadLocal().Acquire(config);
+				model.WriteHeader(*writer);
+			}
+		\endcode
+	*/
+
+	template <typename TWriter>
+	class WriterPool
+	{
+
+	public:
+		/*!
+			\brief Writer borrowed from a pool.
+
+			The writer is committed, detached from its target and returned
+			to the pool when the lease is destroyed.
+		*/
+		class Lease
+		{
+
+		public:
+			inline Lease(WriterPool& pool, std::unique_ptr<TWriter>&& writer)
+				: m_pool(&pool)
+				, m_writer(std::move(writer))
+			{
+			}
+
+			inline Lease(Lease&& other) noexcept
+				: m_pool(std::exchange(other.m_pool, nullptr))
+				, m_writer(std::move(other.m_writer))
+			{
+			}
+
+			Lease(const Lease&) = delete;
+			Lease& operator = (const Lease&) = delete;
+			Lease& operator = (Lease&&) = delete;
+
+			inline ~Lease()
+			{
+				if (m_pool != nullptr &&
+					m_writer != nullptr)
+				{
+					m_writer->Commit();
+					m_writer->Detach();
+
+					m_pool->Release(std::move(m_writer));
+				}
+			}
+
+			inline TWriter& operator * () const
+			{
+				return *m_writer;
+			}
+
+			inline TWriter* operator -> () const
+			{
+				return m_writer.get();
+			}
+
+		private:
+			WriterPool* m_pool;
+			std::unique_ptr<TWriter> m_writer;
+
+		};
+
+		/*!
+			Construct a pool that keeps at most `maxReleased` writers that are
+			not in use.
+		*/
+		inline explicit WriterPool(size_t maxReleased = 4)
+			: m_maxReleased(maxReleased)
+		{
+			m_released.reserve(maxReleased);
+		}
+
+		WriterPool(const WriterPool&) = delete;
+		WriterPool& operator = (const WriterPool&) = delete;
+
+		/*!
+			Get the pool for the current thread, which is destroyed when the
+			thread exits.
+		*/
+		inline static WriterPool& GetThreadLocal()
+		{
+			thread_local WriterPool pool;
+
+			return pool;
+		}
+
+		/*!
+			Get a writer for a new output. A released writer is reset with
+			the arguments, otherwise a new writer is constructed with them.
+		*/
+		template <typename... TArgs>
+		inline Lease Acquire(TArgs&&... args)
+		{
+			if (!m_released.empty())
+			{
+				std::unique_ptr<TWriter> writer = std::move(m_released.back());
+				m_released.pop_back();
+
+				writer->Reset(std::forward<TArgs>(args)...);
+
+				m_reusedCount++;
+
+				return Lease(*this, std::move(writer));
+			}
+
+			m_createdCount++;
+
+			return Lease(*this, std::make_unique<TWriter>(std::forward<TArgs>(args)...));
+		}
+
+		/*!
+			Number of writers that are not in use.
+		*/
+		inline size_t GetReleasedCount() const
+		{
+			return m_released.size();
+		}
+
+		/*!
+			Number of writers that were constructed by the pool.
+		*/
+		inline size_t GetCreatedCount() const
+		{
+			return m_createdCount;
+		}
+
+		/*!
+			Number of times a released writer was reused.
+		*/
+		inline size_t GetReusedCount() const
+		{
+			return m_reusedCount;
+		}
+
+	private:
+		inline void Release(std::unique_ptr<TWriter>&& writer)
+		{
+			if (m_released.size() < m_maxReleased)
+			{
+				m_released.push_back(std::move(writer));
+			}
+		}
+
+	private:
+		size_t m_maxReleased;
+		std::vector<std::unique_ptr<TWriter>> m_released;
+		size_t m_createdCount = 0;
+		size_t m_reusedCount = 0;
+
+	};
+
+};
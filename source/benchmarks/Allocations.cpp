@@ -0,0 +1,81 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// replaces the global allocation functions to count heap allocations
+
+static std::atomic<size_t> s_AllocationCount{ 0 };
+
+void* operator new(size_t size)
+{
+	s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size > 0 ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	(void)size;
+
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t size) noexcept
+{
+	(void)size;
+
+	std::free(memory);
+}
+
+namespace panini::benchmarks
+{
+
+	size_t GetAllocationCount()
+	{
+		return s_AllocationCount.load(std::memory_order_relaxed);
+	}
+
+};
@@ -0,0 +1,73 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <stddef.h>
+
+namespace panini::benchmarks
+{
+
+	/*!
+		Get the number of heap allocations made by the program so far.
+	*/
+	size_t GetAllocationCount();
+
+	/*!
+		\brief Counts heap allocations made while a benchmark is running.
+
+		Construct the counter after setting up the benchmark and before the
+		timing loop, then call Report() when the loop has finished.
+	*/
+	class AllocationCounter
+	{
+
+	public:
+		inline explicit AllocationCounter(benchmark::State& state)
+			: m_state(state)
+			, m_start(GetAllocationCount())
+		{
+		}
+
+		/*!
+			Report allocations per operation, where each iteration of the
+			benchmark performs `operationsPerIteration` operations.
+		*/
+		inline void Report(size_t operationsPerIteration = 1)
+		{
+			const double allocations = static_cast<double>(GetAllocationCount() - m_start);
+			const double operations = static_cast<double>(operationsPerIteration);
+
+			m_state.counters["allocs/op"] = benchmark::Counter(
+				allocations / operations,
+				benchmark::Counter::kAvgIterations
+			);
+		}
+
+	private:
+		benchmark::State& m_state;
+		size_t m_start = 0;
+
+	};
+
+};
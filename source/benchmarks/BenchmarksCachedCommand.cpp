@@ -0,0 +1,150 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Generators.hpp"
+
+namespace
+{
+
+	// stands in for a custom command that does heavy work for its output
+
+	class HierarchyCommand
+		: public panini::Command
+	{
+
+	public:
+		HierarchyCommand(const std::vector<panini::benchmarks::HierarchyObject>& objects)
+			: m_objects(objects)
+		{
+		}
+
+		void Visit(panini::Writer& writer) override
+		{
+			panini::benchmarks::GenerateHierarchy(writer, m_objects);
+		}
+
+	private:
+		const std::vector<panini::benchmarks::HierarchyObject>& m_objects;
+
+	};
+
+};
+
+static void CachedCommandDirect(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << IndentPush() << HierarchyCommand(o) << IndentPop();
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(o.size());
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * t.size()));
+}
+BENCHMARK(CachedCommandDirect)->Arg(10)->Arg(100)->Arg(1000);
+
+static void CachedCommandHit(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	std::filesystem::path d = "benchmarks_cached_command";
+	std::filesystem::remove_all(d);
+
+	CommandCache c(d);
+
+	std::string t;
+
+	{
+		StringWriter w(t);
+		w << CachedCommand(c, 1, HierarchyCommand(o));
+	}
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << IndentPush() << CachedCommand(c, 1, HierarchyCommand(o)) << IndentPop();
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(o.size());
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * t.size()));
+
+	c.Clear();
+	std::filesystem::remove_all(d);
+}
+BENCHMARK(CachedCommandHit)->Arg(10)->Arg(100)->Arg(1000);
+
+static void CachedCommandMiss(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	std::filesystem::path d = "benchmarks_cached_command";
+	std::filesystem::remove_all(d);
+
+	CommandCache c(d);
+
+	std::string t;
+	uint64_t k = 0;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << IndentPush() << CachedCommand(c, ++k, HierarchyCommand(o)) << IndentPop();
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(o.size());
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * t.size()));
+
+	c.Clear();
+	std::filesystem::remove_all(d);
+}
+BENCHMARK(CachedCommandMiss)->Arg(10)->Arg(100)->Arg(1000);
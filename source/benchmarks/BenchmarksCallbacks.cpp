@@ -0,0 +1,134 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+
+static constexpr size_t s_NestingDepth = 10;
+
+// every level captures enough state to exceed the small buffer of
+// std::function, the scope names are short enough to stay in the small
+// string buffer
+
+struct NestingContext
+{
+	const char* className;
+	const char* functionName;
+	size_t memberCount;
+};
+
+static void NestStdFunction(panini::Writer& w, const NestingContext& context, size_t depth)
+{
+	using namespace panini;
+
+	if (depth == s_NestingDepth)
+	{
+		w << "return;" << NextLine();
+
+		return;
+	}
+
+	const char* name = (depth % 2 == 0) ? context.className : context.functionName;
+
+	w << Scope(name, [&context, depth, name](Writer& w) {
+		for (size_t i = 0; i < context.memberCount; ++i)
+		{
+			w << "int " << name << "_" << static_cast<char>('a' + i) << ";" << NextLine();
+		}
+
+		NestStdFunction(w, context, depth + 1);
+	}) << NextLine();
+}
+
+static void NestInline(panini::Writer& w, const NestingContext& context, size_t depth)
+{
+	using namespace panini;
+
+	if (depth == s_NestingDepth)
+	{
+		w << "return;" << NextLine();
+
+		return;
+	}
+
+	const char* name = (depth % 2 == 0) ? context.className : context.functionName;
+
+	w << MakeScope(name, [&context, depth, name](Writer& w) {
+		for (size_t i = 0; i < context.memberCount; ++i)
+		{
+			w << "int " << name << "_" << static_cast<char>('a' + i) << ";" << NextLine();
+		}
+
+		NestInline(w, context, depth + 1);
+	}) << NextLine();
+}
+
+static void CallbacksNestedStdFunction(benchmark::State& state)
+{
+	using namespace panini;
+
+	const NestingContext context{ "class Outer", "void Inner()", 4 };
+
+	std::string t;
+	t.reserve(64 * 1024);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		NestStdFunction(w, context, 0);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report();
+}
+BENCHMARK(CallbacksNestedStdFunction);
+
+static void CallbacksNestedInline(benchmark::State& state)
+{
+	using namespace panini;
+
+	const NestingContext context{ "class Outer", "void Inner()", 4 };
+
+	std::string t;
+	t.reserve(64 * 1024);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		NestInline(w, context, 0);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report();
+}
+BENCHMARK(CallbacksNestedInline);
@@ -0,0 +1,362 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+
+// each iteration writes this many chunks to the writer
+
+static constexpr size_t s_ChunksPerIteration = 64;
+
+static void ChunkLiteralShort(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << "#include ";
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkLiteralShort);
+
+static void ChunkLiteralLong(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << "static constexpr const char* s_Literal = ";
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkLiteralLong);
+
+static void ChunkString(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	const std::string chunk = "std::vector<std::string> m_parameters;";
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << chunk;
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkString);
+
+static void ChunkStringView(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	const std::string_view chunk = "GameObject* gameObject = new GameObject();";
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << chunk;
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkStringView);
+
+static void ChunkCharacter(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << ';';
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkCharacter);
+
+static void ChunkIndentedLines(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	w << IndentPush() << IndentPush();
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << "writer << \"long enough to skip the small string buffer\";" << NextLine();
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkIndentedLines);
+
+static void ChunkCommentBlockLines(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	w.SetIsInCommentBlock(true);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << "Comment blocks prefix every line with a chunk." << NextLine();
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkCommentBlockLines);
+
+// every line starts with indentation, the comment prefix and the comment
+// indentation
+
+static void ChunkIndentedCommentBlockLines(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	w << IndentPush() << IndentPush();
+	w.SetIsInCommentBlock(true);
+	w << IndentPush();
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << "Comment blocks prefix every line with a chunk." << NextLine();
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkIndentedCommentBlockLines);
+
+// the same lines written to a file, enough of them that opening the file
+// doesn't dominate
+
+static void ChunkIndentedCommentBlockLinesFile(benchmark::State& state)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "chunk_comment_lines.txt";
+
+	for (auto _ : state)
+	{
+		FileWriter w(c);
+
+		w << IndentPush() << IndentPush();
+		w.SetIsInCommentBlock(true);
+		w << IndentPush();
+
+		for (size_t i = 0; i < s_ChunksPerIteration * 256; ++i)
+		{
+			w << "Comment blocks prefix every line with a chunk." << NextLine();
+		}
+
+		w.Commit();
+	}
+
+	std::filesystem::remove(c.targetPath);
+
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration * 256);
+}
+BENCHMARK(ChunkIndentedCommentBlockLinesFile);
+
+// nesting reaches hundreds of levels, as in generated state machines
+
+static void ChunkDeepIndentation(benchmark::State& state)
+{
+	using namespace panini;
+
+	const int64_t depth = state.range(0);
+
+	std::string t;
+	t.reserve(static_cast<size_t>(depth * depth + depth * 16));
+	StringWriter w(t);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (int64_t i = 0; i < depth; ++i)
+		{
+			w << IndentPush() << "{" << NextLine();
+		}
+
+		for (int64_t i = 0; i < depth; ++i)
+		{
+			w << IndentPop() << "}" << NextLine();
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(static_cast<size_t>(depth * 2));
+	state.SetItemsProcessed(state.iterations() * depth * 2);
+}
+BENCHMARK(ChunkDeepIndentation)->Arg(16)->Arg(256);
+
+// labels pop and push the indentation
+
+static void ChunkLabels(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		w << IndentPush();
+	}
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_ChunksPerIteration; ++i)
+		{
+			w << Label("case State::Running") << NextLine();
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ChunksPerIteration);
+	state.SetItemsProcessed(state.iterations() * s_ChunksPerIteration);
+}
+BENCHMARK(ChunkLabels);
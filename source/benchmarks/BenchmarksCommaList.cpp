@@ -0,0 +1,166 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+
+static constexpr size_t s_ItemCount = 100000;
+
+// type-erased transform with std::to_string, like CommaList used before
+
+static void CommaListIntegersToString(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::vector<int32_t> s(s_ItemCount);
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		s[i] = static_cast<int32_t>(i * 7919);
+	}
+
+	using List = CommaList<std::vector<int32_t>::iterator>;
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << List(s.begin(), s.end(), CommaListOptions{}, [](Writer& writer, const int32_t& item, size_t) {
+			writer << std::to_string(item);
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ItemCount);
+	state.SetItemsProcessed(state.iterations() * s_ItemCount);
+}
+BENCHMARK(CommaListIntegersToString);
+
+static void CommaListIntegers(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::vector<int32_t> s(s_ItemCount);
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		s[i] = static_cast<int32_t>(i * 7919);
+	}
+
+	CommaListOptions o;
+	o.numberFormat = static_cast<NumberFormat>(state.range(0));
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << CommaList(s.begin(), s.end(), o);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ItemCount);
+	state.SetItemsProcessed(state.iterations() * s_ItemCount);
+}
+BENCHMARK(CommaListIntegers)
+	->ArgName("NumberFormat")
+	->Arg(static_cast<int64_t>(panini::NumberFormat::Default))
+	->Arg(static_cast<int64_t>(panini::NumberFormat::Hexadecimal));
+
+static void CommaListFloatsToString(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::vector<float> s(s_ItemCount);
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		s[i] = static_cast<float>(i) * 0.37f;
+	}
+
+	using List = CommaList<std::vector<float>::iterator>;
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << List(s.begin(), s.end(), CommaListOptions{}, [](Writer& writer, const float& item, size_t) {
+			writer << std::to_string(item);
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ItemCount);
+	state.SetItemsProcessed(state.iterations() * s_ItemCount);
+}
+BENCHMARK(CommaListFloatsToString);
+
+static void CommaListFloats(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::vector<float> s(s_ItemCount);
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		s[i] = static_cast<float>(i) * 0.37f;
+	}
+
+	CommaListOptions o;
+	o.numberFormat = static_cast<NumberFormat>(state.range(0));
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << CommaList(s.begin(), s.end(), o);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_ItemCount);
+	state.SetItemsProcessed(state.iterations() * s_ItemCount);
+}
+BENCHMARK(CommaListFloats)
+	->ArgName("NumberFormat")
+	->Arg(static_cast<int64_t>(panini::NumberFormat::Default))
+	->Arg(static_cast<int64_t>(panini::NumberFormat::Fixed))
+	->Arg(static_cast<int64_t>(panini::NumberFormat::Shortest));
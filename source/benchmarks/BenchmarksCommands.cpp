@@ -0,0 +1,194 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Counters.hpp"
+
+// each iteration visits this many commands
+
+static constexpr size_t s_CommandsPerIteration = 64;
+
+template <typename TBody>
+static void RunCommands(benchmark::State& state, TBody&& body)
+{
+	using namespace panini;
+
+	std::string t;
+	t.reserve(1024 * 1024);
+	StringWriter w(t);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		for (size_t i = 0; i < s_CommandsPerIteration; ++i)
+		{
+			body(w);
+		}
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(s_CommandsPerIteration);
+	benchmarks::ReportThroughput(state, [&body](Writer& writer) {
+		for (size_t i = 0; i < s_CommandsPerIteration; ++i)
+		{
+			body(writer);
+		}
+	});
+}
+
+static void CommandBraces(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << "if (isReady)" << Braces([](Writer& w) {
+			w << "return true;" << NextLine();
+		}) << NextLine();
+	});
+}
+BENCHMARK(CommandBraces);
+
+static void CommandScope(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << Scope("struct Vector2", [](Writer& w) {
+			w << "float x;" << NextLine();
+			w << "float y;" << NextLine();
+		}) << ";" << NextLine();
+	});
+}
+BENCHMARK(CommandScope);
+
+static void CommandCommentBlock(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << CommentBlock([](Writer& w) {
+			w << "Returns the length of the vector." << NextLine();
+			w << NextLine();
+			w << "\\param vector  Input vector." << NextLine();
+		}) << NextLine();
+	});
+}
+BENCHMARK(CommandCommentBlock);
+
+static void CommandCommentLine(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << CommentLine("generated code, do not modify") << NextLine();
+	});
+}
+BENCHMARK(CommandCommentLine);
+
+static void CommandFeatureFlag(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << FeatureFlag(true, "EXPERIMENTAL_RENDERER", [](Writer& w) {
+			w << "UseRenderer();" << NextLine();
+		}, [](Writer& w) {
+			w << "UseFallback();" << NextLine();
+		});
+	});
+}
+BENCHMARK(CommandFeatureFlag);
+
+static void CommandInclude(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << Include("vector", IncludeStyle::AngularBrackets) << NextLine();
+	});
+}
+BENCHMARK(CommandInclude);
+
+static void CommandIncludeBlock(benchmark::State& state)
+{
+	using namespace panini;
+
+	const IncludeSet s = {
+		{ "vector", IncludeStyle::AngularBrackets },
+		{ "string", IncludeStyle::AngularBrackets },
+		{ "Engine/Renderer.hpp", IncludeStyle::DoubleQuotes },
+		{ "Engine/Texture.hpp", IncludeStyle::DoubleQuotes },
+	};
+
+	RunCommands(state, [&s](Writer& w) {
+		w << IncludeBlock(s) << NextLine();
+	});
+}
+BENCHMARK(CommandIncludeBlock);
+
+static void CommandLabel(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << IndentPush() << Label("public") << NextLine() << IndentPop();
+	});
+}
+BENCHMARK(CommandLabel);
+
+static void CommandIndentPushPop(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << IndentPush() << "indented" << NextLine() << IndentPop();
+	});
+}
+BENCHMARK(CommandIndentPushPop);
+
+static void CommandNextLine(benchmark::State& state)
+{
+	using namespace panini;
+
+	RunCommands(state, [](Writer& w) {
+		w << "line" << NextLine();
+	});
+}
+BENCHMARK(CommandNextLine);
+
+static void CommandPinnedChunk(benchmark::State& state)
+{
+	using namespace panini;
+
+	static const std::string s_Chunk = "static constexpr const char* s_Literal = ";
+
+	RunCommands(state, [](Writer& w) {
+		w << PinnedChunk{ s_Chunk };
+	});
+}
+BENCHMARK(CommandPinnedChunk);
@@ -0,0 +1,158 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Generators.hpp"
+
+// generates the same output as the file on disk, so nothing is committed
+
+static void CompareWriterUnchanged(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t classCount = static_cast<size_t>(state.range(0));
+
+	CompareWriterConfig c;
+	c.filePath = "benchmark_compare_writer_unchanged.txt";
+
+	std::filesystem::remove(c.filePath);
+
+	{
+		CompareWriter w(c);
+		benchmarks::GenerateClasses(w, classCount);
+	}
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		CompareWriter w(c);
+		benchmarks::GenerateClasses(w, classCount);
+
+		if (w.IsChanged())
+		{
+			state.SkipWithError("Output should be unchanged.");
+		}
+	}
+
+	allocations.Report();
+	state.SetBytesProcessed(
+		state.iterations() * static_cast<int64_t>(std::filesystem::file_size(c.filePath)));
+
+	std::filesystem::remove(c.filePath);
+}
+BENCHMARK(CompareWriterUnchanged)->Arg(10)->Arg(10000);
+
+// same as above, but the manifest already knows the output on disk
+
+static void CompareWriterUnchangedManifest(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t classCount = static_cast<size_t>(state.range(0));
+
+	CompareWriterConfig c;
+	c.filePath = "benchmark_compare_writer_manifest.txt";
+
+	std::filesystem::remove(c.filePath);
+	std::filesystem::remove("benchmark_compare_writer_manifest.manifest");
+
+	{
+		OutputManifest m("benchmark_compare_writer_manifest.manifest");
+		c.manifest = &m;
+
+		CompareWriter w(c);
+		benchmarks::GenerateClasses(w, classCount);
+	}
+
+	// the output must be older than the saved manifest to be trusted
+
+	std::filesystem::last_write_time(
+		c.filePath,
+		std::filesystem::last_write_time(c.filePath) - std::chrono::seconds(10));
+
+	{
+		OutputManifest m("benchmark_compare_writer_manifest.manifest");
+		c.manifest = &m;
+
+		CompareWriter w(c);
+		benchmarks::GenerateClasses(w, classCount);
+	}
+
+	OutputManifest m("benchmark_compare_writer_manifest.manifest");
+	c.manifest = &m;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		CompareWriter w(c);
+		benchmarks::GenerateClasses(w, classCount);
+
+		if (w.IsChanged())
+		{
+			state.SkipWithError("Output should be unchanged.");
+		}
+	}
+
+	allocations.Report();
+	state.SetBytesProcessed(
+		state.iterations() * static_cast<int64_t>(std::filesystem::file_size(c.filePath)));
+
+	std::filesystem::remove(c.filePath);
+	std::filesystem::remove("benchmark_compare_writer_manifest.manifest");
+}
+BENCHMARK(CompareWriterUnchangedManifest)->Arg(10)->Arg(10000);
+
+// output differs from the file on disk from the middle onward
+
+static void CompareWriterChanged(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t classCount = static_cast<size_t>(state.range(0));
+
+	CompareWriterConfig c;
+	c.filePath = "benchmark_compare_writer_changed.txt";
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		{
+			std::filesystem::remove(c.filePath);
+
+			CompareWriter w(c);
+			benchmarks::GenerateClasses(w, classCount);
+		}
+		state.ResumeTiming();
+
+		CompareWriter w(c);
+		benchmarks::GenerateClasses(w, classCount / 2);
+		w << "// changed" << NextLine();
+		benchmarks::GenerateClasses(w, classCount / 2);
+	}
+
+	std::filesystem::remove(c.filePath);
+}
+BENCHMARK(CompareWriterChanged)->Arg(10)->Arg(10000);
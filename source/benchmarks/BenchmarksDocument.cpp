@@ -0,0 +1,154 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+static constexpr size_t s_ClassCount = 1000;
+
+// generator logic that builds strings, like most real generators
+
+static void GenerateScopes(panini::Writer& w)
+{
+	using namespace panini;
+
+	for (size_t i = 0; i < s_ClassCount; ++i)
+	{
+		w << Scope("class GameObject" + std::to_string(i), [i](Writer& w) {
+			w << IndentPop() << "public:" << IndentPush() << NextLine();
+
+			for (size_t member = 0; member < 8; ++member)
+			{
+				w << "int32_t m_member" + std::to_string(member) << " = " << std::to_string(i * member) << ";" << NextLine();
+			}
+		}) << ";" << NextLine();
+		w << NextLine();
+	}
+}
+
+// render the same output to two writers with a different configuration
+
+static void DocumentDualOutputDirect(benchmark::State& state)
+{
+	using namespace panini;
+
+	StringWriterConfig header;
+	header.braceBreakingStyle = BraceBreakingStyle::Allman;
+
+	StringWriterConfig fixture;
+	fixture.braceBreakingStyle = BraceBreakingStyle::Attach;
+	fixture.chunkIndent = "  ";
+
+	std::string t;
+	std::string u;
+
+	for (auto _ : state)
+	{
+		t.clear();
+		u.clear();
+
+		StringWriter w(t, header);
+		GenerateScopes(w);
+
+		StringWriter v(u, fixture);
+		GenerateScopes(v);
+
+		benchmark::DoNotOptimize(t.data());
+		benchmark::DoNotOptimize(u.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size() + u.size()));
+}
+BENCHMARK(DocumentDualOutputDirect);
+
+static void DocumentDualOutputRecorded(benchmark::State& state)
+{
+	using namespace panini;
+
+	StringWriterConfig header;
+	header.braceBreakingStyle = BraceBreakingStyle::Allman;
+
+	StringWriterConfig fixture;
+	fixture.braceBreakingStyle = BraceBreakingStyle::Attach;
+	fixture.chunkIndent = "  ";
+
+	std::string t;
+	std::string u;
+	Document d;
+
+	for (auto _ : state)
+	{
+		t.clear();
+		u.clear();
+
+		d.Clear();
+		d.Record(GenerateScopes);
+
+		StringWriter w(t, header);
+		d.Render(w);
+
+		StringWriter v(u, fixture);
+		d.Render(v);
+
+		benchmark::DoNotOptimize(t.data());
+		benchmark::DoNotOptimize(u.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size() + u.size()));
+}
+BENCHMARK(DocumentDualOutputRecorded);
+
+// cost of rendering a document that was already recorded
+
+static void DocumentRender(benchmark::State& state)
+{
+	using namespace panini;
+
+	Document d(GenerateScopes);
+
+	std::string t;
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		d.Render(w);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(DocumentRender);
+
+static void DocumentRecord(benchmark::State& state)
+{
+	using namespace panini;
+
+	for (auto _ : state)
+	{
+		Document d(GenerateScopes);
+
+		benchmark::DoNotOptimize(&d);
+	}
+}
+BENCHMARK(DocumentRecord);
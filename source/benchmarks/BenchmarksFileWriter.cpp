@@ -0,0 +1,123 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Generators.hpp"
+
+static void FileWriterMode(benchmark::State& state, panini::FileWriterMode mode)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "benchmark_file_writer_mode.txt";
+	c.mode = mode;
+
+	const size_t classCount = static_cast<size_t>(state.range(0));
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		FileWriter w(c);
+		benchmarks::GenerateClasses(w, classCount);
+	}
+
+	allocations.Report();
+	state.SetBytesProcessed(
+		state.iterations() * static_cast<int64_t>(std::filesystem::file_size(c.targetPath)));
+
+	std::filesystem::remove(c.targetPath);
+}
+BENCHMARK_CAPTURE(FileWriterMode, Commit, panini::FileWriterMode::Commit)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(FileWriterMode, Streaming, panini::FileWriterMode::Streaming)->Arg(1000)->Arg(100000);
+
+// exposes the number of bytes copied by the writer
+
+class InspectedFileWriter
+	: public panini::FileWriter
+{
+
+public:
+	using FileWriter::FileWriter;
+
+	// outside of scatter-gather mode, all output is copied to the buffer
+	// of assembled lines
+
+	size_t GetBytesCopied() const
+	{
+		return (m_config.mode == panini::FileWriterMode::ScatterGather)
+			? m_scatter.GetCopiedSize()
+			: static_cast<size_t>(std::filesystem::file_size(m_config.targetPath));
+	}
+
+};
+
+// output dominated by long strings that already exist in memory
+
+static void FileWriterLargeChunks(benchmark::State& state, panini::FileWriterMode mode)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "benchmark_file_writer_large_chunks.txt";
+	c.mode = mode;
+
+	static const std::string s_Template = [] {
+		std::string result;
+		for (size_t i = 0; result.size() < 64 * 1024; ++i)
+		{
+			result += "\tRegisterComponent<Component" + std::to_string(i) + ">();\n";
+		}
+		return result;
+	}();
+
+	const size_t outputSize = static_cast<size_t>(state.range(0)) * 1024 * 1024;
+	const size_t templateCount = outputSize / s_Template.size();
+
+	size_t bytesCopied = 0;
+
+	for (auto _ : state)
+	{
+		InspectedFileWriter w(c);
+
+		for (size_t i = 0; i < templateCount; ++i)
+		{
+			w << "// template " << std::to_string(i) << NextLine();
+			w << PinnedChunk{ s_Template };
+		}
+
+		w.Commit();
+		bytesCopied = w.GetBytesCopied();
+	}
+
+	state.counters["bytes_copied"] = static_cast<double>(bytesCopied);
+	state.SetBytesProcessed(
+		state.iterations() * static_cast<int64_t>(std::filesystem::file_size(c.targetPath)));
+
+	std::filesystem::remove(c.targetPath);
+}
+BENCHMARK_CAPTURE(FileWriterLargeChunks, Commit, panini::FileWriterMode::Commit)
+	->Arg(500)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(FileWriterLargeChunks, ScatterGather, panini::FileWriterMode::ScatterGather)
+	->Arg(500)->Iterations(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,133 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Generators.hpp"
+
+static constexpr size_t s_SectionCount = 64;
+static constexpr size_t s_ClassesPerSection = 100;
+
+// one large file, with every section written in order
+
+static void FragmentSectionsSerial(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << "namespace Game" << Braces([](Writer& writer) {
+			for (size_t i = 0; i < s_SectionCount; ++i)
+			{
+				benchmarks::GenerateClasses(writer, s_ClassesPerSection);
+			}
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(FragmentSectionsSerial)->UseRealTime();
+
+// sections rendered to fragments on a thread pool, then spliced in order
+
+static void FragmentSectionsParallel(benchmark::State& state)
+{
+	using namespace panini;
+
+	ThreadPool p(static_cast<size_t>(state.range(0)));
+	std::vector<Fragment> f(s_SectionCount);
+	std::string t;
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < s_SectionCount; ++i)
+		{
+			p.Submit([&f, i] {
+				f[i].Clear();
+
+				FragmentWriter w(f[i]);
+				benchmarks::GenerateClasses(w, s_ClassesPerSection);
+			});
+		}
+		p.Wait();
+
+		t.clear();
+
+		StringWriter w(t);
+		w << "namespace Game" << Braces([&f](Writer& writer) {
+			for (const Fragment& section : f)
+			{
+				writer << Splice(section);
+			}
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(FragmentSectionsParallel)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+// only the splicing, which is the part that can't run in parallel
+
+static void FragmentSplice(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::vector<Fragment> f(s_SectionCount);
+	for (Fragment& section : f)
+	{
+		FragmentWriter w(section);
+		benchmarks::GenerateClasses(w, s_ClassesPerSection);
+	}
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << "namespace Game" << Braces([&f](Writer& writer) {
+			for (const Fragment& section : f)
+			{
+				writer << Splice(section);
+			}
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report();
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(FragmentSplice);
@@ -0,0 +1,162 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Generators.hpp"
+
+#include <fstream>
+#include <thread>
+
+static constexpr size_t s_FileCount = 10000;
+static constexpr size_t s_ClassesPerFile = 20;
+
+static const std::filesystem::path s_JobsDirectory = "benchmark_generation_jobs";
+
+static void AddJobs(panini::GenerationJobs& jobs, size_t revision)
+{
+	using namespace panini;
+
+	for (size_t i = 0; i < s_FileCount; ++i)
+	{
+		jobs.Add(s_JobsDirectory / ("file" + std::to_string(i) + ".hpp"), [revision](Writer& w) {
+			w << "// revision " << std::to_string(revision) << NextLine();
+			benchmarks::GenerateClasses(w, s_ClassesPerFile);
+		});
+	}
+}
+
+// regenerating files that are up to date, the most common case for a build
+
+static void GenerationJobsUnchanged(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::filesystem::remove_all(s_JobsDirectory);
+	std::filesystem::create_directories(s_JobsDirectory);
+
+	ThreadPool p(static_cast<size_t>(state.range(0)));
+
+	GenerationJobs j;
+	AddJobs(j, 0);
+	j.Run(p);
+
+	for (auto _ : state)
+	{
+		j.Run(p);
+	}
+
+	if (j.GetResultCount(GenerationJobStatus::Unchanged) != s_FileCount)
+	{
+		state.SkipWithError("Expected all files to be unchanged.");
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_FileCount));
+}
+BENCHMARK(GenerationJobsUnchanged)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// every file is written on every iteration
+
+static void GenerationJobsChanged(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::filesystem::remove_all(s_JobsDirectory);
+	std::filesystem::create_directories(s_JobsDirectory);
+
+	ThreadPool p(static_cast<size_t>(state.range(0)));
+
+	size_t revision = 0;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		GenerationJobs j;
+		AddJobs(j, revision++);
+		state.ResumeTiming();
+
+		j.Run(p);
+
+		if (j.GetResultCount(GenerationJobStatus::Changed) != s_FileCount)
+		{
+			state.SkipWithError("Expected all files to be changed.");
+			break;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_FileCount));
+}
+BENCHMARK(GenerationJobsChanged)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// files that are up to date with their inputs are skipped without running
+// their generators
+
+static void GenerationJobsSkipped(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::filesystem::remove_all(s_JobsDirectory);
+	std::filesystem::create_directories(s_JobsDirectory);
+
+	const std::filesystem::path sharedInput = s_JobsDirectory / "shared.ini";
+	std::ofstream(sharedInput) << "[Shared]\n";
+
+	for (size_t i = 0; i < s_FileCount; ++i)
+	{
+		std::ofstream(s_JobsDirectory / ("input" + std::to_string(i) + ".ini")) << "[Object" << i << "]\n";
+	}
+
+	ThreadPool p(static_cast<size_t>(state.range(0)));
+
+	DependencyDatabase d(s_JobsDirectory / "dependencies.txt", "1");
+
+	CompareWriterConfig c;
+	c.dependencies = &d;
+	c.inputs = { sharedInput };
+
+	GenerationJobs j(c);
+	for (size_t i = 0; i < s_FileCount; ++i)
+	{
+		j.Add(s_JobsDirectory / ("file" + std::to_string(i) + ".hpp"), { s_JobsDirectory / ("input" + std::to_string(i) + ".ini") }, [](Writer& w) {
+			benchmarks::GenerateClasses(w, s_ClassesPerFile);
+		});
+	}
+	j.Run(p);
+
+	// inputs are only trusted when they were modified before the database was saved
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	d.Save();
+
+	for (auto _ : state)
+	{
+		j.Run(p);
+	}
+
+	if (j.GetResultCount(GenerationJobStatus::Skipped) != s_FileCount)
+	{
+		state.SkipWithError("Expected all files to be skipped.");
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_FileCount));
+}
+BENCHMARK(GenerationJobsSkipped)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,118 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include <string.h>
+
+#include "Allocations.hpp"
+#include "Generators.hpp"
+
+static constexpr size_t s_ClassCount = 10000;
+
+// generated code, where most chunks are only a few bytes long
+
+static void HashWriterClasses(benchmark::State& state)
+{
+	using namespace panini;
+
+	uint64_t byteCount = 0;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		HashWriter w;
+		benchmarks::GenerateClasses(w, s_ClassCount);
+
+		benchmark::DoNotOptimize(w.GetDigest());
+		byteCount = w.GetByteCount();
+	}
+
+	allocations.Report();
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(byteCount));
+}
+BENCHMARK(HashWriterClasses);
+
+static void StringWriterClasses(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		benchmarks::GenerateClasses(w, s_ClassCount);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report();
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(StringWriterClasses);
+
+// large chunks, to compare against memory bandwidth
+
+static void HashWriterLargeChunks(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::string chunk(static_cast<size_t>(state.range(0)), 'x');
+
+	for (auto _ : state)
+	{
+		HashWriter w;
+		for (size_t i = 0; i < 256; ++i)
+		{
+			w << std::string_view(chunk);
+		}
+
+		benchmark::DoNotOptimize(w.GetDigest());
+	}
+
+	state.SetBytesProcessed(state.iterations() * 256 * state.range(0));
+}
+BENCHMARK(HashWriterLargeChunks)->Arg(64)->Arg(4 * 1024)->Arg(64 * 1024);
+
+static void MemoryCopyLargeChunks(benchmark::State& state)
+{
+	const std::string chunk(static_cast<size_t>(state.range(0)), 'x');
+	std::string t(chunk.size(), '\0');
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < 256; ++i)
+		{
+			::memcpy(t.data(), chunk.data(), chunk.size());
+			benchmark::ClobberMemory();
+		}
+	}
+
+	state.SetBytesProcessed(state.iterations() * 256 * state.range(0));
+}
+BENCHMARK(MemoryCopyLargeChunks)->Arg(64)->Arg(4 * 1024)->Arg(64 * 1024);
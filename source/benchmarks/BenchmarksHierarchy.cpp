@@ -0,0 +1,114 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Counters.hpp"
+#include "Generators.hpp"
+
+// scaled-up version of the DataDrivenHierarchy example, with thousands of
+// game objects in a single file
+
+static void HierarchyStringWriter(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		benchmarks::GenerateHierarchy(w, o);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(o.size());
+	benchmarks::ReportThroughput(state, [&o](Writer& w) {
+		benchmarks::GenerateHierarchy(w, o);
+	});
+}
+BENCHMARK(HierarchyStringWriter)->Arg(1000)->Arg(10000);
+
+static void HierarchyHashWriter(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		HashWriter w;
+		benchmarks::GenerateHierarchy(w, o);
+
+		benchmark::DoNotOptimize(w.GetDigest());
+	}
+
+	allocations.Report(o.size());
+	benchmarks::ReportThroughput(state, [&o](Writer& w) {
+		benchmarks::GenerateHierarchy(w, o);
+	});
+}
+BENCHMARK(HierarchyHashWriter)->Arg(1000)->Arg(10000);
+
+// the output already exists on disk and does not change
+
+static void HierarchyCompareWriter(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	CompareWriterConfig c;
+	c.filePath = "benchmark_hierarchy.cpp";
+	std::filesystem::remove(c.filePath);
+
+	{
+		CompareWriter w(c);
+		benchmarks::GenerateHierarchy(w, o);
+	}
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		CompareWriter w(c);
+		benchmarks::GenerateHierarchy(w, o);
+
+		benchmark::DoNotOptimize(w.IsChanged());
+	}
+
+	allocations.Report(o.size());
+	benchmarks::ReportThroughput(state, [&o](Writer& w) {
+		benchmarks::GenerateHierarchy(w, o);
+	});
+}
+BENCHMARK(HierarchyCompareWriter)->Arg(1000)->Arg(10000);
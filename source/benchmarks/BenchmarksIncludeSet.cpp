@@ -0,0 +1,207 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+
+static std::vector<std::filesystem::path> MakeIncludePaths(size_t count)
+{
+	std::vector<std::filesystem::path> paths;
+	paths.reserve(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		paths.emplace_back("Engine/Components/Component" + std::to_string(i) + ".hpp");
+	}
+
+	return paths;
+}
+
+// every path is new
+
+static void IncludeSetAddUnique(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<std::filesystem::path> p = MakeIncludePaths(static_cast<size_t>(state.range(0)));
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		IncludeSet s;
+
+		for (const std::filesystem::path& path : p)
+		{
+			s.Add(path, IncludeStyle::DoubleQuotes);
+		}
+
+		benchmark::DoNotOptimize(s.begin());
+	}
+
+	allocations.Report(p.size());
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(p.size()));
+}
+BENCHMARK(IncludeSetAddUnique)->Arg(16)->Arg(256)->Arg(1024)->Arg(10000);
+
+// every path is added four times, as when collecting includes from many
+// generated types that share dependencies
+
+static void IncludeSetAddDuplicates(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<std::filesystem::path> p = MakeIncludePaths(static_cast<size_t>(state.range(0)));
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		IncludeSet s;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			for (const std::filesystem::path& path : p)
+			{
+				s.Add(path, IncludeStyle::DoubleQuotes);
+			}
+		}
+
+		benchmark::DoNotOptimize(s.begin());
+	}
+
+	allocations.Report(p.size() * 4);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(p.size() * 4));
+}
+BENCHMARK(IncludeSetAddDuplicates)->Arg(16)->Arg(256)->Arg(1024)->Arg(10000);
+
+// paths at different depths, added in reverse order so the set has to be
+// reordered when it is sorted
+
+static panini::IncludeSet MakeUnsortedIncludeSet(size_t count)
+{
+	using namespace panini;
+
+	IncludeSet s;
+
+	for (size_t i = count; i > 0; --i)
+	{
+		std::string path = "Component" + std::to_string(i) + ".hpp";
+		for (size_t j = 0; j < i % 4; ++j)
+		{
+			path = "Folder" + std::to_string(j) + "/" + path;
+		}
+
+		s.Add(path, (i % 3 == 0) ? IncludeStyle::AngularBrackets : IncludeStyle::Inherit);
+	}
+
+	return s;
+}
+
+// sort a copy of an unsorted set, the copy is not measured
+
+static void IncludeSetSort(benchmark::State& state)
+{
+	using namespace panini;
+
+	const IncludeSet u = MakeUnsortedIncludeSet(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		IncludeSet s = u;
+		state.ResumeTiming();
+
+		s.Sort(IncludeStyle::DoubleQuotes);
+
+		benchmark::DoNotOptimize(s.GetEntries().data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(IncludeSetSort)->Arg(1024)->Arg(10000);
+
+// visit the same block repeatedly, as when the same includes are written to
+// several outputs
+
+static void IncludeBlockVisit(benchmark::State& state)
+{
+	using namespace panini;
+
+	IncludeBlock b(MakeUnsortedIncludeSet(static_cast<size_t>(state.range(0))));
+
+	std::string t;
+	t.reserve(static_cast<size_t>(state.range(0)) * 64);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		b.Visit(w);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(IncludeBlockVisit)->Arg(1024)->Arg(10000);
+
+// many files that include the same headers, written with and without
+// interning the paths in a shared pool
+
+static void IncludeSetSharedHeaders(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<std::filesystem::path> p = MakeIncludePaths(200);
+	const bool pooled = state.range(0) != 0;
+
+	IncludePathPool pool;
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		IncludeSet s = pooled ? IncludeSet(pool) : IncludeSet();
+
+		for (const std::filesystem::path& path : p)
+		{
+			s.Add(path, IncludeStyle::DoubleQuotes);
+		}
+
+		t.clear();
+
+		StringWriter w(t);
+		w << IncludeBlock(std::move(s));
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report();
+	state.SetLabel(pooled ? "pooled" : "copied");
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(p.size()));
+}
+BENCHMARK(IncludeSetSharedHeaders)->Arg(0)->Arg(1);
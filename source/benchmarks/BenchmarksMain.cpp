@@ -0,0 +1,324 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Besides the flags of Google Benchmark, two flags are supported for
+// comparing local runs:
+//
+//   --panini_save_baseline=<path>  Store the results of this run.
+//   --panini_compare=<path>        Compare the results against a stored run.
+//
+// The baseline is a text file with a line for every benchmark, containing
+// its name, the real time per iteration in nanoseconds and its counters.
+
+namespace
+{
+
+	struct BaselineResult
+	{
+		double realTime = 0.0;
+		std::map<std::string, double> counters;
+	};
+
+	using BaselineResults = std::map<std::string, BaselineResult>;
+
+	bool LoadBaseline(const std::string& path, BaselineResults& results)
+	{
+		std::ifstream stream(path);
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			std::istringstream fields(line);
+
+			std::string name;
+			BaselineResult result;
+			if (!std::getline(fields, name, '\t') ||
+				!(fields >> result.realTime))
+			{
+				continue;
+			}
+
+			std::string counter;
+			while (fields >> counter)
+			{
+				const size_t separator = counter.rfind('=');
+				if (separator != std::string::npos)
+				{
+					result.counters[counter.substr(0, separator)] = std::stod(counter.substr(separator + 1));
+				}
+			}
+
+			results[name] = std::move(result);
+		}
+
+		return true;
+	}
+
+	bool SaveBaseline(const std::string& path, const BaselineResults& results)
+	{
+		std::ofstream stream(path);
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		stream << std::setprecision(17);
+
+		for (const auto& [name, result] : results)
+		{
+			stream << name << '\t' << result.realTime;
+
+			for (const auto& [counter, value] : result.counters)
+			{
+				stream << ' ' << counter << '=' << value;
+			}
+
+			stream << '\n';
+		}
+
+		return stream.good();
+	}
+
+	/*
+		Console reporter that collects the results, to store them or compare
+		them against a baseline when all benchmarks have run.
+	*/
+	class BaselineReporter
+		: public benchmark::ConsoleReporter
+	{
+
+	public:
+		BaselineReporter(std::string savePath, std::string comparePath)
+			: benchmark::ConsoleReporter(benchmark::ConsoleReporter::OO_None)
+			, m_savePath(std::move(savePath))
+			, m_comparePath(std::move(comparePath))
+		{
+		}
+
+		void ReportRuns(const std::vector<Run>& reports) override
+		{
+			benchmark::ConsoleReporter::ReportRuns(reports);
+
+			for (const Run& run : reports)
+			{
+				if (run.error_occurred ||
+					run.iterations == 0)
+				{
+					continue;
+				}
+
+				BaselineResult& result = m_results[run.benchmark_name()];
+				result.realTime = run.real_accumulated_time * 1e9 / static_cast<double>(run.iterations);
+
+				for (const auto& [counter, value] : run.counters)
+				{
+					result.counters[counter] = value.value;
+				}
+			}
+		}
+
+		void Finalize() override
+		{
+			benchmark::ConsoleReporter::Finalize();
+
+			std::ostream& output = GetOutputStream();
+
+			if (!m_comparePath.empty())
+			{
+				Compare(output);
+			}
+
+			if (!m_savePath.empty())
+			{
+				if (SaveBaseline(m_savePath, m_results))
+				{
+					output << "Saved baseline to \"" << m_savePath << "\"." << std::endl;
+				}
+				else
+				{
+					GetErrorStream() << "Failed to save baseline to \"" << m_savePath << "\"." << std::endl;
+				}
+			}
+		}
+
+	private:
+		void Compare(std::ostream& output) const
+		{
+			BaselineResults baseline;
+			if (!LoadBaseline(m_comparePath, baseline))
+			{
+				GetErrorStream() << "Failed to load baseline from \"" << m_comparePath << "\"." << std::endl;
+
+				return;
+			}
+
+			size_t nameWidth = 10;
+			for (const auto& [name, result] : m_results)
+			{
+				nameWidth = std::max(nameWidth, name.size());
+			}
+
+			output << std::endl << "Comparison with \"" << m_comparePath << "\":" << std::endl;
+			output << std::left << std::setw(static_cast<int>(nameWidth)) << "Benchmark"
+				<< std::right
+				<< std::setw(16) << "Baseline ns"
+				<< std::setw(16) << "Current ns"
+				<< std::setw(10) << "Change"
+				<< std::setw(24) << "allocs/op" << std::endl;
+			output << std::string(nameWidth + 66, '-') << std::endl;
+
+			for (const auto& [name, result] : m_results)
+			{
+				output << std::left << std::setw(static_cast<int>(nameWidth)) << name << std::right;
+
+				auto found = baseline.find(name);
+				if (found == baseline.end())
+				{
+					output << std::setw(16) << "-"
+						<< std::fixed << std::setprecision(0)
+						<< std::setw(16) << result.realTime
+						<< std::setw(10) << "new" << std::endl;
+
+					continue;
+				}
+
+				const BaselineResult& previous = found->second;
+				const double change = (previous.realTime > 0.0)
+					? (result.realTime / previous.realTime - 1.0) * 100.0
+					: 0.0;
+
+				std::ostringstream changeText;
+				changeText << std::showpos << std::fixed << std::setprecision(1) << change << '%';
+
+				output << std::fixed << std::setprecision(0)
+					<< std::setw(16) << previous.realTime
+					<< std::setw(16) << result.realTime
+					<< std::setw(10) << changeText.str();
+
+				auto allocations = result.counters.find("allocs/op");
+				auto previousAllocations = previous.counters.find("allocs/op");
+				if (allocations != result.counters.end() &&
+					previousAllocations != previous.counters.end())
+				{
+					std::ostringstream allocationsText;
+					allocationsText << std::setprecision(3) << previousAllocations->second << " -> " << allocations->second;
+
+					output << std::setw(24) << allocationsText.str();
+				}
+
+				output << std::endl;
+			}
+
+			for (const auto& [name, result] : baseline)
+			{
+				if (m_results.find(name) == m_results.end())
+				{
+					output << std::left << std::setw(static_cast<int>(nameWidth)) << name << std::right
+						<< std::fixed << std::setprecision(0)
+						<< std::setw(16) << result.realTime
+						<< std::setw(16) << "-"
+						<< std::setw(10) << "not run" << std::endl;
+				}
+			}
+		}
+
+	private:
+		std::string m_savePath;
+		std::string m_comparePath;
+		BaselineResults m_results;
+
+	};
+
+	// removes a flag from the arguments and returns its value
+
+	bool TakeFlag(int& argc, char** argv, std::string_view flag, std::string& value)
+	{
+		bool found = false;
+
+		for (int i = 1; i < argc;)
+		{
+			std::string_view argument(argv[i]);
+
+			if (argument.size() > flag.size() &&
+				argument.substr(0, flag.size()) == flag &&
+				argument[flag.size()] == '=')
+			{
+				value = std::string(argument.substr(flag.size() + 1));
+				found = true;
+
+				for (int j = i; j < argc - 1; ++j)
+				{
+					argv[j] = argv[j + 1];
+				}
+				argc--;
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		return found;
+	}
+
+};
+
+int main(int argc, char** argv)
+{
+	std::string savePath;
+	std::string comparePath;
+	const bool isSaving = TakeFlag(argc, argv, "--panini_save_baseline", savePath);
+	const bool isComparing = TakeFlag(argc, argv, "--panini_compare", comparePath);
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+	{
+		return 1;
+	}
+
+	if (isSaving || isComparing)
+	{
+		BaselineReporter reporter(savePath, comparePath);
+		benchmark::RunSpecifiedBenchmarks(&reporter);
+	}
+	else
+	{
+		benchmark::RunSpecifiedBenchmarks();
+	}
+
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+static constexpr size_t s_TableCount = 20000;
+
+static const std::vector<std::string>& GetTableNames()
+{
+	static std::vector<std::string> s_Names;
+
+	if (s_Names.empty())
+	{
+		for (size_t i = 0; i < s_TableCount; ++i)
+		{
+			s_Names.push_back("Table" + std::to_string(i));
+		}
+	}
+
+	return s_Names;
+}
+
+static void GenerateTable(panini::Writer& writer, const std::string& name, size_t index)
+{
+	using namespace panini;
+
+	static const char* s_ColumnNames[] = {
+		"id", "name", "created", "modified", "owner", "flags"
+	};
+
+	writer << Scope("struct " + name, [index](Writer& writer) {
+		writer << "static constexpr uint32_t Index = " << std::to_string(index) << ";" << NextLine();
+
+		for (const char* column : s_ColumnNames)
+		{
+			writer << "Column<" << column << "> m_" << column << ";" << NextLine();
+		}
+	}) << ";" << NextLine();
+}
+
+// every table written on the calling thread
+
+static void ParallelForEachSerial(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<std::string>& n = GetTableNames();
+
+	std::string t;
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << "namespace Schema" << Braces([&n](Writer& writer) {
+			for (size_t i = 0; i < n.size(); ++i)
+			{
+				GenerateTable(writer, n[i], i);
+			}
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_TableCount));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(ParallelForEachSerial)->UseRealTime();
+
+static void ParallelForEachThreads(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<std::string>& n = GetTableNames();
+
+	ThreadPool p(static_cast<size_t>(state.range(0)));
+
+	ParallelForEachOptions o;
+	o.pool = &p;
+
+	std::string t;
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		w << "namespace Schema" << Braces([&n, &o](Writer& writer) {
+			writer << ParallelForEach(n.begin(), n.end(), [](Writer& writer, const std::string& name, size_t index) {
+				GenerateTable(writer, name, index);
+			}, o);
+		});
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s_TableCount));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(ParallelForEachThreads)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
@@ -0,0 +1,57 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Counters.hpp"
+#include "Generators.hpp"
+
+// same workload as HierarchyStringWriter, to measure the cost of profiling
+
+static void ProfilingWriterHierarchy(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	std::string t;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter s(t);
+		ProfilingWriter w(s);
+		benchmarks::GenerateHierarchy(w, o);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(o.size());
+	benchmarks::ReportThroughput(state, [&o](Writer& w) {
+		benchmarks::GenerateHierarchy(w, o);
+	});
+}
+BENCHMARK(ProfilingWriterHierarchy)->Arg(1000)->Arg(10000);
@@ -0,0 +1,106 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Generators.hpp"
+
+static constexpr size_t s_ClassCount = 10000;
+
+static void SinkWriterString(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		SinkWriter w(StringSink{ t });
+		benchmarks::GenerateClasses(w, s_ClassCount);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(SinkWriterString);
+
+static void StringWriterString(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string t;
+
+	for (auto _ : state)
+	{
+		t.clear();
+
+		StringWriter w(t);
+		benchmarks::GenerateClasses(w, s_ClassCount);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(t.size()));
+}
+BENCHMARK(StringWriterString);
+
+static void SinkWriterFile(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::filesystem::path p = "benchmark_sink_writer.txt";
+
+	for (auto _ : state)
+	{
+		SinkWriter w(FileDescriptorSink{ p });
+		benchmarks::GenerateClasses(w, s_ClassCount);
+	}
+
+	state.SetBytesProcessed(
+		state.iterations() * static_cast<int64_t>(std::filesystem::file_size(p)));
+
+	std::filesystem::remove(p);
+}
+BENCHMARK(SinkWriterFile);
+
+static void FileWriterFile(benchmark::State& state)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "benchmark_file_writer.txt";
+
+	for (auto _ : state)
+	{
+		FileWriter w(c);
+		benchmarks::GenerateClasses(w, s_ClassCount);
+	}
+
+	state.SetBytesProcessed(
+		state.iterations() * static_cast<int64_t>(std::filesystem::file_size(c.targetPath)));
+
+	std::filesystem::remove(c.targetPath);
+}
+BENCHMARK(FileWriterFile);
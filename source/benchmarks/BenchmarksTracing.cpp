@@ -0,0 +1,68 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Counters.hpp"
+#include "Generators.hpp"
+
+// same workload as HierarchyStringWriter, with a recorder started
+// the hooks are only compiled when PANINI_ENABLE_TRACING is enabled, otherwise
+// this measures that starting a recorder has no cost
+
+static void TracingHierarchy(benchmark::State& state)
+{
+	using namespace panini;
+
+	const std::vector<benchmarks::HierarchyObject> o = benchmarks::MakeHierarchy(static_cast<size_t>(state.range(0)));
+
+	std::string t;
+
+	TraceRecorder r;
+	r.SetMaxCommandDepth(static_cast<uint32_t>(state.range(1)));
+	r.Start();
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		t.clear();
+		r.Clear();
+
+		StringWriter w(t);
+		benchmarks::GenerateHierarchy(w, o);
+
+		benchmark::DoNotOptimize(t.data());
+	}
+
+	allocations.Report(o.size());
+
+	r.Stop();
+
+	state.counters["events"] = static_cast<double>(r.GetEventCount());
+
+	benchmarks::ReportThroughput(state, [&o](Writer& w) {
+		benchmarks::GenerateHierarchy(w, o);
+	});
+}
+BENCHMARK(TracingHierarchy)->Args({ 1000, 0 })->Args({ 1000, 1 })->Args({ 10000, 0 })->Args({ 10000, 1 });
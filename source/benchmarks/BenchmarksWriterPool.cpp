@@ -0,0 +1,230 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Generators.hpp"
+
+// many small files that are unchanged on disk, each with its own writer
+
+static void WriterPoolCompareFresh(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t fileCount = static_cast<size_t>(state.range(0));
+
+	std::vector<CompareWriterConfig> configs(fileCount);
+	for (size_t i = 0; i < fileCount; ++i)
+	{
+		configs[i].filePath = "benchmark_writer_pool_" + std::to_string(i) + ".txt";
+
+		CompareWriter w(configs[i]);
+		benchmarks::GenerateClasses(w, 2);
+	}
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		for (const CompareWriterConfig& c : configs)
+		{
+			CompareWriter w(c);
+			benchmarks::GenerateClasses(w, 2);
+		}
+	}
+
+	allocations.Report();
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(fileCount));
+
+	for (const CompareWriterConfig& c : configs)
+	{
+		std::filesystem::remove(c.filePath);
+	}
+}
+BENCHMARK(WriterPoolCompareFresh)->Arg(64);
+
+// same as above, but the writers are reused from a pool
+
+static void WriterPoolComparePooled(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t fileCount = static_cast<size_t>(state.range(0));
+
+	std::vector<CompareWriterConfig> configs(fileCount);
+	for (size_t i = 0; i < fileCount; ++i)
+	{
+		configs[i].filePath = "benchmark_writer_pool_" + std::to_string(i) + ".txt";
+
+		CompareWriter w(configs[i]);
+		benchmarks::GenerateClasses(w, 2);
+	}
+
+	WriterPool<CompareWriter> pool;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		for (const CompareWriterConfig& c : configs)
+		{
+			auto w = pool.Acquire(c);
+			benchmarks::GenerateClasses(*w, 2);
+		}
+	}
+
+	allocations.Report();
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(fileCount));
+
+	for (const CompareWriterConfig& c : configs)
+	{
+		std::filesystem::remove(c.filePath);
+	}
+}
+BENCHMARK(WriterPoolComparePooled)->Arg(64);
+
+// many small files written in FileWriterMode::ScatterGather mode, each with
+// its own writer
+
+static void WriterPoolScatterGatherFresh(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t fileCount = static_cast<size_t>(state.range(0));
+
+	std::vector<FileWriterConfig> configs(fileCount);
+	for (size_t i = 0; i < fileCount; ++i)
+	{
+		configs[i].targetPath = "benchmark_writer_pool_scatter_" + std::to_string(i) + ".txt";
+		configs[i].mode = FileWriterMode::ScatterGather;
+		configs[i].bufferSize = 4096;
+	}
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		for (const FileWriterConfig& c : configs)
+		{
+			FileWriter w(c);
+			benchmarks::GenerateClasses(w, 2);
+		}
+	}
+
+	allocations.Report();
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(fileCount));
+
+	for (const FileWriterConfig& c : configs)
+	{
+		std::filesystem::remove(c.targetPath);
+	}
+}
+BENCHMARK(WriterPoolScatterGatherFresh)->Arg(64);
+
+// same as above, but the writers are reused from a pool
+
+static void WriterPoolScatterGatherPooled(benchmark::State& state)
+{
+	using namespace panini;
+
+	const size_t fileCount = static_cast<size_t>(state.range(0));
+
+	std::vector<FileWriterConfig> configs(fileCount);
+	for (size_t i = 0; i < fileCount; ++i)
+	{
+		configs[i].targetPath = "benchmark_writer_pool_scatter_" + std::to_string(i) + ".txt";
+		configs[i].mode = FileWriterMode::ScatterGather;
+		configs[i].bufferSize = 4096;
+	}
+
+	WriterPool<FileWriter> pool;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		for (const FileWriterConfig& c : configs)
+		{
+			auto w = pool.Acquire(c);
+			benchmarks::GenerateClasses(*w, 2);
+		}
+	}
+
+	allocations.Report();
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(fileCount));
+
+	for (const FileWriterConfig& c : configs)
+	{
+		std::filesystem::remove(c.targetPath);
+	}
+}
+BENCHMARK(WriterPoolScatterGatherPooled)->Arg(64);
+
+// writing many strings with a fresh writer each
+
+static void WriterPoolStringFresh(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string output;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		output.clear();
+
+		StringWriter w(output);
+		benchmarks::GenerateClasses(w, 2);
+
+		benchmark::DoNotOptimize(output.data());
+	}
+
+	allocations.Report();
+}
+BENCHMARK(WriterPoolStringFresh);
+
+// same as above, but the writer is reused from a pool
+
+static void WriterPoolStringPooled(benchmark::State& state)
+{
+	using namespace panini;
+
+	std::string output;
+	WriterPool<StringWriter> pool;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		output.clear();
+
+		auto w = pool.Acquire(output);
+		benchmarks::GenerateClasses(*w, 2);
+
+		benchmark::DoNotOptimize(output.data());
+	}
+
+	allocations.Report();
+}
+BENCHMARK(WriterPoolStringPooled);
@@ -0,0 +1,100 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include "Allocations.hpp"
+#include "Counters.hpp"
+#include "Generators.hpp"
+
+// writers that are not measured elsewhere, with the same workload as
+// StringWriterClasses and HashWriterClasses
+
+// the DebugWriter is not measured, because it halts execution on every line
+
+static constexpr size_t s_ClassCount = 10000;
+
+// stream buffer that drops all output, so only the writer is measured
+
+class NullStreamBuffer
+	: public std::streambuf
+{
+
+protected:
+	std::streamsize xsputn(const char*, std::streamsize count) override
+	{
+		return count;
+	}
+
+	int overflow(int character) override
+	{
+		return traits_type::not_eof(character);
+	}
+
+};
+
+static void ConsoleWriterClasses(benchmark::State& state)
+{
+	using namespace panini;
+
+	NullStreamBuffer b;
+	std::ostream s(&b);
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		ConsoleWriter w(s);
+		benchmarks::GenerateClasses(w, s_ClassCount);
+	}
+
+	allocations.Report();
+	benchmarks::ReportThroughput(state, [](Writer& w) {
+		benchmarks::GenerateClasses(w, s_ClassCount);
+	});
+}
+BENCHMARK(ConsoleWriterClasses);
+
+static void FragmentWriterClasses(benchmark::State& state)
+{
+	using namespace panini;
+
+	Fragment f;
+
+	benchmarks::AllocationCounter allocations(state);
+
+	for (auto _ : state)
+	{
+		f.Clear();
+
+		FragmentWriter w(f);
+		benchmarks::GenerateClasses(w, s_ClassCount);
+
+		benchmark::DoNotOptimize(f.GetTextSize());
+	}
+
+	allocations.Report();
+	benchmarks::ReportThroughput(state, [](Writer& w) {
+		benchmarks::GenerateClasses(w, s_ClassCount);
+	});
+}
+BENCHMARK(FragmentWriterClasses);
@@ -0,0 +1,114 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <Panini.hpp>
+
+#include <stddef.h>
+
+namespace panini::benchmarks
+{
+
+	/*!
+		\brief Writer that counts the chunks and bytes it receives, without
+		storing them.
+
+		Run the body of a benchmark through the counter once before the
+		timing loop to find out how many chunks each iteration writes.
+	*/
+	class ChunkCounter
+		: public ConfiguredWriter<WriterConfig>
+	{
+
+	public:
+		inline explicit ChunkCounter(const WriterConfig& config = WriterConfig())
+			: ConfiguredWriter(config)
+		{
+		}
+
+		inline size_t GetChunkCount() const
+		{
+			return m_chunkCount;
+		}
+
+		inline size_t GetByteCount() const
+		{
+			return m_byteCount;
+		}
+
+	protected:
+		inline void Write(std::string_view chunk) override
+		{
+			if (chunk.empty())
+			{
+				return;
+			}
+
+			m_chunkCount++;
+			m_byteCount += chunk.size();
+		}
+
+		inline bool OnCommit(bool force) override
+		{
+			(void)force;
+
+			return true;
+		}
+
+	private:
+		size_t m_chunkCount = 0;
+		size_t m_byteCount = 0;
+
+	};
+
+	/*!
+		Report the time per chunk and the bytes per second, where each
+		iteration of the benchmark writes `chunksPerIteration` chunks and
+		`bytesPerIteration` bytes.
+	*/
+	inline void ReportThroughput(benchmark::State& state, size_t chunksPerIteration, size_t bytesPerIteration)
+	{
+		// an inverted rate is shown as a duration, like "12.3ns"
+
+		state.counters["time/chunk"] = benchmark::Counter(
+			static_cast<double>(chunksPerIteration),
+			benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert
+		);
+
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytesPerIteration));
+	}
+
+	/*!
+		Report the throughput of a body that was run once for every
+		iteration, by running it through a \ref ChunkCounter.
+	*/
+	template <typename TBody>
+	inline void ReportThroughput(benchmark::State& state, TBody&& body)
+	{
+		ChunkCounter counter;
+		body(counter);
+
+		ReportThroughput(state, counter.GetChunkCount(), counter.GetByteCount());
+	}
+
+};
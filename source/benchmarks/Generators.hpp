@@ -0,0 +1,175 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <Panini.hpp>
+
+namespace panini::benchmarks
+{
+
+	/*!
+		Generates a header with many small classes, calling the writer
+		directly instead of through commands.
+	*/
+	template <typename TWriter>
+	inline void GenerateClasses(TWriter& w, size_t classCount)
+	{
+		static const char* s_MemberNames[] = {
+			"position", "velocity", "rotation", "scale",
+			"health", "armor", "speed", "target"
+		};
+
+		for (size_t i = 0; i < classCount; ++i)
+		{
+			w << "class GameObject" << std::string_view(s_MemberNames[i % 8]) << NextLine();
+			w << '{' << IndentPush() << NextLine();
+
+			w << IndentPop() << "public:" << IndentPush() << NextLine();
+
+			for (const char* member : s_MemberNames)
+			{
+				w << "int32_t m_" << member << " = 0;" << NextLine();
+			}
+
+			w << IndentPop() << "};" << NextLine();
+			w << NextLine();
+		}
+	}
+
+	/*!
+		Game object definition, like the sections of the ini file in the
+		DataDrivenHierarchy example.
+	*/
+	struct HierarchyObject
+	{
+		std::string name;
+		std::string sprite;
+		std::string health;
+		std::string bonus;
+		bool addTransform = false;
+		bool addSprite = false;
+		bool addLife = false;
+		bool addPlayer = false;
+		bool addEnemy = false;
+	};
+
+	/*!
+		Makes `objectCount` game object definitions, cycling through the
+		kinds of objects found in the DataDrivenHierarchy example.
+	*/
+	inline std::vector<HierarchyObject> MakeHierarchy(size_t objectCount)
+	{
+		static const char* s_Kinds[] = { "Player", "Enemy", "Pickup", "Prop" };
+
+		std::vector<HierarchyObject> objects(objectCount);
+
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			HierarchyObject& object = objects[i];
+			const size_t kind = i % 4;
+
+			object.name = std::string(s_Kinds[kind]) + std::to_string(i);
+			object.sprite = "\"" + object.name + ".png\"";
+			object.health = std::to_string(10 + (i % 90));
+			object.addTransform = true;
+			object.addSprite = true;
+			object.addLife = kind != 3;
+			object.addPlayer = kind == 0;
+			object.addEnemy = kind == 1;
+
+			if (kind == 2)
+			{
+				object.bonus = std::to_string(i % 7);
+			}
+		}
+
+		return objects;
+	}
+
+	/*!
+		Generates a source file with a factory function for every game
+		object, using the same commands as the DataDrivenHierarchy example.
+	*/
+	inline void GenerateHierarchy(Writer& w, const std::vector<HierarchyObject>& objects)
+	{
+		auto addComponent = [](Writer& w, const char* typeName, const std::vector<std::string>& parameters) {
+			w << "gameObject->AddComponent<" << typeName << ">(";
+			w << CommaList(parameters.begin(), parameters.end());
+			w << ");" << NextLine();
+		};
+
+		w << CommentBlock([](Writer& w) {
+			w << "Generated from Hierarchy.ini, do not modify." << NextLine();
+		}) << NextLine();
+		w << NextLine();
+
+		w << IncludeBlock(IncludeSet{
+			{ "Components/LifeComponent.hpp", IncludeStyle::DoubleQuotes },
+			{ "Components/SpriteComponent.hpp", IncludeStyle::DoubleQuotes },
+			{ "Components/TransformComponent.hpp", IncludeStyle::DoubleQuotes },
+			{ "GameObject.hpp", IncludeStyle::DoubleQuotes },
+		}) << NextLine();
+		w << NextLine();
+
+		for (const HierarchyObject& object : objects)
+		{
+			w << Scope("GameObject* Create" + object.name + "()", [&object, &addComponent](Writer& w) {
+				w << "GameObject* gameObject = new GameObject();" << NextLine();
+
+				if (object.addTransform)
+				{
+					addComponent(w, "TransformComponent", {});
+				}
+
+				if (object.addSprite)
+				{
+					addComponent(w, "SpriteComponent", { object.sprite });
+				}
+
+				if (object.addLife)
+				{
+					std::vector<std::string> parameters = { object.health };
+					if (!object.bonus.empty())
+					{
+						parameters.push_back(object.bonus);
+					}
+
+					addComponent(w, "LifeComponent", parameters);
+				}
+
+				if (object.addPlayer)
+				{
+					addComponent(w, "PlayerBehavior", {});
+				}
+
+				if (object.addEnemy)
+				{
+					addComponent(w, "EnemyBehavior", {});
+				}
+
+				w << "return gameObject;" << NextLine();
+			}) << NextLine();
+			w << NextLine();
+		}
+	}
+
+};
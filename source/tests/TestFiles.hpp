@@ -0,0 +1,86 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <Panini.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace panini::tests
+{
+
+	/*!
+		Replaces the contents of the file at `path`.
+	*/
+	inline void WriteFile(const std::filesystem::path& path, const std::string& contents)
+	{
+		std::ofstream f(path, std::ios::out | std::ios::binary);
+		f << contents;
+	}
+
+	/*!
+		Reads the contents of the file at `path`, or an empty string if it
+		doesn't exist.
+	*/
+	inline std::string ReadFile(const std::filesystem::path& path)
+	{
+		std::ifstream f(path, std::ios::in | std::ios::binary);
+		std::stringstream ss;
+		ss << f.rdbuf();
+
+		return ss.str();
+	}
+
+	/*!
+		Waits long enough for the file system clock to tick, so files saved
+		afterwards have a later modification time.
+	*/
+	inline void WaitForClock()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	/*!
+		Removes the directory and everything in it.
+	*/
+	inline std::filesystem::path ClearDirectory(const std::string& name)
+	{
+		std::filesystem::path d = name;
+		std::filesystem::remove_all(d);
+
+		return d;
+	}
+
+	/*!
+		Creates an empty directory, removing what was in it before.
+	*/
+	inline std::filesystem::path MakeDirectory(const std::string& name)
+	{
+		std::filesystem::path d = ClearDirectory(name);
+		std::filesystem::create_directories(d);
+
+		return d;
+	}
+
+};
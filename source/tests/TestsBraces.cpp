@@ -365,3 +365,25 @@ TEST(Braces, InheritConfigWhitesmiths)
 		}
 	})", t.c_str());
 }
+
+TEST(Braces, MakeBraces)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::string a = "Inspector";
+	std::string b = "Gadget";
+	std::string c = "Brain";
+
+	w << MakeBraces([&a, &b, &c](Writer& writer) {
+		writer << a << NextLine() << b << NextLine() << c << NextLine();
+	}, BracesOptions{ BraceBreakingStyle::Attach });
+
+	EXPECT_STREQ(R"({
+	Inspector
+	Gadget
+	Brain
+})", t.c_str());
+}
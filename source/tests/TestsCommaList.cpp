@@ -585,3 +585,172 @@ TEST(CommaList, Example)
 	DUCK_MARINE
 };)", t.c_str());
 }
+
+TEST(CommaList, FormatDefaultMatchesToString)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<double> s = {
+		0.1, -2.5, 1e10, 123456.789
+	};
+
+	w << CommaList(s.begin(), s.end());
+
+	std::string e = std::to_string(0.1) + ", " + std::to_string(-2.5) + ", " + std::to_string(1e10) + ", " + std::to_string(123456.789);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(CommaList, FormatHexadecimalIntegers)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<int32_t> s = {
+		0, 255, -16, INT32_MIN
+	};
+
+	CommaListOptions o;
+	o.numberFormat = NumberFormat::Hexadecimal;
+
+	w << CommaList(s.begin(), s.end(), o);
+
+	EXPECT_STREQ(R"(0x0, 0xff, -0x10, -0x80000000)", t.c_str());
+}
+
+TEST(CommaList, FormatHexadecimalFloats)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<double> s = {
+		3.0, -0.5, 0.0
+	};
+
+	CommaListOptions o;
+	o.numberFormat = NumberFormat::Hexadecimal;
+
+	w << CommaList(s.begin(), s.end(), o);
+
+	EXPECT_STREQ(R"(0x1.8p+1, -0x1p-1, 0x0p+0)", t.c_str());
+}
+
+TEST(CommaList, FormatFixed)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<float> s = {
+		2.3f, 9.125f, -4.0f
+	};
+
+	CommaListOptions o;
+	o.numberFormat = NumberFormat::Fixed;
+	o.precision = 2;
+
+	w << CommaList(s.begin(), s.end(), o);
+
+	EXPECT_STREQ(R"(2.30, 9.12, -4.00)", t.c_str());
+}
+
+TEST(CommaList, FormatFixedLarge)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<double> s = { 1e300 };
+
+	CommaListOptions o;
+	o.numberFormat = NumberFormat::Fixed;
+	o.precision = 1;
+
+	w << CommaList(s.begin(), s.end(), o);
+
+	EXPECT_EQ(size_t{ 303 }, t.size());
+	EXPECT_STREQ(".0", t.c_str() + 301);
+}
+
+TEST(CommaList, FormatShortest)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<double> s = {
+		0.1, 1.0 / 3.0, 100.0
+	};
+
+	CommaListOptions o;
+	o.numberFormat = NumberFormat::Shortest;
+
+	w << CommaList(s.begin(), s.end(), o);
+
+	EXPECT_STREQ(R"(0.1, 0.3333333333333333, 100)", t.c_str());
+}
+
+TEST(CommaList, FormatBoolean)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	bool s[] = { true, false };
+
+	w << CommaList(std::begin(s), std::end(s));
+
+	EXPECT_STREQ(R"(1, 0)", t.c_str());
+}
+
+TEST(CommaList, TransformLvalue)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<int32_t> s = {
+		1, 2, 3
+	};
+
+	auto transform = [](Writer& writer, const int32_t& it, size_t index) {
+		writer << std::to_string(it * 10 + static_cast<int32_t>(index));
+	};
+
+	w << CommaList(s.begin(), s.end(), CommaListOptions{}, transform);
+
+	EXPECT_STREQ(R"(10, 21, 32)", t.c_str());
+}
+
+TEST(CommaList, TransformTypeErased)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::vector<int32_t> s = {
+		4, 5
+	};
+
+	using List = CommaList<std::vector<int32_t>::iterator>;
+
+	w << List(s.begin(), s.end(), CommaListOptions{}, [](Writer& writer, const int32_t& it, size_t index) {
+		List::DefaultTransform(writer, it + 1, index);
+	});
+	w << " & " << List(s.begin(), s.end());
+
+	EXPECT_STREQ(R"(5, 6 & 4, 5)", t.c_str());
+}
@@ -0,0 +1,294 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+#include "TestFiles.hpp"
+
+using panini::tests::ClearDirectory;
+
+namespace
+{
+
+	class ExpensiveCommand
+		: public panini::Command
+	{
+
+	public:
+		ExpensiveCommand(const std::string& name, int& visits)
+			: m_name(name)
+			, m_visits(visits)
+		{
+		}
+
+		void Visit(panini::Writer& writer) override
+		{
+			using namespace panini;
+
+			++m_visits;
+
+			writer << Scope("struct " + m_name, [](Writer& w) {
+				w << "int health = 100;" << NextLine();
+			}) << ";";
+		}
+
+	private:
+		std::string m_name;
+		int& m_visits;
+
+	};
+
+};
+
+TEST(CommandCache, Empty)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("command_cache_empty");
+
+	CommandCache c(d);
+	EXPECT_EQ(d, c.GetDirectory());
+	EXPECT_EQ(0, c.GetEntryCount());
+	EXPECT_EQ(0, c.GetByteSize());
+	EXPECT_FALSE(c.Contains(1));
+
+	Fragment f;
+	EXPECT_FALSE(c.Load(1, f));
+	EXPECT_EQ(0, c.GetHitCount());
+	EXPECT_EQ(1, c.GetMissCount());
+	EXPECT_FALSE(std::filesystem::exists(d));
+}
+
+TEST(CommandCache, StoreAndLoad)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("command_cache_store");
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << "Hello" << IndentPush() << NextLine() << "World" << IndentPop();
+
+	{
+		CommandCache c(d);
+		EXPECT_TRUE(c.Store(7, f));
+		EXPECT_TRUE(c.Contains(7));
+		EXPECT_EQ(1, c.GetEntryCount());
+		EXPECT_LT(0, c.GetByteSize());
+	}
+
+	// entries are found again by a new cache
+
+	CommandCache c(d);
+	EXPECT_EQ(1, c.GetEntryCount());
+
+	Fragment l;
+	ASSERT_TRUE(c.Load(7, l));
+	EXPECT_EQ(1, c.GetHitCount());
+
+	std::string t;
+	StringWriter tw(t);
+	tw << Splice(l);
+
+	EXPECT_STREQ("Hello\n\tWorld", t.c_str());
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(CommandCache, Corrupted)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("command_cache_corrupted");
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << "Valid";
+
+	CommandCache c(d);
+	ASSERT_TRUE(c.Store(3, f));
+
+	std::filesystem::path p = *std::filesystem::directory_iterator(d);
+	{
+		std::ofstream s(p, std::ios::binary | std::ios::in | std::ios::out);
+		s.seekp(16);
+		s.put('X');
+	}
+
+	Fragment l;
+	EXPECT_FALSE(c.Load(3, l));
+	EXPECT_EQ(1, c.GetMissCount());
+	EXPECT_FALSE(c.Contains(3));
+	EXPECT_EQ(0, c.GetByteSize());
+	EXPECT_FALSE(std::filesystem::exists(p));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(CommandCache, EvictLeastRecentlyUsed)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("command_cache_evict");
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << std::string(100, 'a');
+
+	CommandCache s(d);
+	ASSERT_TRUE(s.Store(1, f));
+	const uint64_t e = s.GetByteSize();
+
+	CommandCache c(d, e * 3);
+	ASSERT_TRUE(c.Store(2, f));
+	ASSERT_TRUE(c.Store(3, f));
+	EXPECT_EQ(3, c.GetEntryCount());
+
+	// using 1 makes 2 the least recently used
+
+	Fragment l;
+	ASSERT_TRUE(c.Load(1, l));
+	ASSERT_TRUE(c.Store(4, f));
+
+	EXPECT_EQ(3, c.GetEntryCount());
+	EXPECT_EQ(e * 3, c.GetByteSize());
+	EXPECT_EQ(1, c.GetEvictionCount());
+	EXPECT_TRUE(c.Contains(1));
+	EXPECT_FALSE(c.Contains(2));
+	EXPECT_TRUE(c.Contains(3));
+	EXPECT_TRUE(c.Contains(4));
+
+	// too large to be stored at all
+
+	CommandCache t(d, e - 1);
+	EXPECT_EQ(0, t.GetEntryCount());
+	EXPECT_FALSE(t.Store(5, f));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(CommandCache, Clear)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("command_cache_clear");
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << "Gone";
+
+	CommandCache c(d);
+	ASSERT_TRUE(c.Store(1, f));
+	ASSERT_TRUE(c.Store(2, f));
+
+	c.Clear();
+	EXPECT_EQ(0, c.GetEntryCount());
+	EXPECT_EQ(0, c.GetByteSize());
+	EXPECT_TRUE(std::filesystem::is_empty(d));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(CachedCommand, MissThenHit)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("cached_command_hit");
+	CommandCache c(d);
+
+	int v = 0;
+
+	std::string e;
+	StringWriter ew(e);
+	ew << IndentPush() << ExpensiveCommand("Robot", v);
+
+	std::string a;
+	StringWriter aw(a);
+	aw << IndentPush() << CachedCommand(c, 11, ExpensiveCommand("Robot", v));
+
+	EXPECT_EQ(2, v);
+	EXPECT_EQ(1, c.GetMissCount());
+	EXPECT_STREQ(e.c_str(), a.c_str());
+
+	std::string b;
+	StringWriter bw(b);
+	bw << IndentPush() << CachedCommand(c, 11, ExpensiveCommand("Robot", v));
+
+	EXPECT_EQ(2, v);
+	EXPECT_EQ(1, c.GetHitCount());
+	EXPECT_STREQ(e.c_str(), b.c_str());
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(CachedCommand, KeyIncludesConfig)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("cached_command_config");
+	CommandCache c(d);
+
+	int v = 0;
+
+	std::string a;
+	StringWriter aw(a);
+	aw << CachedCommand(c, 11, ExpensiveCommand("Robot", v));
+
+	std::string b;
+	StringWriterConfig bc;
+	bc.braceBreakingStyle = BraceBreakingStyle::Attach;
+	StringWriter bw(b, bc);
+	bw << CachedCommand(c, 11, ExpensiveCommand("Robot", v));
+
+	std::string o;
+	StringWriter ow(o);
+	ow << "typedef " << CachedCommand(c, 11, ExpensiveCommand("Robot", v));
+
+	EXPECT_EQ(3, v);
+	EXPECT_EQ(3, c.GetMissCount());
+	EXPECT_STREQ("struct Robot\n{\n\tint health = 100;\n};", a.c_str());
+	EXPECT_STREQ("struct Robot {\n\tint health = 100;\n};", b.c_str());
+	EXPECT_STREQ("typedef struct Robot\n{\n\tint health = 100;\n};", o.c_str());
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(CachedCommand, DifferentInputs)
+{
+	using namespace panini;
+
+	std::filesystem::path d = ClearDirectory("cached_command_inputs");
+	CommandCache c(d);
+
+	int v = 0;
+
+	std::string a;
+	StringWriter aw(a);
+	aw << CachedCommand(c, Hash64::Compute("Robot"), ExpensiveCommand("Robot", v));
+	aw << CachedCommand(c, Hash64::Compute("Alien"), ExpensiveCommand("Alien", v));
+
+	EXPECT_EQ(2, v);
+	EXPECT_EQ(2, c.GetEntryCount());
+	EXPECT_STREQ("struct Robot\n{\n\tint health = 100;\n};struct Alien\n{\n\tint health = 100;\n};", a.c_str());
+
+	std::filesystem::remove_all(d);
+}
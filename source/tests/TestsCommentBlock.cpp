@@ -98,3 +98,20 @@ TEST(CommentBlock, EmptyLines)
  * Third:
  */)", t.c_str());
 }
+
+TEST(CommentBlock, MakeCommentBlock)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::string author = "Dr. Claw";
+
+	w << MakeCommentBlock([&author](Writer& writer) {
+		writer << "Author: " << author;
+	});
+
+	EXPECT_STREQ(R"(/* Author: Dr. Claw
+ */)", t.c_str());
+}
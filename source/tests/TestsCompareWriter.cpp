@@ -179,3 +179,223 @@ TEST(CompareWriter, DeprecatedConstructor)
 
 	EXPECT_STREQ("Please don't use me anymore!", ss.str().c_str());
 }
+
+TEST(CompareWriter, OutputIsPrefixOfFile)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_prefix.txt";
+
+	std::filesystem::remove(c.filePath);
+
+	std::ofstream p(c.filePath, std::ios::out | std::ios::binary);
+	p << "Gadget, Penny and Brain";
+	p.close();
+
+	{
+		CompareWriter w(c);
+		w << "Gadget, Penny";
+
+		EXPECT_TRUE(w.IsChanged());
+	}
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Gadget, Penny", ss.str().c_str());
+}
+
+TEST(CompareWriter, OutputIsLongerThanFile)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_longer.txt";
+
+	std::filesystem::remove(c.filePath);
+
+	std::ofstream p(c.filePath, std::ios::out | std::ios::binary);
+	p << "Gadget";
+	p.close();
+
+	{
+		CompareWriter w(c);
+		w << "Gad" << "get" << NextLine() << "Penny";
+
+		EXPECT_TRUE(w.IsChanged());
+	}
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Gadget\nPenny", ss.str().c_str());
+}
+
+TEST(CompareWriter, ForceCommitUnchanged)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_force.txt";
+
+	std::filesystem::remove(c.filePath);
+
+	std::ofstream p(c.filePath, std::ios::out | std::ios::binary);
+	p << "Go go gadget";
+	p.close();
+
+	CompareWriter w(c);
+	w << "Go go " << "gadget";
+
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_TRUE(w.Commit(true));
+	EXPECT_FALSE(w.IsChanged());
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Go go gadget", ss.str().c_str());
+}
+
+TEST(CompareWriter, WriteAfterCommit)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_after_commit.txt";
+
+	std::filesystem::remove(c.filePath);
+
+	CompareWriter w(c);
+	w << "Mad";
+
+	EXPECT_TRUE(w.Commit());
+	EXPECT_FALSE(w.IsChanged());
+
+	w << "Cat";
+
+	EXPECT_TRUE(w.IsChanged());
+	EXPECT_TRUE(w.Commit());
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("MadCat", ss.str().c_str());
+}
+
+TEST(CompareWriter, ResetPath)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_reset_first.txt";
+	std::filesystem::remove(c.filePath);
+	std::filesystem::remove("compare_reset_second.txt");
+
+	std::ofstream p("compare_reset_second.txt", std::ios::out | std::ios::binary);
+	p << "Same old";
+	p.close();
+
+	CompareWriter w(c);
+	w << "Brand new";
+	w.Reset("compare_reset_second.txt");
+	w << "Same old";
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_FALSE(w.Commit());
+
+	std::ifstream f("compare_reset_first.txt", std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Brand new", ss.str().c_str());
+}
+
+TEST(CompareWriter, CommitOnlyOnce)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_commit_once.txt";
+	std::filesystem::remove(c.filePath);
+
+	CompareWriter w(c);
+	w << "Once";
+	EXPECT_TRUE(w.Commit());
+	EXPECT_FALSE(w.Commit());
+
+	w << " more";
+	EXPECT_TRUE(w.Commit());
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Once more", ss.str().c_str());
+}
+
+#if defined(__linux__)
+
+TEST(CompareWriter, FailedWriteIsNotRecorded)
+{
+	using namespace panini;
+
+	OutputManifest m("compare_failed_write.manifest");
+
+	CompareWriterConfig c;
+	c.filePath = "/dev/full";
+	c.manifest = &m;
+
+	CompareWriter w(c);
+	w << "Go, go, Gadget disk!";
+
+	EXPECT_FALSE(w.Commit());
+	EXPECT_EQ(0, m.GetEntryCount());
+
+	w.Discard();
+
+	std::filesystem::remove("compare_failed_write.manifest");
+}
+
+#endif
+
+TEST(CompareWriter, DiscardKeepsFile)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "compare_discard.txt";
+
+	std::ofstream p(c.filePath, std::ios::out | std::ios::binary);
+	p << "Keep it";
+	p.close();
+
+	{
+		CompareWriter w(c);
+		w << "Keep";
+		w.Discard();
+		w << " something else";
+
+		EXPECT_FALSE(w.IsChanged());
+		EXPECT_FALSE(w.Commit());
+	}
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Keep it", ss.str().c_str());
+}
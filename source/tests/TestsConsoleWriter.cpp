@@ -36,3 +36,20 @@ TEST(ConsoleWriter, Write)
 	And me!
 )", ss.str().c_str());
 }
+
+TEST(ConsoleWriter, WriteIncompleteLine)
+{
+	using namespace panini;
+
+	std::stringstream ss;
+
+	{
+		ConsoleWriter w(ss);
+		w << "Hello" << NextLine();
+		w << "Unfinished";
+
+		EXPECT_STREQ("Hello\n", ss.str().c_str());
+	}
+
+	EXPECT_STREQ("Hello\nUnfinished", ss.str().c_str());
+}
@@ -0,0 +1,82 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+#include "TestFiles.hpp"
+
+TEST(DataFile, Record)
+{
+	using namespace panini;
+
+	std::string c;
+	DataFile::AppendRecord(c, 0xBADC0DE, 42, -7, "/gadget/hat.txt");
+
+	EXPECT_STREQ("000000000badc0de 42 -7 /gadget/hat.txt\n", c.c_str());
+
+	uint64_t h = 0;
+	uint64_t s = 0;
+	int64_t t = 0;
+	std::string_view k;
+	EXPECT_TRUE(DataFile::ParseRecord(std::string_view(c).substr(0, c.size() - 1), h, s, t, k));
+	EXPECT_EQ(0xBADC0DE, h);
+	EXPECT_EQ(42, s);
+	EXPECT_EQ(-7, t);
+	EXPECT_EQ("/gadget/hat.txt", k);
+
+	EXPECT_FALSE(DataFile::ParseRecord("000000000badc0de 42 -7", h, s, t, k));
+	EXPECT_FALSE(DataFile::ParseRecord("zz 42 -7 /gadget/hat.txt", h, s, t, k));
+}
+
+TEST(DataFile, Checksum)
+{
+	using namespace panini;
+
+	std::string c = "header\nline\n";
+	DataFile::AppendChecksum(c);
+
+	std::string_view l;
+	EXPECT_TRUE(DataFile::ParseChecksum(c, "header\n", l));
+	EXPECT_EQ("line\n", l);
+
+	EXPECT_FALSE(DataFile::ParseChecksum(c, "footer\n", l));
+
+	c[7] = 'm';
+	EXPECT_FALSE(DataFile::ParseChecksum(c, "header\n", l));
+}
+
+TEST(DataFile, WriteAndRead)
+{
+	using namespace panini;
+
+	std::filesystem::path d = tests::MakeDirectory("data_file_write");
+
+	EXPECT_TRUE(DataFile::Write(d / "claw.txt", "Next time, Gadget!", d / "claw.txt.tmp"));
+	EXPECT_FALSE(std::filesystem::exists(d / "claw.txt.tmp"));
+
+	std::string c;
+	EXPECT_TRUE(DataFile::Read(d / "claw.txt", c));
+	EXPECT_STREQ("Next time, Gadget!", c.c_str());
+
+	EXPECT_FALSE(DataFile::Read(d / "missing.txt", c));
+	EXPECT_FALSE(DataFile::Write(d / "missing" / "claw.txt", "Next time!", d / "missing" / "claw.txt.tmp"));
+}
@@ -0,0 +1,314 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "TestFiles.hpp"
+
+using panini::tests::MakeDirectory;
+using panini::tests::WaitForClock;
+using panini::tests::WriteFile;
+
+namespace
+{
+
+	void Generate(panini::DependencyDatabase& database, const std::filesystem::path& output, const std::filesystem::path& input)
+	{
+		using namespace panini;
+
+		FileWriterConfig c;
+		c.targetPath = output;
+		c.dependencies = &database;
+		c.inputs = { input };
+
+		FileWriter w(c);
+		w << "Generated" << NextLine();
+	}
+
+};
+
+TEST(DependencyDatabase, MissingFile)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_missing");
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+
+	EXPECT_EQ(0, b.GetEntryCount());
+	EXPECT_FALSE(b.IsCorrupted());
+	EXPECT_FALSE(b.IsUpToDate(d / "output.txt"));
+	EXPECT_EQ(1, b.GetCheckCount());
+	EXPECT_EQ(0, b.GetUpToDateCount());
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, UpToDate)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_up_to_date");
+	WriteFile(d / "input.ini", "[Robot]");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+		Generate(b, d / "output.txt", d / "input.ini");
+
+		EXPECT_EQ(1, b.GetEntryCount());
+
+		WaitForClock();
+	}
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+
+	EXPECT_FALSE(b.IsCorrupted());
+	EXPECT_EQ(1, b.GetEntryCount());
+	EXPECT_TRUE(b.IsUpToDate(d / "output.txt"));
+	EXPECT_TRUE(b.IsUpToDate(d / "output.txt", { d / "input.ini" }));
+	EXPECT_FALSE(b.IsUpToDate(d / "output.txt", { d / "other.ini" }));
+	EXPECT_EQ(3, b.GetCheckCount());
+	EXPECT_EQ(2, b.GetUpToDateCount());
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, InputChanged)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_input_changed");
+	WriteFile(d / "input.ini", "[Robot]");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+		Generate(b, d / "output.txt", d / "input.ini");
+
+		WaitForClock();
+	}
+
+	WriteFile(d / "input.ini", "[Alien]");
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+	EXPECT_FALSE(b.IsUpToDate(d / "output.txt"));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, InputTouched)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_input_touched");
+	WriteFile(d / "input.ini", "[Robot]");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+		Generate(b, d / "output.txt", d / "input.ini");
+
+		WaitForClock();
+	}
+
+	// same contents, so the output is still up to date
+
+	WriteFile(d / "input.ini", "[Robot]");
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+	EXPECT_TRUE(b.IsUpToDate(d / "output.txt"));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, InputRemoved)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_input_removed");
+	WriteFile(d / "input.ini", "[Robot]");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+		Generate(b, d / "output.txt", d / "input.ini");
+
+		WaitForClock();
+	}
+
+	std::filesystem::remove(d / "input.ini");
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+	EXPECT_FALSE(b.IsUpToDate(d / "output.txt"));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, OutputModified)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_output_modified");
+	WriteFile(d / "input.ini", "[Robot]");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+		Generate(b, d / "output.txt", d / "input.ini");
+
+		WaitForClock();
+	}
+
+	WriteFile(d / "output.txt", "Edited by hand\n");
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+	EXPECT_FALSE(b.IsUpToDate(d / "output.txt"));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, GeneratorVersionChanged)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_version");
+	WriteFile(d / "input.ini", "[Robot]");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+		Generate(b, d / "output.txt", d / "input.ini");
+
+		WaitForClock();
+	}
+
+	DependencyDatabase b(d / "dependencies.txt", "2.0");
+	EXPECT_FALSE(b.IsCorrupted());
+	EXPECT_EQ(0, b.GetEntryCount());
+	EXPECT_FALSE(b.IsUpToDate(d / "output.txt"));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, Corrupted)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_corrupted");
+	WriteFile(d / "dependencies.txt", "panini-dependencies 1\nversion 0\nchecksum 1234\n");
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+	EXPECT_TRUE(b.IsCorrupted());
+	EXPECT_EQ(0, b.GetEntryCount());
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, CompareWriterUnchanged)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_compare");
+	WriteFile(d / "input.ini", "[Robot]");
+	WriteFile(d / "output.txt", "Robot\n");
+
+	{
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+
+		CompareWriterConfig c;
+		c.filePath = d / "output.txt";
+		c.dependencies = &b;
+
+		{
+			CompareWriter w(c);
+			w.AddInput(d / "input.ini");
+			w << "Robot" << NextLine();
+
+			EXPECT_FALSE(w.IsChanged());
+		}
+
+		EXPECT_EQ(1, b.GetEntryCount());
+
+		WaitForClock();
+	}
+
+	DependencyDatabase b(d / "dependencies.txt", "1.0");
+	EXPECT_TRUE(b.IsUpToDate(d / "output.txt", { d / "input.ini" }));
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(DependencyDatabase, GenerationJobsSkipped)
+{
+	using namespace panini;
+
+	std::filesystem::path d = MakeDirectory("dependency_database_jobs");
+	WriteFile(d / "shared.ini", "[Shared]");
+	for (int i = 0; i < 20; ++i)
+	{
+		WriteFile(d / ("input" + std::to_string(i) + ".ini"), "[Object" + std::to_string(i) + "]");
+	}
+
+	std::atomic<int> v = 0;
+
+	auto r = [&d, &v]() {
+		DependencyDatabase b(d / "dependencies.txt", "1.0");
+
+		CompareWriterConfig c;
+		c.dependencies = &b;
+		c.inputs = { d / "shared.ini" };
+
+		GenerationJobs j(c);
+		for (int i = 0; i < 20; ++i)
+		{
+			j.Add(d / ("output" + std::to_string(i) + ".txt"), { d / ("input" + std::to_string(i) + ".ini") }, [i, &v](Writer& w) {
+				++v;
+				w << "Object " << std::to_string(i) << NextLine();
+			});
+		}
+
+		ThreadPool p(4);
+		j.Run(p);
+
+		WaitForClock();
+
+		return std::make_pair(j.GetResultCount(GenerationJobStatus::Changed), j.GetResultCount(GenerationJobStatus::Skipped));
+	};
+
+	EXPECT_EQ(std::make_pair(size_t{ 20 }, size_t{ 0 }), r());
+	EXPECT_EQ(20, v);
+
+	EXPECT_EQ(std::make_pair(size_t{ 0 }, size_t{ 20 }), r());
+	EXPECT_EQ(20, v);
+
+	WriteFile(d / "input7.ini", "[Changed]");
+
+	auto s = r();
+	EXPECT_EQ(0, s.first);
+	EXPECT_EQ(19, s.second);
+	EXPECT_EQ(21, v);
+
+	WriteFile(d / "shared.ini", "[Changed]");
+
+	EXPECT_EQ(std::make_pair(size_t{ 0 }, size_t{ 0 }), r());
+	EXPECT_EQ(41, v);
+
+	std::filesystem::remove_all(d);
+}
@@ -0,0 +1,298 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	void GenerateStruct(panini::Writer& writer)
+	{
+		using namespace panini;
+
+		writer << Include("vector", IncludeStyle::AngularBrackets) << NextLine();
+		writer << NextLine();
+		writer << Scope("struct Gadget", [](Writer& writer) {
+			writer << "std::vector<int> arms;" << NextLine();
+			writer << Scope("void Go()", [](Writer& writer) {
+				writer << "arms.push_back(" << Braces([](Writer& writer) {
+					writer << "1";
+				}, BraceBreakingStyle::Attach) << ");" << NextLine();
+			}) << NextLine();
+		}) << ";";
+	}
+
+};
+
+TEST(Document, Empty)
+{
+	using namespace panini;
+
+	Document d;
+
+	EXPECT_TRUE(d.IsEmpty());
+
+	std::string t;
+	StringWriter w(t);
+	d.Render(w);
+
+	EXPECT_STREQ("", t.c_str());
+}
+
+TEST(Document, RenderTwice)
+{
+	using namespace panini;
+
+	size_t calls = 0;
+
+	Document d([&calls](Writer& w) {
+		calls++;
+		w << "Hello" << NextLine() << IndentPush() << "World" << IndentPop();
+	});
+
+	std::string t;
+	StringWriter w(t);
+	d.Render(w);
+	w << NextLine();
+	d.Render(w);
+
+	EXPECT_EQ(size_t{ 1 }, calls);
+	EXPECT_STREQ("Hello\n\tWorld\nHello\n\tWorld", t.c_str());
+}
+
+TEST(Document, SameAsDirectOutput)
+{
+	using namespace panini;
+
+	Document d(GenerateStruct);
+
+	for (BraceBreakingStyle style : { BraceBreakingStyle::Allman, BraceBreakingStyle::Attach, BraceBreakingStyle::Whitesmiths })
+	{
+		StringWriterConfig c;
+		c.braceBreakingStyle = style;
+		c.chunkIndent = "  ";
+		c.chunkNewLine = "\r\n";
+
+		std::string expected;
+		StringWriter ew(expected, c);
+		GenerateStruct(ew);
+
+		std::string t;
+		StringWriter w(t, c);
+		d.Render(w);
+
+		EXPECT_STREQ(expected.c_str(), t.c_str());
+	}
+}
+
+TEST(Document, IncludeStyleIsResolvedWhenRendered)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Gadget.hpp");
+	s.Add("Arms.hpp");
+
+	Document d([&s](Writer& w) {
+		w << IncludeBlock(s) << NextLine();
+		w << Include("Penny.hpp");
+	});
+
+	StringWriterConfig c;
+	c.includeStyle = IncludeStyle::DoubleQuotes;
+
+	std::string t;
+	StringWriter w(t, c);
+	d.Render(w);
+
+	EXPECT_STREQ("#include \"Arms.hpp\"\n#include \"Gadget.hpp\"\n#include \"Penny.hpp\"", t.c_str());
+
+	c.includeStyle = IncludeStyle::AngularBrackets;
+
+	std::string u;
+	StringWriter v(u, c);
+	d.Render(v);
+
+	EXPECT_STREQ("#include <Arms.hpp>\n#include <Gadget.hpp>\n#include <Penny.hpp>", u.c_str());
+}
+
+TEST(Document, CommentBlock)
+{
+	using namespace panini;
+
+	Document d([](Writer& w) {
+		w << CommentBlock([](Writer& w) {
+			w << "Chief Quimby" << NextLine();
+			w << "Brain";
+		});
+	});
+
+	std::string t;
+	StringWriter w(t);
+	d.Render(w);
+
+	EXPECT_STREQ("/* Chief Quimby\n * Brain\n */", t.c_str());
+}
+
+TEST(Document, Nested)
+{
+	using namespace panini;
+
+	Document inner([](Writer& w) {
+		w << Scope("namespace gadget", [](Writer& w) {
+			w << "int hat;" << NextLine();
+		});
+	});
+
+	Document d([&inner](Writer& w) {
+		w << "// outer" << NextLine();
+		inner.Render(w);
+	});
+
+	StringWriterConfig c;
+	c.braceBreakingStyle = BraceBreakingStyle::Attach;
+
+	std::string t;
+	StringWriter w(t, c);
+	d.Render(w);
+
+	EXPECT_STREQ("// outer\nnamespace gadget {\n\tint hat;\n}", t.c_str());
+}
+
+TEST(Document, Append)
+{
+	using namespace panini;
+
+	Document d([](Writer& w) {
+		w << "Mad";
+	});
+	d.Record([](Writer& w) {
+		w << "Cat";
+	});
+
+	std::string t;
+	StringWriter w(t);
+	w << std::move(d);
+
+	EXPECT_STREQ("MadCat", t.c_str());
+}
+
+TEST(Document, NestedCommand)
+{
+	using namespace panini;
+
+	Document inner([](Writer& w) {
+		w << Braces([](Writer& w) {
+			w << "return;" << NextLine();
+		});
+	});
+
+	Document d([&inner](Writer& w) {
+		w << "void Stop()" << std::move(inner);
+	});
+
+	StringWriterConfig c;
+	c.braceBreakingStyle = BraceBreakingStyle::Attach;
+
+	std::string t;
+	StringWriter w(t, c);
+	d.Render(w);
+
+	EXPECT_STREQ("void Stop(){\n\treturn;\n}", t.c_str());
+}
+
+TEST(Document, MakeScope)
+{
+	using namespace panini;
+
+	Document d([](Writer& w) {
+		w << MakeScope("enum class Color", [](Writer& w) {
+			w << "Red," << NextLine() << "Blue" << NextLine();
+		}) << ";";
+	});
+
+	StringWriterConfig c;
+	c.braceBreakingStyle = BraceBreakingStyle::Attach;
+
+	std::string t;
+	StringWriter w(t, c);
+	d.Render(w);
+
+	EXPECT_STREQ("enum class Color {\n\tRed,\n\tBlue\n};", t.c_str());
+}
+
+TEST(Document, Align)
+{
+	using namespace panini;
+
+	Document d([](Writer& w) {
+		w << "Call(first," << NextLine() << AlignPush(5) << "second);" << AlignPop();
+	});
+
+	std::string t;
+	StringWriter w(t);
+	w << IndentPush();
+	d.Render(w);
+
+	EXPECT_STREQ("\tCall(first,\n\t     second);", t.c_str());
+}
+
+TEST(Document, RenderConcurrently)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Gadget.hpp");
+	s.Add("Claw.hpp", IncludeStyle::AngularBrackets);
+	s.Add("Arms.hpp");
+
+	Document d([&s](Writer& w) {
+		w << IncludeBlock(s);
+	});
+
+	std::vector<std::string> t(4);
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < t.size(); ++i)
+	{
+		threads.emplace_back([&d, &t, i]() {
+			StringWriterConfig c;
+			c.includeStyle = (i % 2 == 0) ? IncludeStyle::DoubleQuotes : IncludeStyle::AngularBrackets;
+
+			for (size_t j = 0; j < 100; ++j)
+			{
+				t[i].clear();
+
+				StringWriter w(t[i], c);
+				d.Render(w);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_STREQ("#include <Claw.hpp>\n#include \"Arms.hpp\"\n#include \"Gadget.hpp\"", t[0].c_str());
+	EXPECT_STREQ("#include <Arms.hpp>\n#include <Claw.hpp>\n#include <Gadget.hpp>", t[1].c_str());
+}
@@ -111,3 +111,35 @@ TEST(FeatureFlag, ConditionFalseWithElse)
 
 	EXPECT_STREQ(R"(PaintTheRoom();)", s.c_str());
 }
+
+TEST(FeatureFlag, MakeFeatureFlagWithoutElse)
+{
+	using namespace panini;
+
+	std::string s;
+	StringWriter w(s);
+
+	w << MakeFeatureFlag(false, "should_push", [](Writer& writer) {
+		writer << "PushTheButton();" << NextLine();
+	});
+
+	EXPECT_STREQ(R"()", s.c_str());
+}
+
+TEST(FeatureFlag, MakeFeatureFlagElse)
+{
+	using namespace panini;
+
+	std::string s;
+	StringWriter w(s);
+
+	std::string button = "Button";
+
+	w << MakeFeatureFlag(false, "should_push", [&button](Writer& writer) {
+		writer << "Push" << button << "();" << NextLine();
+	}, [&button](Writer& writer) {
+		writer << "Pull" << button << "();";
+	});
+
+	EXPECT_STREQ(R"(PullButton();)", s.c_str());
+}
@@ -94,3 +94,225 @@ TEST(FileWriter, DeprecatedConstructor)
 
 	EXPECT_STREQ("This seems like a bad idea.", ss.str().c_str());
 }
+
+TEST(FileWriter, Streaming)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_streaming.txt";
+	c.mode = FileWriterMode::Streaming;
+	c.bufferSize = 8;
+
+	{
+		FileWriter w(c);
+		w << "Wowsers!" << NextLine();
+		w << "Go go gadget" << NextLine();
+		w << "umbrella";
+
+		// output is written before the writer is committed
+
+		EXPECT_LE(size_t{ 8 }, std::filesystem::file_size(c.targetPath));
+	}
+
+	std::ifstream f(c.targetPath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Wowsers!\nGo go gadget\numbrella", ss.str().c_str());
+}
+
+TEST(FileWriter, StreamingLongLine)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_streaming_long_line.txt";
+	c.mode = FileWriterMode::Streaming;
+	c.bufferSize = 64;
+
+	const std::string l(1000, 'x');
+
+	{
+		FileWriter w(c);
+		w << IndentPush();
+
+		// short chunks on a single line
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			w << "0x1F, ";
+		}
+
+		EXPECT_LE(size_t{ 64 }, std::filesystem::file_size(c.targetPath));
+
+		// a chunk larger than the buffer
+
+		w << l;
+
+		EXPECT_LE(size_t{ 1600 }, std::filesystem::file_size(c.targetPath));
+	}
+
+	std::string e = "\t";
+	for (size_t i = 0; i < 100; ++i)
+	{
+		e += "0x1F, ";
+	}
+	e += l;
+
+	std::ifstream f(c.targetPath, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_EQ(e, ss.str());
+}
+
+TEST(FileWriter, StreamingPreventDoubleCommit)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_streaming_double_commit.txt";
+	c.mode = FileWriterMode::Streaming;
+
+	FileWriter w(c);
+	w << "Stop right there, Gadget";
+
+	EXPECT_TRUE(w.IsChanged());
+	EXPECT_TRUE(w.Commit());
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_FALSE(w.Commit());
+
+	std::ifstream f(c.targetPath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Stop right there, Gadget", ss.str().c_str());
+}
+
+TEST(FileWriter, ScatterGather)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_scatter_gather.txt";
+	c.mode = FileWriterMode::ScatterGather;
+	c.bufferSize = 4;
+
+	static const std::string s_Body = "Doctor Claw();";
+
+	{
+		FileWriter w(c);
+		w << "void Gadget()" << NextLine();
+		w << "{" << IndentPush() << NextLine();
+		w << PinnedChunk{ s_Body } << NextLine();
+		w << PinnedChunk{ "MadCat();" } << ' ' << PinnedChunk{ "// meow" } << NextLine();
+		w << IndentPop() << "}";
+	}
+
+	std::ifstream f(c.targetPath, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("void Gadget()\n{\n\tDoctor Claw();\n\tMadCat(); // meow\n}", ss.str().c_str());
+}
+
+TEST(FileWriter, ScatterGatherPreventDoubleCommit)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_scatter_gather_double_commit.txt";
+	c.mode = FileWriterMode::ScatterGather;
+
+	FileWriter w(c);
+	w << PinnedChunk{ "Brain" };
+
+	EXPECT_TRUE(w.IsChanged());
+	EXPECT_TRUE(w.Commit());
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_FALSE(w.Commit());
+}
+
+TEST(FileWriter, ScatterGatherOpenOnCommit)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_scatter_gather_open.txt";
+	c.mode = FileWriterMode::ScatterGather;
+
+	std::ofstream p(c.targetPath, std::ios::out | std::ios::binary);
+	p << "Penny";
+	p.close();
+
+	FileWriter w(c);
+	w << "Brain";
+
+	EXPECT_EQ(5, std::filesystem::file_size(c.targetPath));
+	EXPECT_TRUE(w.Commit());
+
+	std::ifstream f(c.targetPath, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Brain", ss.str().c_str());
+}
+
+TEST(FileWriter, ResetPath)
+{
+	using namespace panini;
+
+	FileWriterConfig c;
+	c.targetPath = "file_reset_first.txt";
+
+	FileWriter w(c);
+	w << "First";
+	w.Reset("file_reset_second.txt");
+	w << "Second";
+	EXPECT_TRUE(w.Commit());
+
+	std::ifstream fa("file_reset_first.txt");
+	std::stringstream sa;
+	sa << fa.rdbuf();
+	EXPECT_STREQ("First", sa.str().c_str());
+
+	std::ifstream fb("file_reset_second.txt");
+	std::stringstream sb;
+	sb << fb.rdbuf();
+	EXPECT_STREQ("Second", sb.str().c_str());
+}
+
+#if defined(__linux__)
+
+TEST(FileWriter, FailedWriteIsNotRecorded)
+{
+	using namespace panini;
+
+	for (FileWriterMode m : { FileWriterMode::Commit, FileWriterMode::Streaming })
+	{
+		DependencyDatabase b("file_failed_write_dependencies.txt", "1.0");
+
+		FileWriterConfig c;
+		c.targetPath = "/dev/full";
+		c.mode = m;
+		c.bufferSize = 4;
+		c.dependencies = &b;
+
+		FileWriter w(c);
+		w << "There is no more room in the car.";
+
+		EXPECT_FALSE(w.Commit());
+		EXPECT_EQ(0, b.GetEntryCount());
+	}
+
+	std::filesystem::remove("file_failed_write_dependencies.txt");
+}
+
+#endif
@@ -0,0 +1,302 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	void GenerateSection(panini::Writer& writer)
+	{
+		using namespace panini;
+
+		writer << CommentBlock([](Writer& writer) {
+			writer << "Shaken, not stirred." << NextLine();
+			writer << NextLine();
+			writer << IndentPush() << "Twice." << IndentPop() << NextLine();
+		}) << NextLine();
+		writer << Scope("class Martini", [](Writer& writer) {
+			writer << Label("public") << NextLine();
+			writer << "int olives = " << std::to_string(2) << ";" << NextLine();
+			writer << Scope("void Shake()", [](Writer& writer) {
+				writer << CommentLine("gently") << NextLine();
+				writer << "olives += " << Braces([](Writer& writer) {
+					writer << "1";
+				}, BraceBreakingStyle::Attach) << ";" << NextLine();
+			}) << NextLine();
+		}) << ";" << NextLine();
+	}
+
+};
+
+TEST(FragmentWriter, Empty)
+{
+	using namespace panini;
+
+	Fragment f;
+	FragmentWriter w(f);
+
+	EXPECT_TRUE(w.IsOnNewLine());
+	EXPECT_TRUE(f.IsEmpty());
+	EXPECT_EQ(0, f.GetTextSize());
+
+	std::string t;
+	StringWriter s(t);
+	s << Splice(f);
+
+	EXPECT_STREQ("", t.c_str());
+}
+
+TEST(FragmentWriter, NoIndentationRecorded)
+{
+	using namespace panini;
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << IndentPush() << "one" << NextLine() << "two";
+
+	EXPECT_FALSE(f.IsEmpty());
+	EXPECT_EQ(6, f.GetTextSize());
+	EXPECT_FALSE(w.IsOnNewLine());
+
+	w << NextLine();
+	EXPECT_TRUE(w.IsOnNewLine());
+}
+
+TEST(FragmentWriter, SpliceAtIndentation)
+{
+	using namespace panini;
+
+	Fragment f;
+
+	{
+		FragmentWriter w(f);
+		w << "return x * x;" << NextLine();
+	}
+
+	std::string t;
+	StringWriter s(t);
+	s << "int square(int x)" << Braces([&f](Writer& writer) {
+		writer << Splice(f);
+	});
+
+	EXPECT_STREQ(R"(int square(int x)
+{
+	return x * x;
+})", t.c_str());
+}
+
+TEST(FragmentWriter, IdenticalToSerial)
+{
+	using namespace panini;
+
+	std::string e;
+	StringWriter ew(e);
+	ew << "namespace bar" << Braces([](Writer& writer) {
+		GenerateSection(writer);
+		writer << NextLine();
+		GenerateSection(writer);
+	});
+
+	Fragment f;
+	FragmentWriter fw(f);
+	GenerateSection(fw);
+
+	std::string t;
+	StringWriter tw(t);
+	tw << "namespace bar" << Braces([&f](Writer& writer) {
+		writer << Splice(f);
+		writer << NextLine();
+		writer << Splice(f);
+	});
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(FragmentWriter, IdenticalToSerialWithConfig)
+{
+	using namespace panini;
+
+	StringWriterConfig c;
+	c.braceBreakingStyle = BraceBreakingStyle::Whitesmiths;
+	c.chunkIndent = "  ";
+	c.chunkNewLine = "\r\n";
+
+	std::string e;
+	StringWriter ew(e, c);
+	ew << IndentPush() << IndentPush();
+	GenerateSection(ew);
+
+	FragmentWriterConfig fc;
+	fc.braceBreakingStyle = BraceBreakingStyle::Whitesmiths;
+
+	Fragment f;
+	FragmentWriter fw(f, fc);
+	GenerateSection(fw);
+
+	std::string t;
+	StringWriter tw(t, c);
+	tw << IndentPush() << IndentPush() << Splice(f);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(FragmentWriter, SpliceInCommentBlock)
+{
+	using namespace panini;
+
+	auto g = [](Writer& writer) {
+		writer << "Line" << NextLine() << NextLine() << IndentPush() << "Nested" << IndentPop() << NextLine();
+	};
+
+	std::string e;
+	StringWriter ew(e);
+	ew << CommentBlock(g);
+
+	Fragment f;
+	FragmentWriter fw(f);
+	g(fw);
+
+	std::string t;
+	StringWriter tw(t);
+	tw << CommentBlock([&f](Writer& writer) {
+		writer << Splice(f);
+	});
+
+	EXPECT_STREQ("/* Line\n *\n * \tNested\n\n */", t.c_str());
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(FragmentWriter, SpliceIntoFragment)
+{
+	using namespace panini;
+
+	Fragment i;
+	FragmentWriter iw(i);
+	iw << "inner" << NextLine();
+
+	Fragment o;
+	FragmentWriter ow(o);
+	ow << IndentPush() << Splice(i) << IndentPop() << "outer";
+
+	std::string t;
+	StringWriter tw(t);
+	tw << Splice(o);
+
+	EXPECT_STREQ("\tinner\nouter", t.c_str());
+}
+
+TEST(FragmentWriter, Clear)
+{
+	using namespace panini;
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << "Gone" << NextLine();
+
+	f.Clear();
+	EXPECT_TRUE(f.IsEmpty());
+
+	std::string t;
+	StringWriter s(t);
+	s << Splice(f);
+
+	EXPECT_STREQ("", t.c_str());
+}
+
+TEST(FragmentWriter, Serialize)
+{
+	using namespace panini;
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << "struct Gadget" << NextLine() << "{" << IndentPush() << NextLine();
+	w << CommentBlock([](Writer& w) {
+		w << "Go go" << NextLine() << "gadget";
+	}) << NextLine();
+	w << IndentPop() << "};";
+
+	std::string d;
+	f.Serialize(d);
+
+	Fragment l;
+	ASSERT_TRUE(l.Deserialize(d));
+	EXPECT_EQ(f.GetTextSize(), l.GetTextSize());
+
+	std::string e;
+	StringWriter ew(e);
+	ew << Splice(f);
+
+	std::string t;
+	StringWriter tw(t);
+	tw << Splice(l);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(FragmentWriter, DeserializeInvalid)
+{
+	using namespace panini;
+
+	Fragment f;
+	FragmentWriter w(f);
+	w << "Hello" << NextLine() << "World";
+
+	std::string d;
+	f.Serialize(d);
+
+	Fragment l;
+	EXPECT_FALSE(l.Deserialize(""));
+	EXPECT_FALSE(l.Deserialize(std::string_view(d).substr(0, d.size() - 1)));
+	EXPECT_FALSE(l.Deserialize(d + "!"));
+	EXPECT_TRUE(l.IsEmpty());
+
+	std::string c = d;
+	c[13] = 42;
+	EXPECT_FALSE(l.Deserialize(c));
+	EXPECT_TRUE(l.IsEmpty());
+}
+
+TEST(FragmentWriter, Align)
+{
+	using namespace panini;
+
+	Fragment f;
+
+	{
+		FragmentWriter w(f);
+		w << "Call(first," << NextLine();
+		w << AlignPush(5) << "second);" << AlignPop() << NextLine();
+	}
+
+	std::string d;
+	f.Serialize(d);
+
+	Fragment l;
+	ASSERT_TRUE(l.Deserialize(d));
+
+	std::string t;
+	StringWriter s(t);
+	s << IndentPush() << Splice(f) << Splice(l);
+
+	EXPECT_STREQ("\tCall(first,\n\t     second);\n\tCall(first,\n\t     second);\n", t.c_str());
+}
@@ -0,0 +1,212 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+TEST(GenerationJobs, Empty)
+{
+	using namespace panini;
+
+	GenerationJobs j;
+	EXPECT_EQ(0, j.GetJobCount());
+	EXPECT_TRUE(j.Run().empty());
+}
+
+TEST(GenerationJobs, ResultsInOrder)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "generation_jobs_order";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	GenerationJobs j;
+	for (int i = 0; i < 100; ++i)
+	{
+		j.Add(d / ("file" + std::to_string(i) + ".txt"), [i](Writer& w) {
+			w << "File " << std::to_string(i) << NextLine();
+		});
+	}
+	EXPECT_EQ(100, j.GetJobCount());
+
+	ThreadPool p(4);
+	const std::vector<GenerationJobResult>& r = j.Run(p);
+	ASSERT_EQ(100, r.size());
+
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(d / ("file" + std::to_string(i) + ".txt"), r[i].filePath);
+		EXPECT_EQ(GenerationJobStatus::Changed, r[i].status);
+		EXPECT_TRUE(r[i].error.empty());
+	}
+	EXPECT_EQ(100, j.GetResultCount(GenerationJobStatus::Changed));
+
+	std::ifstream f(d / "file42.txt", std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+	EXPECT_STREQ("File 42\n", ss.str().c_str());
+}
+
+TEST(GenerationJobs, ChangedAndUnchanged)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "generation_jobs_changed";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	std::ofstream f(d / "same.txt", std::ios::out | std::ios::binary);
+	f << "Stay gold";
+	f.close();
+
+	std::ofstream g(d / "other.txt", std::ios::out | std::ios::binary);
+	g << "Stay silver";
+	g.close();
+
+	GenerationJobs j;
+	j.Add(d / "same.txt", [](Writer& w) {
+		w << "Stay gold";
+	});
+	j.Add(d / "other.txt", [](Writer& w) {
+		w << "Stay gold";
+	});
+
+	const std::vector<GenerationJobResult>& r = j.Run();
+	ASSERT_EQ(2, r.size());
+	EXPECT_EQ(GenerationJobStatus::Unchanged, r[0].status);
+	EXPECT_EQ(GenerationJobStatus::Changed, r[1].status);
+	EXPECT_EQ(1, j.GetResultCount(GenerationJobStatus::Unchanged));
+	EXPECT_EQ(1, j.GetResultCount(GenerationJobStatus::Changed));
+
+	// running again finds both unchanged
+
+	j.Run();
+	EXPECT_EQ(2, j.GetResultCount(GenerationJobStatus::Unchanged));
+}
+
+TEST(GenerationJobs, FailedOnException)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "generation_jobs_exception";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	std::ofstream f(d / "keep.txt", std::ios::out | std::ios::binary);
+	f << "Untouched";
+	f.close();
+
+	GenerationJobs j;
+	j.Add(d / "keep.txt", [](Writer& w) {
+		w << "Half of it";
+		throw std::runtime_error("Out of ideas.");
+	});
+	j.Add(d / "next.txt", [](Writer& w) {
+		w << "Still here";
+	});
+
+	const std::vector<GenerationJobResult>& r = j.Run();
+	ASSERT_EQ(2, r.size());
+	EXPECT_EQ(GenerationJobStatus::Failed, r[0].status);
+	EXPECT_STREQ("Out of ideas.", r[0].error.c_str());
+	EXPECT_EQ(GenerationJobStatus::Changed, r[1].status);
+	EXPECT_EQ(1, j.GetResultCount(GenerationJobStatus::Failed));
+
+	std::ifstream k(d / "keep.txt", std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << k.rdbuf();
+	EXPECT_STREQ("Untouched", ss.str().c_str());
+}
+
+TEST(GenerationJobs, FailedToWrite)
+{
+	using namespace panini;
+
+	GenerationJobs j;
+	j.Add("generation_jobs_missing/directory/file.txt", [](Writer& w) {
+		w << "Nowhere to go";
+	});
+
+	const std::vector<GenerationJobResult>& r = j.Run();
+	ASSERT_EQ(1, r.size());
+	EXPECT_EQ(GenerationJobStatus::Failed, r[0].status);
+	EXPECT_FALSE(r[0].error.empty());
+}
+
+TEST(GenerationJobs, Manifest)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "generation_jobs_manifest";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	OutputManifest m(d / "manifest.txt");
+
+	CompareWriterConfig c;
+	c.manifest = &m;
+
+	GenerationJobs j(c);
+	for (int i = 0; i < 10; ++i)
+	{
+		j.Add(d / ("file" + std::to_string(i) + ".txt"), [i](Writer& w) {
+			w << "Manifest " << std::to_string(i);
+		});
+	}
+
+	j.Run();
+	EXPECT_EQ(10, j.GetResultCount(GenerationJobStatus::Changed));
+	EXPECT_EQ(10, m.GetEntryCount());
+}
+
+TEST(GenerationJobs, RunFromTask)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "generation_jobs_task";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	GenerationJobs j;
+	for (int i = 0; i < 10; ++i)
+	{
+		j.Add(d / ("file" + std::to_string(i) + ".txt"), [i](Writer& w) {
+			w << "Task " << std::to_string(i);
+		});
+	}
+
+	ThreadPool p(2);
+	ThreadPool::TaskGroup g;
+
+	p.Submit([] {
+		throw std::runtime_error("Unrelated.");
+	});
+
+	p.Submit(g, [&j, &p] {
+		j.Run(p);
+	});
+
+	p.Wait(g);
+
+	EXPECT_EQ(10, j.GetResultCount(GenerationJobStatus::Changed));
+	EXPECT_THROW(p.Wait(), std::runtime_error);
+}
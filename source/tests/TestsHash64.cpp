@@ -0,0 +1,93 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+TEST(Hash64, Empty)
+{
+	using namespace panini;
+
+	Hash64 h;
+
+	EXPECT_EQ(uint64_t{ 0xEF46DB3751D8E999 }, h.GetDigest());
+	EXPECT_EQ(uint64_t{ 0 }, h.GetSize());
+}
+
+TEST(Hash64, ShortInput)
+{
+	using namespace panini;
+
+	EXPECT_EQ(uint64_t{ 0xD24EC4F1A98C6E5B }, Hash64::Compute("a"));
+	EXPECT_EQ(uint64_t{ 0x44BC2CF5AD770999 }, Hash64::Compute("abc"));
+}
+
+TEST(Hash64, LongInput)
+{
+	using namespace panini;
+
+	EXPECT_EQ(uint64_t{ 0xFBCEA83C8A378BF1 }, Hash64::Compute("Nobody inspects the spammish repetition"));
+}
+
+TEST(Hash64, Incremental)
+{
+	using namespace panini;
+
+	std::string t;
+	for (int i = 0; i < 100; ++i)
+	{
+		t += "Chunk " + std::to_string(i) + ";";
+	}
+
+	Hash64 h;
+	for (size_t i = 0; i < t.size(); i += 7)
+	{
+		h.Update(std::string_view(t).substr(i, 7));
+	}
+
+	EXPECT_EQ(Hash64::Compute(t), h.GetDigest());
+	EXPECT_EQ(t.size(), h.GetSize());
+}
+
+TEST(Hash64, Reset)
+{
+	using namespace panini;
+
+	Hash64 h;
+	h.Update("Discarded");
+	h.Reset();
+	h.Update("abc");
+
+	EXPECT_EQ(uint64_t{ 0x44BC2CF5AD770999 }, h.GetDigest());
+}
+
+TEST(Hash64, UpdateEmpty)
+{
+	using namespace panini;
+
+	Hash64 h;
+	h.Update("ab");
+	h.Update(std::string_view());
+	h.Update("c");
+
+	EXPECT_EQ(uint64_t{ 0x44BC2CF5AD770999 }, h.GetDigest());
+	EXPECT_EQ(3, h.GetSize());
+}
@@ -0,0 +1,100 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+TEST(HashWriter, Empty)
+{
+	using namespace panini;
+
+	HashWriter w;
+
+	EXPECT_EQ(Hash64::Compute(""), w.GetDigest());
+	EXPECT_EQ(uint64_t{ 0 }, w.GetByteCount());
+	EXPECT_EQ(uint64_t{ 0 }, w.GetLineCount());
+}
+
+TEST(HashWriter, Write)
+{
+	using namespace panini;
+
+	HashWriter w;
+	w << "Wowsers!";
+
+	EXPECT_EQ(Hash64::Compute("Wowsers!"), w.GetDigest());
+	EXPECT_EQ(uint64_t{ 8 }, w.GetByteCount());
+	EXPECT_EQ(uint64_t{ 1 }, w.GetLineCount());
+}
+
+TEST(HashWriter, LineCount)
+{
+	using namespace panini;
+
+	HashWriter w;
+	w << "First" << NextLine();
+
+	EXPECT_EQ(uint64_t{ 1 }, w.GetLineCount());
+
+	w << NextLine() << "Third";
+
+	EXPECT_EQ(uint64_t{ 3 }, w.GetLineCount());
+}
+
+TEST(HashWriter, SameAsStringWriter)
+{
+	using namespace panini;
+
+	auto generate = [](Writer& w) {
+		w << Scope("class Gadget", [](Writer& w) {
+			w << "public:" << NextLine();
+			w << IndentPush() << "void Go(const char* what);" << NextLine() << IndentPop();
+		}) << ";" << NextLine();
+	};
+
+	WriterConfig c;
+	c.chunkNewLine = "\r\n";
+
+	std::string t;
+	StringWriter sw(t, StringWriterConfig{ c });
+	generate(sw);
+
+	HashWriter w(HashWriterConfig{ c });
+	generate(w);
+
+	EXPECT_EQ(Hash64::Compute(t), w.GetDigest());
+	EXPECT_EQ(t.size(), w.GetByteCount());
+	EXPECT_EQ(uint64_t{ 5 }, w.GetLineCount());
+}
+
+TEST(HashWriter, Seed)
+{
+	using namespace panini;
+
+	HashWriterConfig c;
+	c.seed = 1337;
+
+	HashWriter w(c);
+	w << "Penny";
+
+	EXPECT_EQ(Hash64::Compute("Penny", 1337), w.GetDigest());
+	EXPECT_NE(Hash64::Compute("Penny"), w.GetDigest());
+}
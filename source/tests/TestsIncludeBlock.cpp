@@ -56,3 +56,58 @@ TEST(IncludeBlock, Entries)
 #include "game/systems/Particles.h"
 #include "game/Physics.h")", t.c_str());
 }
+
+TEST(IncludeBlock, VisitTwice)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Ocean.h");
+	s.Add("Reef/Coral.h");
+	s.Add("string", IncludeStyle::AngularBrackets);
+
+	IncludeBlock b(s);
+
+	std::string t;
+	StringWriter w(t);
+
+	b.Visit(w);
+	w << NextLine();
+	b.Visit(w);
+
+	EXPECT_STREQ(R"(#include <string>
+#include "Reef/Coral.h"
+#include "Ocean.h"
+#include <string>
+#include "Reef/Coral.h"
+#include "Ocean.h")", t.c_str());
+}
+
+TEST(IncludeBlock, VisitWithDifferentStyles)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Ocean.h");
+	s.Add("string", IncludeStyle::DoubleQuotes);
+
+	IncludeBlock b(s);
+
+	std::string t;
+	StringWriter w(t);
+
+	b.Visit(w);
+
+	StringWriterConfig c;
+	c.includeStyle = IncludeStyle::AngularBrackets;
+
+	std::string u;
+	StringWriter v(u, c);
+
+	b.Visit(v);
+
+	EXPECT_STREQ(R"(#include "Ocean.h"
+#include "string")", t.c_str());
+	EXPECT_STREQ(R"(#include <Ocean.h>
+#include "string")", u.c_str());
+}
@@ -0,0 +1,237 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+#include <thread>
+
+TEST(IncludePathPool, Empty)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	EXPECT_EQ(size_t{ 0 }, p.GetCount());
+	EXPECT_FALSE(p.Find("Frog.h").IsValid());
+}
+
+TEST(IncludePathPool, Intern)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludePath a = p.Intern("Pond/Frog.h");
+	IncludePath b = p.Intern("Pond/Frog.h");
+	IncludePath c = p.Intern("Pond/Toad.h");
+
+	EXPECT_EQ(size_t{ 2 }, p.GetCount());
+	EXPECT_TRUE(a.IsValid());
+	EXPECT_TRUE(a == b);
+	EXPECT_TRUE(a != c);
+	EXPECT_TRUE(a == p.Find("Pond/Frog.h"));
+	EXPECT_STREQ("Pond/Frog.h", a.GetString().c_str());
+	EXPECT_STREQ("Pond/Frog.h", a.GetPath().string().c_str());
+	EXPECT_EQ(1, a.GetDepth());
+	EXPECT_EQ(std::filesystem::hash_value(std::filesystem::path("Pond/Frog.h")), a.GetHash());
+}
+
+TEST(IncludePathPool, InternEquivalentPaths)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludePath a = p.Intern("Pond/Frog.h");
+	IncludePath b = p.Intern("Pond//Frog.h");
+
+	EXPECT_EQ(size_t{ 1 }, p.GetCount());
+	EXPECT_TRUE(a == b);
+}
+
+TEST(IncludePathPool, Lines)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludePath a = p.Intern("Pond/Frog.h");
+
+	EXPECT_EQ("#include \"Pond/Frog.h\"", a.GetLine(IncludeStyle::DoubleQuotes));
+	EXPECT_EQ("#include 'Pond/Frog.h'", a.GetLine(IncludeStyle::SingleQuotes));
+	EXPECT_EQ("#include <Pond/Frog.h>", a.GetLine(IncludeStyle::AngularBrackets));
+	EXPECT_EQ("", a.GetLine(IncludeStyle::Inherit));
+}
+
+TEST(IncludePathPool, EmptyHandle)
+{
+	using namespace panini;
+
+	IncludePath a;
+
+	EXPECT_FALSE(a.IsValid());
+	EXPECT_TRUE(a.GetPath().empty());
+	EXPECT_TRUE(a.GetString().empty());
+	EXPECT_EQ("", a.GetLine(IncludeStyle::DoubleQuotes));
+	EXPECT_EQ(0, a.GetDepth());
+}
+
+TEST(IncludePathPool, InternFromThreads)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	std::vector<std::vector<IncludePath>> h(4);
+	std::vector<std::thread> t;
+
+	for (size_t i = 0; i < h.size(); ++i)
+	{
+		t.emplace_back([&p, &r = h[i]]() {
+			for (int j = 0; j < 500; ++j)
+			{
+				r.push_back(p.Intern("Pond/Lily" + std::to_string(j) + ".h"));
+			}
+		});
+	}
+
+	for (std::thread& thread : t)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(size_t{ 500 }, p.GetCount());
+
+	for (size_t i = 1; i < h.size(); ++i)
+	{
+		EXPECT_TRUE(h[0] == h[i]);
+	}
+}
+
+TEST(IncludePathPool, IncludeSet)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludeSet s(p);
+	s.Add("Pond/Frog.h");
+	s.Add("Pond/Frog.h");
+	s.Add("vector", IncludeStyle::AngularBrackets);
+	s.Add(p.Intern("Pond/Frog.h"), IncludeStyle::AngularBrackets);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_EQ(size_t{ 2 }, p.GetCount());
+	EXPECT_TRUE(e[0].interned == p.Find("Pond/Frog.h"));
+	EXPECT_TRUE(e[0].path.empty());
+	EXPECT_STREQ("Pond/Frog.h", e[0].GetPath().string().c_str());
+	EXPECT_STREQ("vector", e[1].GetString().c_str());
+}
+
+TEST(IncludePathPool, IncludeSetMixed)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludeSet s;
+	s.Add("Pond/Frog.h");
+	s.Add(p.Intern("Pond/Frog.h"));
+	s.Add(p.Intern("Lily.h"));
+	s.Add("Lily.h");
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 2 }, e.size());
+	EXPECT_FALSE(e[0].interned.IsValid());
+	EXPECT_TRUE(e[1].interned.IsValid());
+}
+
+TEST(IncludePathPool, IncludeSetModified)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludeSet s(p);
+	s.Add("Frog.h");
+	s.Add("Toad.h");
+
+	for (IncludeEntry& entry : s)
+	{
+		if (entry.GetPath() == "Frog.h")
+		{
+			entry.path = "Pond/Frog.h";
+		}
+	}
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 2 }, e.size());
+	EXPECT_STREQ("Pond/Frog.h", e[0].GetPath().generic_string().c_str());
+	EXPECT_FALSE(e[0].interned.IsValid());
+	EXPECT_STREQ("Toad.h", e[1].GetPath().string().c_str());
+	EXPECT_TRUE(e[1].interned.IsValid());
+}
+
+TEST(IncludePathPool, IncludeBlock)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	IncludeSet s(p);
+	s.Add("game/systems/Audio.h");
+	s.Add("game/Physics.h");
+	s.Add("game/systems/Particles.h");
+	s.Add("stdio.h", IncludeStyle::AngularBrackets);
+
+	std::string t;
+	StringWriter w(t);
+
+	w << IncludeBlock(s);
+
+	EXPECT_STREQ(R"(#include <stdio.h>
+#include "game/systems/Audio.h"
+#include "game/systems/Particles.h"
+#include "game/Physics.h")", t.c_str());
+}
+
+TEST(IncludePathPool, Include)
+{
+	using namespace panini;
+
+	IncludePathPool p;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << Include(p.Intern("Pond/Frog.h")) << NextLine();
+	w << Include(p.Intern("vector"), IncludeStyle::AngularBrackets);
+
+	EXPECT_STREQ(R"(#include "Pond/Frog.h"
+#include <vector>)", t.c_str());
+}
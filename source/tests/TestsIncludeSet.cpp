@@ -206,3 +206,208 @@ TEST(IncludeSet, SortWithInheritIsInvalid)
 	EXPECT_STREQ("Aquarium/Reef.h", e[1].path.string().c_str());
 	EXPECT_STREQ("Aquarium/Clownfish.h", e[2].path.string().c_str());
 }
+
+TEST(IncludeSet, AddDuplicatesAfterSort)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Water.h", IncludeStyle::DoubleQuotes);
+	s.Add("Aquarium/Reef.h", IncludeStyle::DoubleQuotes);
+	s.Add("vector", IncludeStyle::AngularBrackets);
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	s.Add("Water.h", IncludeStyle::DoubleQuotes);
+	s.Add("vector", IncludeStyle::AngularBrackets);
+	s.Add("vector", IncludeStyle::DoubleQuotes);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 4 }, e.size());
+	EXPECT_STREQ("vector", e[0].path.string().c_str());
+	EXPECT_STREQ("Aquarium/Reef.h", e[1].path.string().c_str());
+	EXPECT_STREQ("Water.h", e[2].path.string().c_str());
+	EXPECT_STREQ("vector", e[3].path.string().c_str());
+	EXPECT_EQ(IncludeStyle::DoubleQuotes, e[3].style);
+}
+
+TEST(IncludeSet, AddDuplicatesAfterModified)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Fish.h");
+	s.Add("Shark.h");
+
+	for (IncludeEntry& entry : s)
+	{
+		entry.path = "Ocean" / entry.path;
+	}
+
+	s.Add("Ocean/Fish.h");
+	s.Add("Fish.h");
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_STREQ("Ocean/Fish.h", e[0].path.generic_string().c_str());
+	EXPECT_STREQ("Ocean/Shark.h", e[1].path.generic_string().c_str());
+	EXPECT_STREQ("Fish.h", e[2].path.string().c_str());
+}
+
+TEST(IncludeSet, AddEquivalentPaths)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Engine/Physics.h");
+	s.Add("Engine//Physics.h");
+
+	ASSERT_EQ(size_t{ 1 }, s.GetEntries().size());
+	EXPECT_STREQ("Engine/Physics.h", s.GetEntries()[0].path.string().c_str());
+}
+
+TEST(IncludeSet, AddMany)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	for (int r = 0; r < 2; ++r)
+	{
+		for (int i = 0; i < 5000; ++i)
+		{
+			s.Add("Component" + std::to_string(i) + ".h", IncludeStyle::DoubleQuotes);
+		}
+	}
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 5000 }, e.size());
+	EXPECT_STREQ("Component0.h", e[0].path.string().c_str());
+	EXPECT_STREQ("Component4999.h", e[4999].path.string().c_str());
+}
+
+TEST(IncludeSet, SortSeparatorBeforeCharacters)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Pond-Deep/Frog.h");
+	s.Add("Pond/Frog.h");
+	s.Add("Pond.Old/Frog.h");
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_STREQ("Pond/Frog.h", e[0].path.string().c_str());
+	EXPECT_STREQ("Pond-Deep/Frog.h", e[1].path.string().c_str());
+	EXPECT_STREQ("Pond.Old/Frog.h", e[2].path.string().c_str());
+}
+
+TEST(IncludeSet, SortTwice)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Water.h");
+	s.Add("vector", IncludeStyle::AngularBrackets);
+	s.Add("Aquarium/Reef.h");
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_STREQ("vector", e[0].path.string().c_str());
+	EXPECT_STREQ("Aquarium/Reef.h", e[1].path.string().c_str());
+	EXPECT_STREQ("Water.h", e[2].path.string().c_str());
+
+	s.Sort(IncludeStyle::AngularBrackets);
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_STREQ("Aquarium/Reef.h", e[0].path.string().c_str());
+	EXPECT_STREQ("Water.h", e[1].path.string().c_str());
+	EXPECT_STREQ("vector", e[2].path.string().c_str());
+}
+
+TEST(IncludeSet, SortAfterAdd)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Water.h");
+	s.Add("Sand.h");
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	s.Add("Aquarium/Reef.h");
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_STREQ("Aquarium/Reef.h", e[0].path.string().c_str());
+	EXPECT_STREQ("Sand.h", e[1].path.string().c_str());
+	EXPECT_STREQ("Water.h", e[2].path.string().c_str());
+}
+
+TEST(IncludeSet, SortAfterModified)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Water.h");
+	s.Add("Sand.h");
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	for (IncludeEntry& entry : s)
+	{
+		if (entry.path == "Water.h")
+		{
+			entry.path = "Aquarium/Water.h";
+		}
+	}
+
+	s.Sort(IncludeStyle::DoubleQuotes);
+
+	auto& e = s.GetEntries();
+
+	ASSERT_EQ(size_t{ 2 }, e.size());
+	EXPECT_STREQ("Aquarium/Water.h", e[0].path.generic_string().c_str());
+	EXPECT_STREQ("Aquarium/Water.h", e[0].pathString.c_str());
+	EXPECT_EQ(1, e[0].depth);
+	EXPECT_STREQ("Sand.h", e[1].path.string().c_str());
+}
+
+TEST(IncludeSet, Copy)
+{
+	using namespace panini;
+
+	IncludeSet s;
+	s.Add("Water.h");
+	s.Add("Sand.h");
+
+	IncludeSet c = s;
+	c.Add("Water.h");
+	c.Add("Aquarium/Reef.h");
+
+	ASSERT_EQ(size_t{ 2 }, s.GetEntries().size());
+
+	auto& e = c.GetEntries();
+
+	ASSERT_EQ(size_t{ 3 }, e.size());
+	EXPECT_STREQ("Water.h", e[0].path.string().c_str());
+	EXPECT_STREQ("Sand.h", e[1].path.string().c_str());
+	EXPECT_STREQ("Aquarium/Reef.h", e[2].path.string().c_str());
+
+	s = c;
+	s.Add("Sand.h");
+
+	ASSERT_EQ(size_t{ 3 }, s.GetEntries().size());
+}
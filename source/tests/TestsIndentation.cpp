@@ -113,3 +113,122 @@ TEST(Indentation, Config)
   }
 var done = true;)", t.c_str());
 }
+
+TEST(Indentation, Deep)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	for (int i = 0; i < 300; ++i)
+	{
+		w << IndentPush();
+	}
+
+	w << "Deep" << NextLine();
+
+	for (int i = 0; i < 299; ++i)
+	{
+		w << IndentPop();
+	}
+
+	w << "Shallow";
+
+	EXPECT_EQ(std::string(300, '\t') + "Deep\n\tShallow", t);
+}
+
+TEST(Indentation, Align)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << IndentPush() << "Call(first," << NextLine();
+	w << AlignPush(5) << "second," << NextLine();
+	w << AlignPush(2) << "third)" << NextLine();
+	w << AlignPop() << AlignPop() << "done";
+
+	EXPECT_STREQ("\tCall(first,\n\t     second,\n\t       third)\n\tdone", t.c_str());
+}
+
+TEST(Indentation, AlignWithoutIndentation)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << AlignPush(3) << "a" << NextLine() << "b" << AlignPop() << NextLine() << "c";
+
+	EXPECT_STREQ("   a\n   b\nc", t.c_str());
+}
+
+TEST(Indentation, AlignPopOnly)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << AlignPop() << "a";
+
+	EXPECT_STREQ("a", t.c_str());
+}
+
+TEST(Indentation, AlignDeep)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << IndentPush() << AlignPush(200) << "a" << NextLine();
+	w << IndentPush() << AlignPush(100) << "b";
+
+	EXPECT_EQ("\t" + std::string(200, ' ') + "a\n\t\t" + std::string(300, ' ') + "b", t);
+}
+
+TEST(Indentation, AlignConfig)
+{
+	using namespace panini;
+
+	StringWriterConfig c;
+	c.chunkIndent = "  ";
+
+	std::string t;
+	StringWriter w(t, c);
+
+	w << IndentPush() << IndentPush() << AlignPush(1) << "a";
+
+	EXPECT_STREQ("     a", t.c_str());
+}
+
+TEST(Indentation, AlignInCommentBlock)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << IndentPush() << AlignPush(2);
+	w.SetIsInCommentBlock(true);
+	w << IndentPush() << "a" << NextLine();
+	w.SetIsInCommentBlock(false);
+	w << "b";
+
+	EXPECT_STREQ("\t * \t  a\n\t  b", t.c_str());
+}
+
+TEST(Indentation, Label)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << IndentPush() << IndentPush() << Label("public") << NextLine() << "int a;";
+
+	EXPECT_STREQ("\tpublic:\n\t\tint a;", t.c_str());
+}
@@ -0,0 +1,271 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+#include <thread>
+
+#include "TestFiles.hpp"
+
+using panini::tests::ReadFile;
+using panini::tests::WaitForClock;
+using panini::tests::WriteFile;
+
+TEST(OutputManifest, MissingFile)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_missing.txt");
+
+	OutputManifest m("manifest_missing.txt");
+
+	EXPECT_EQ(size_t{ 0 }, m.GetEntryCount());
+	EXPECT_FALSE(m.IsCorrupted());
+}
+
+TEST(OutputManifest, SaveAndLoad)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_save.txt");
+	WriteFile("manifest_save_output.txt", "Hello, World!");
+
+	{
+		OutputManifest m("manifest_save.txt");
+		m.Update("manifest_save_output.txt", 13, Hash64::Compute("Hello, World!"));
+
+		EXPECT_EQ(size_t{ 1 }, m.GetEntryCount());
+
+		WaitForClock();
+	}
+
+	OutputManifest m("manifest_save.txt");
+
+	EXPECT_FALSE(m.IsCorrupted());
+	EXPECT_EQ(size_t{ 1 }, m.GetEntryCount());
+
+	OutputManifestEntry e;
+	EXPECT_TRUE(m.Find("manifest_save_output.txt", e));
+	EXPECT_EQ(uint64_t{ 13 }, e.size);
+	EXPECT_EQ(Hash64::Compute("Hello, World!"), e.hash);
+}
+
+TEST(OutputManifest, UpdateWrongSize)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_wrong_size.txt");
+	WriteFile("manifest_wrong_size_output.txt", "Short");
+
+	OutputManifest m("manifest_wrong_size.txt");
+	m.Update("manifest_wrong_size_output.txt", 99, 0);
+
+	EXPECT_EQ(size_t{ 0 }, m.GetEntryCount());
+}
+
+TEST(OutputManifest, RecentEntryIsNotTrusted)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_recent.txt");
+	WriteFile("manifest_recent_output.txt", "Racy");
+
+	OutputManifest m("manifest_recent.txt");
+	m.Update("manifest_recent_output.txt", 4, Hash64::Compute("Racy"));
+
+	OutputManifestEntry e;
+	EXPECT_FALSE(m.Find("manifest_recent_output.txt", e));
+}
+
+TEST(OutputManifest, StaleModifiedTime)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_stale.txt");
+	WriteFile("manifest_stale_output.txt", "Before");
+
+	{
+		OutputManifest m("manifest_stale.txt");
+		m.Update("manifest_stale_output.txt", 6, Hash64::Compute("Before"));
+
+		WaitForClock();
+	}
+
+	// same size, different contents
+
+	WriteFile("manifest_stale_output.txt", "Behind");
+	std::filesystem::last_write_time(
+		"manifest_stale_output.txt",
+		std::filesystem::last_write_time("manifest_stale.txt") + std::chrono::seconds(1));
+
+	OutputManifest m("manifest_stale.txt");
+
+	OutputManifestEntry e;
+	EXPECT_FALSE(m.Find("manifest_stale_output.txt", e));
+}
+
+TEST(OutputManifest, Corrupted)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_corrupted.txt");
+	WriteFile("manifest_corrupted_output.txt", "Intact");
+
+	{
+		OutputManifest m("manifest_corrupted.txt");
+		m.Update("manifest_corrupted_output.txt", 6, Hash64::Compute("Intact"));
+	}
+
+	std::string t = ReadFile("manifest_corrupted.txt");
+	t[t.find(' ') + 1] = '7';
+	WriteFile("manifest_corrupted.txt", t);
+
+	OutputManifest m("manifest_corrupted.txt");
+
+	EXPECT_TRUE(m.IsCorrupted());
+	EXPECT_EQ(size_t{ 0 }, m.GetEntryCount());
+}
+
+TEST(OutputManifest, Truncated)
+{
+	using namespace panini;
+
+	WriteFile("manifest_truncated.txt", "panini-manifest 1\n0123");
+
+	OutputManifest m("manifest_truncated.txt");
+
+	EXPECT_TRUE(m.IsCorrupted());
+	EXPECT_EQ(size_t{ 0 }, m.GetEntryCount());
+}
+
+TEST(OutputManifest, CompareWriterSkipsUnchanged)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_compare.txt");
+
+	CompareWriterConfig c;
+	c.filePath = "manifest_compare_output.txt";
+	std::filesystem::remove(c.filePath);
+
+	{
+		OutputManifest m("manifest_compare.txt");
+		c.manifest = &m;
+
+		CompareWriter w(c);
+		w << "Trust me";
+		EXPECT_TRUE(w.Commit());
+
+		EXPECT_EQ(size_t{ 1 }, m.GetEntryCount());
+
+		WaitForClock();
+	}
+
+	OutputManifest m("manifest_compare.txt");
+	c.manifest = &m;
+
+	CompareWriter w(c);
+	w << "Trust";
+	EXPECT_TRUE(w.IsChanged());
+	w << " me";
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_FALSE(w.Commit());
+}
+
+TEST(OutputManifest, CompareWriterCommitsChanged)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_compare_changed.txt");
+
+	CompareWriterConfig c;
+	c.filePath = "manifest_compare_changed_output.txt";
+	WriteFile(c.filePath, "Old output");
+
+	{
+		OutputManifest m("manifest_compare_changed.txt");
+		c.manifest = &m;
+
+		CompareWriter w(c);
+		w << "Old output";
+		EXPECT_FALSE(w.Commit());
+
+		EXPECT_EQ(size_t{ 1 }, m.GetEntryCount());
+
+		WaitForClock();
+	}
+
+	{
+		OutputManifest m("manifest_compare_changed.txt");
+		c.manifest = &m;
+
+		CompareWriter w(c);
+		w << "New output";
+		EXPECT_TRUE(w.IsChanged());
+		EXPECT_TRUE(w.Commit());
+		EXPECT_FALSE(w.IsChanged());
+
+		OutputManifestEntry e;
+		EXPECT_FALSE(m.Find(c.filePath, e));
+	}
+
+	EXPECT_STREQ("New output", ReadFile(c.filePath).c_str());
+}
+
+TEST(OutputManifest, CompareWriterStaleEntry)
+{
+	using namespace panini;
+
+	std::filesystem::remove("manifest_compare_stale.txt");
+
+	CompareWriterConfig c;
+	c.filePath = "manifest_compare_stale_output.txt";
+	WriteFile(c.filePath, "Generated");
+
+	{
+		OutputManifest m("manifest_compare_stale.txt");
+		c.manifest = &m;
+
+		CompareWriter w(c);
+		w << "Generated";
+		EXPECT_FALSE(w.Commit());
+
+		WaitForClock();
+	}
+
+	// modified by hand after the manifest was saved
+
+	WriteFile(c.filePath, "Hand-made");
+	std::filesystem::last_write_time(
+		c.filePath,
+		std::filesystem::last_write_time("manifest_compare_stale.txt") + std::chrono::seconds(1));
+
+	OutputManifest m("manifest_compare_stale.txt");
+	c.manifest = &m;
+
+	CompareWriter w(c);
+	w << "Generated";
+	EXPECT_TRUE(w.IsChanged());
+	EXPECT_TRUE(w.Commit());
+
+	EXPECT_STREQ("Generated", ReadFile(c.filePath).c_str());
+}
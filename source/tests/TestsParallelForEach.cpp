@@ -0,0 +1,312 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	void GenerateTable(panini::Writer& writer, const std::string& name, size_t index)
+	{
+		using namespace panini;
+
+		writer << Scope("struct " + name, [index](Writer& writer) {
+			writer << "int id = " << std::to_string(index) << ";" << NextLine();
+			writer << CommentLine("columns") << NextLine();
+		}) << ";" << NextLine();
+	}
+
+	std::vector<std::string> MakeNames(size_t count)
+	{
+		std::vector<std::string> names;
+		for (size_t i = 0; i < count; ++i)
+		{
+			names.push_back("Table" + std::to_string(i));
+		}
+
+		return names;
+	}
+
+};
+
+TEST(ParallelForEach, Empty)
+{
+	using namespace panini;
+
+	std::vector<std::string> n;
+
+	std::string t;
+	StringWriter w(t);
+	w << ParallelForEach(n.begin(), n.end(), [](Writer& writer, const std::string& name, size_t index) {
+		GenerateTable(writer, name, index);
+	});
+
+	EXPECT_STREQ("", t.c_str());
+}
+
+TEST(ParallelForEach, IdenticalToSerial)
+{
+	using namespace panini;
+
+	std::vector<std::string> n = MakeNames(100);
+
+	std::string e;
+	StringWriter ew(e);
+	ew << "namespace Schema" << Braces([&n](Writer& writer) {
+		for (size_t i = 0; i < n.size(); ++i)
+		{
+			GenerateTable(writer, n[i], i);
+		}
+	});
+
+	ThreadPool p(4);
+
+	ParallelForEachOptions o;
+	o.pool = &p;
+	o.itemsPerTask = 3;
+
+	std::string t;
+	StringWriter tw(t);
+	tw << "namespace Schema" << Braces([&n, &o](Writer& writer) {
+		writer << ParallelForEach(n.begin(), n.end(), [](Writer& writer, const std::string& name, size_t index) {
+			GenerateTable(writer, name, index);
+		}, o);
+	});
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(ParallelForEach, InheritConfig)
+{
+	using namespace panini;
+
+	std::vector<std::string> n = MakeNames(10);
+
+	StringWriterConfig c;
+	c.braceBreakingStyle = BraceBreakingStyle::Attach;
+	c.chunkIndent = "    ";
+
+	std::string e;
+	StringWriter ew(e, c);
+	ew << IndentPush();
+	for (size_t i = 0; i < n.size(); ++i)
+	{
+		GenerateTable(ew, n[i], i);
+	}
+
+	ParallelForEachOptions o;
+	o.itemsPerTask = 1;
+
+	std::string t;
+	StringWriter tw(t, c);
+	tw << IndentPush() << ParallelForEach(n.begin(), n.end(), [](Writer& writer, const std::string& name, size_t index) {
+		GenerateTable(writer, name, index);
+	}, o);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(ParallelForEach, Separators)
+{
+	using namespace panini;
+
+	std::vector<int> v = { 1, 2, 3, 4, 5 };
+
+	ParallelForEachOptions o;
+	o.chunkBeginSeparator = "[";
+	o.chunkEndSeparator = "],";
+	o.addNewLines = true;
+	o.skipLastItemEndSeparator = false;
+	o.itemsPerTask = 2;
+
+	std::string t;
+	StringWriter w(t);
+	w << "values = " << IndentPush() << ParallelForEach(v.begin(), v.end(), [](Writer& writer, int value, size_t) {
+		writer << std::to_string(value);
+	}, o) << IndentPop();
+
+	EXPECT_STREQ(R"(values = [1],
+	[2],
+	[3],
+	[4],
+	[5],)", t.c_str());
+}
+
+TEST(ParallelForEach, MatchCommaList)
+{
+	using namespace panini;
+
+	std::vector<int> v = { 8, 6, 7, 5, 3, 0, 9 };
+
+	CommaListOptions co;
+	co.chunkBeginSeparator = "'";
+	co.chunkEndSeparator = "' ";
+	co.skipFirstItemBeginSeparator = true;
+
+	std::string e;
+	StringWriter ew(e);
+	ew << CommaList(v.begin(), v.end(), co);
+
+	ParallelForEachOptions o;
+	o.chunkBeginSeparator = "'";
+	o.chunkEndSeparator = "' ";
+	o.skipFirstItemBeginSeparator = true;
+	o.itemsPerTask = 2;
+
+	std::string t;
+	StringWriter tw(t);
+	tw << ParallelForEach(v.begin(), v.end(), [](Writer& writer, int value, size_t) {
+		writer << std::to_string(value);
+	}, o);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(ParallelForEach, StartOfLineDependent)
+{
+	using namespace panini;
+
+	std::vector<std::string> n = { "a", "b", "c", "d" };
+
+	// items that don't end on a new line, followed by braces that break
+	// differently depending on the line
+
+	auto g = [](Writer& writer, const std::string& name, size_t) {
+		writer << Braces([&name](Writer& writer) {
+			writer << name << NextLine();
+		}) << " ";
+	};
+
+	std::string e;
+	StringWriter ew(e);
+	for (size_t i = 0; i < n.size(); ++i)
+	{
+		g(ew, n[i], i);
+	}
+
+	ParallelForEachOptions o;
+	o.itemsPerTask = 1;
+
+	std::string t;
+	StringWriter tw(t);
+	tw << ParallelForEach(n.begin(), n.end(), g, o);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(ParallelForEach, RethrowException)
+{
+	using namespace panini;
+
+	std::vector<int> v = { 1, 2, 3, 4 };
+
+	ParallelForEachOptions o;
+	o.itemsPerTask = 1;
+
+	std::string t;
+	StringWriter w(t);
+	EXPECT_THROW(w << ParallelForEach(v.begin(), v.end(), [](Writer& writer, int value, size_t) {
+		if (value == 3)
+		{
+			throw std::runtime_error("Three is a crowd.");
+		}
+
+		writer << std::to_string(value);
+	}, o), std::runtime_error);
+}
+
+TEST(ParallelForEach, InsideGenerationJob)
+{
+	using namespace panini;
+
+	std::vector<std::string> n = MakeNames(20);
+
+	std::string e;
+	StringWriter ew(e);
+	for (size_t i = 0; i < n.size(); ++i)
+	{
+		GenerateTable(ew, n[i], i);
+	}
+
+	std::filesystem::path d = "parallel_for_each_job";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	ThreadPool p(2);
+
+	GenerationJobs j;
+	j.Add(d / "tables.hpp", [&n, &p](Writer& writer) {
+		ParallelForEachOptions o;
+		o.pool = &p;
+		o.itemsPerTask = 4;
+
+		writer << ParallelForEach(n.begin(), n.end(), [](Writer& writer, const std::string& name, size_t index) {
+			GenerateTable(writer, name, index);
+		}, o);
+	});
+	j.Run(p);
+
+	ASSERT_EQ(GenerationJobStatus::Changed, j.GetResults()[0].status);
+
+	std::ifstream f(d / "tables.hpp", std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+	EXPECT_STREQ(e.c_str(), ss.str().c_str());
+}
+
+TEST(ParallelForEach, SharedPool)
+{
+	using namespace panini;
+
+	std::vector<int> v(64);
+
+	ParallelForEachOptions o;
+	o.itemsPerTask = 1;
+
+	std::mutex m;
+	std::set<ThreadPool*> pf;
+	std::set<ThreadPool*> ps;
+
+	std::string t;
+	StringWriter w(t);
+	w << ParallelForEach(v.begin(), v.end(), [&m, &pf](Writer&, int, size_t) {
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+		std::lock_guard<std::mutex> lock(m);
+		pf.insert(ThreadPool::GetCurrent());
+	}, o);
+	w << ParallelForEach(v.begin(), v.end(), [&m, &ps](Writer&, int, size_t) {
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+		std::lock_guard<std::mutex> lock(m);
+		ps.insert(ThreadPool::GetCurrent());
+	}, o);
+
+	// items can also be rendered on the waiting thread
+
+	pf.erase(nullptr);
+	ps.erase(nullptr);
+
+	std::set<ThreadPool*> e = { &ThreadPool::GetShared() };
+	EXPECT_EQ(e, pf);
+	EXPECT_EQ(e, ps);
+}
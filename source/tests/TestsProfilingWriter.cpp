@@ -0,0 +1,199 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	class GreetCommand
+		: public panini::Command
+	{
+
+	public:
+		void Visit(panini::Writer& writer) override
+		{
+			using namespace panini;
+
+			writer << "Hello, " << CommentLine("world") << NextLine();
+		}
+
+	};
+
+	const panini::CommandProfile* FindProfile(const std::vector<panini::CommandProfile>& profiles, const std::string& name)
+	{
+		auto found = std::find_if(profiles.begin(), profiles.end(), [&name](const panini::CommandProfile& it) {
+			return it.name == name;
+		});
+
+		return (found != profiles.end()) ? &*found : nullptr;
+	}
+
+};
+
+TEST(ProfilingWriter, OutputUnchanged)
+{
+	using namespace panini;
+
+	auto g = [](Writer& w) {
+		w << Include("vector", IncludeStyle::AngularBrackets) << NextLine();
+		w << Scope("struct Gadget", [](Writer& w) {
+			w << CommentBlock([](Writer& w) {
+				w << "Go go" << NextLine();
+			}) << NextLine();
+			w << "int arms = " << 'X' << ";" << NextLine();
+		}) << ";";
+	};
+
+	std::string e;
+	StringWriter ew(e);
+	g(ew);
+
+	std::string t;
+	StringWriter tw(t);
+	ProfilingWriter w(tw);
+	g(w);
+
+	EXPECT_STREQ(e.c_str(), t.c_str());
+}
+
+TEST(ProfilingWriter, NoCommands)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter s(t);
+	ProfilingWriter w(s);
+	w << "Just chunks" << NextLine();
+
+	EXPECT_TRUE(w.GetProfiles().empty());
+
+	std::stringstream ss;
+	w.WriteJson(ss);
+	EXPECT_STREQ("[]\n", ss.str().c_str());
+}
+
+TEST(ProfilingWriter, InvocationsAndBytes)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter s(t);
+	ProfilingWriter w(s);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		w << GreetCommand();
+	}
+
+	std::vector<CommandProfile> p = w.GetProfiles();
+	ASSERT_EQ(2, p.size());
+
+	const CommandProfile* g = FindProfile(p, "(anonymous namespace)::GreetCommand");
+	ASSERT_NE(nullptr, g);
+	EXPECT_EQ(3, g->invocationCount);
+	EXPECT_EQ(3 * 4, g->inclusiveChunkCount);
+	EXPECT_EQ(3 * (7 + 8), g->inclusiveByteCount);
+	EXPECT_EQ(3, g->exclusiveChunkCount);
+	EXPECT_EQ(3 * 7, g->exclusiveByteCount);
+	EXPECT_LE(g->exclusiveTime, g->inclusiveTime);
+
+	const CommandProfile* c = FindProfile(p, "panini::CommentLine");
+	ASSERT_NE(nullptr, c);
+	EXPECT_EQ(3, c->invocationCount);
+	EXPECT_EQ(3 * 3, c->inclusiveChunkCount);
+	EXPECT_EQ(3 * 8, c->inclusiveByteCount);
+	EXPECT_EQ(c->inclusiveByteCount, c->exclusiveByteCount);
+
+	// sorted by inclusive time
+
+	EXPECT_STREQ("(anonymous namespace)::GreetCommand", p[0].name.c_str());
+}
+
+TEST(ProfilingWriter, TemplatesShareProfile)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter s(t);
+	ProfilingWriter w(s);
+
+	w << MakeScope("namespace a", [](Writer& w) {
+		w << MakeScope("namespace b", [](Writer& w) {
+			w << "int c;" << NextLine();
+		}) << NextLine();
+	});
+
+	std::vector<CommandProfile> p = w.GetProfiles();
+	ASSERT_EQ(1, p.size());
+	EXPECT_STREQ("panini::BasicScope", p[0].name.c_str());
+	EXPECT_EQ(2, p[0].invocationCount);
+
+	// the nested scope is only counted once in the inclusive values
+
+	EXPECT_EQ(p[0].exclusiveByteCount, p[0].inclusiveByteCount);
+	EXPECT_EQ(p[0].exclusiveChunkCount, p[0].inclusiveChunkCount);
+}
+
+TEST(ProfilingWriter, ReportAndJson)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter s(t);
+	ProfilingWriter w(s);
+	w << CommentLine("profiled");
+
+	std::stringstream r;
+	w.WriteReport(r);
+	EXPECT_NE(std::string::npos, r.str().find("panini::CommentLine"));
+	EXPECT_NE(std::string::npos, r.str().find("Calls"));
+
+	std::stringstream j;
+	w.WriteJson(j);
+	EXPECT_NE(std::string::npos, j.str().find("\"name\": \"panini::CommentLine\""));
+	EXPECT_NE(std::string::npos, j.str().find("\"invocationCount\": 1"));
+	EXPECT_NE(std::string::npos, j.str().find("\"inclusiveByteCount\": 11"));
+
+	w.Reset();
+	EXPECT_TRUE(w.GetProfiles().empty());
+}
+
+TEST(ProfilingWriter, ExceptionInCommand)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter s(t);
+	ProfilingWriter w(s);
+
+	EXPECT_THROW(w << Braces([](Writer&) {
+		throw std::runtime_error("Nope");
+	}), std::runtime_error);
+
+	w << CommentLine("after");
+
+	std::vector<CommandProfile> p = w.GetProfiles();
+	ASSERT_EQ(2, p.size());
+	EXPECT_EQ(1, FindProfile(p, "panini::Braces")->invocationCount);
+	EXPECT_EQ(1, FindProfile(p, "panini::CommentLine")->invocationCount);
+}
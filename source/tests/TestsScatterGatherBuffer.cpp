@@ -0,0 +1,141 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+TEST(ScatterGatherBuffer, Empty)
+{
+	using namespace panini;
+
+	ScatterGatherBuffer b;
+
+	EXPECT_EQ(size_t{ 0 }, b.GetSize());
+	EXPECT_EQ(size_t{ 0 }, b.GetCopiedSize());
+	EXPECT_EQ(size_t{ 0 }, b.GetSegmentCount());
+}
+
+TEST(ScatterGatherBuffer, MergeCopies)
+{
+	using namespace panini;
+
+	ScatterGatherBuffer b(16);
+	b.Append("Hello");
+	b.Append(", ");
+	b.Append("World");
+
+	EXPECT_EQ(size_t{ 12 }, b.GetSize());
+	EXPECT_EQ(size_t{ 12 }, b.GetCopiedSize());
+	EXPECT_EQ(size_t{ 1 }, b.GetSegmentCount());
+
+	b.Append("! This chunk doesn't fit in the same block");
+
+	EXPECT_EQ(size_t{ 54 }, b.GetSize());
+	EXPECT_EQ(size_t{ 2 }, b.GetSegmentCount());
+}
+
+TEST(ScatterGatherBuffer, PinnedAreNotCopied)
+{
+	using namespace panini;
+
+	static const char s_Pinned[] = "This chunk lives forever";
+
+	ScatterGatherBuffer b;
+	b.Append("[");
+	b.AppendPinned(s_Pinned);
+	b.Append("]");
+
+	EXPECT_EQ(size_t{ 26 }, b.GetSize());
+	EXPECT_EQ(size_t{ 2 }, b.GetCopiedSize());
+	EXPECT_EQ(size_t{ 3 }, b.GetSegmentCount());
+}
+
+TEST(ScatterGatherBuffer, WriteManySegments)
+{
+	using namespace panini;
+
+	std::filesystem::path p = "scatter_gather_many.txt";
+	std::filesystem::remove(p);
+
+	static const std::string s_Pinned = "pin";
+
+	// more segments than fit in a single batch
+
+	ScatterGatherBuffer b;
+	std::string expected;
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		b.AppendPinned(s_Pinned);
+		b.Append(std::to_string(i));
+
+		expected += s_Pinned + std::to_string(i);
+	}
+
+	EXPECT_EQ(size_t{ 10000 }, b.GetSegmentCount());
+	EXPECT_TRUE(b.WriteTo(p));
+
+	std::ifstream f(p, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_EQ(expected, ss.str());
+}
+
+TEST(ScatterGatherBuffer, Clear)
+{
+	using namespace panini;
+
+	ScatterGatherBuffer b;
+	b.Append("Wowsers");
+	b.Clear();
+
+	EXPECT_EQ(size_t{ 0 }, b.GetSize());
+	EXPECT_EQ(size_t{ 0 }, b.GetCopiedSize());
+	EXPECT_EQ(size_t{ 0 }, b.GetSegmentCount());
+}
+
+TEST(ScatterGatherBuffer, ClearReusesBlocks)
+{
+	using namespace panini;
+
+	ScatterGatherBuffer b(8);
+	b.Append("This chunk is larger than a block");
+	b.Append("Go");
+	b.Append("Gadget");
+	b.Clear();
+
+	b.Append("Penny");
+	b.Append(" and ");
+	b.Append("Brain");
+	b.Append(" to the rescue");
+
+	EXPECT_EQ(size_t{ 29 }, b.GetCopiedSize());
+
+	EXPECT_TRUE(b.WriteTo("scatter_gather_reuse.txt"));
+
+	std::ifstream f("scatter_gather_reuse.txt", std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Penny and Brain to the rescue", ss.str().c_str());
+}
@@ -233,3 +233,29 @@ TEST(Scope, InheritConfigAttach)
 	}
 })", t.c_str());
 }
+
+TEST(Scope, MakeScope)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	const char* body = "return true;";
+
+	w << MakeScope("bool isUserAdmin(const char* username)", [body](Writer& writer) {
+		writer << MakeScope("if (username != nullptr)", [body](Writer& writer) {
+			writer << body << NextLine();
+		}) << NextLine();
+		writer << "return false;" << NextLine();
+	});
+
+	EXPECT_STREQ(R"(bool isUserAdmin(const char* username)
+{
+	if (username != nullptr)
+	{
+		return true;
+	}
+	return false;
+})", t.c_str());
+}
@@ -0,0 +1,135 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+TEST(SinkWriter, Write)
+{
+	using namespace panini;
+
+	std::string t;
+	SinkWriter w(StringSink{ t });
+
+	w << "Inspector " << std::string("Gadget") << '!';
+
+	EXPECT_STREQ("Inspector Gadget!", t.c_str());
+}
+
+TEST(SinkWriter, Indentation)
+{
+	using namespace panini;
+
+	std::string t;
+	SinkWriter w(StringSink{ t });
+
+	w << "root" << IndentPush() << NextLine();
+	w << "child" << IndentPop() << NextLine();
+	w << "sibling";
+
+	EXPECT_STREQ("root\n\tchild\nsibling", t.c_str());
+}
+
+TEST(SinkWriter, Config)
+{
+	using namespace panini;
+
+	WriterConfig c;
+	c.chunkIndent = "  ";
+	c.chunkNewLine = "\r\n";
+
+	std::string t;
+	SinkWriter w(StringSink{ t }, c);
+
+	w << Scope("void Wake()", [](Writer& writer) {
+		writer << "Snooze();" << NextLine();
+	});
+
+	EXPECT_STREQ("void Wake()\r\n{\r\n  Snooze();\r\n}", t.c_str());
+}
+
+TEST(SinkWriter, UsableAsWriter)
+{
+	using namespace panini;
+
+	std::string t;
+	SinkWriter w(StringSink{ t });
+
+	Writer& base = w;
+	base << CommentBlock([](Writer& writer) {
+		writer << "Hello" << NextLine();
+		writer << NextLine();
+		writer << "World";
+	});
+
+	EXPECT_STREQ("/* Hello\n *\n * World\n */", t.c_str());
+}
+
+TEST(SinkWriter, Buffer)
+{
+	using namespace panini;
+
+	std::vector<char> t;
+	SinkWriter w(BufferSink{ t });
+
+	w << "bits" << NextLine() << "bytes";
+
+	EXPECT_EQ("bits\nbytes", std::string(t.begin(), t.end()));
+}
+
+TEST(SinkWriter, FileDescriptor)
+{
+	using namespace panini;
+
+	std::filesystem::path p = "sink_file_descriptor.txt";
+	std::filesystem::remove(p);
+
+	{
+		SinkWriter w(FileDescriptorSink{ p, 4 });
+
+		EXPECT_TRUE(w.GetSink().IsOpen());
+
+		w << "Penny" << NextLine() << "and Brain";
+	}
+
+	std::ifstream f(p, std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Penny\nand Brain", ss.str().c_str());
+}
+
+TEST(SinkWriter, PreventDoubleCommit)
+{
+	using namespace panini;
+
+	std::string t;
+	SinkWriter w(StringSink{ t });
+
+	w << "Chief Quimby";
+
+	EXPECT_TRUE(w.IsChanged());
+	EXPECT_TRUE(w.Commit());
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_FALSE(w.Commit());
+}
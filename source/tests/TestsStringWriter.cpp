@@ -34,6 +34,32 @@ TEST(StringWriter, Write)
 	EXPECT_STREQ("What an intriguing device!", t.c_str());
 }
 
+TEST(StringWriter, WriteStringView)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	std::string_view v = "Go go gadget copter!";
+
+	w << v.substr(0, 6) << v.substr(6);
+
+	EXPECT_STREQ("Go go gadget copter!", t.c_str());
+}
+
+TEST(StringWriter, WriteCharacter)
+{
+	using namespace panini;
+
+	std::string t;
+	StringWriter w(t);
+
+	w << IndentPush() << '{' << NextLine() << '}';
+
+	EXPECT_STREQ("\t{\n\t}", t.c_str());
+}
+
 TEST(StringWriter, NewLine)
 {
 	using namespace panini;
@@ -0,0 +1,222 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	class CountingCommand
+		: public panini::Command
+	{
+
+	public:
+		CountingCommand(int& visits)
+			: m_visits(visits)
+		{
+		}
+
+		void Visit(panini::Writer& writer) override
+		{
+			using namespace panini;
+
+			++m_visits;
+
+			writer << "Visited " << std::to_string(m_visits) << NextLine();
+		}
+
+	private:
+		int& m_visits;
+
+	};
+
+};
+
+TEST(TeeWriter, NoTargets)
+{
+	using namespace panini;
+
+	TeeWriter w;
+	w << "Nowhere" << NextLine() << Scope("struct Empty", [](Writer&) {});
+
+	EXPECT_EQ(0, w.GetTargetCount());
+	EXPECT_TRUE(w.IsOnNewLine());
+	EXPECT_FALSE(w.IsChanged());
+	EXPECT_FALSE(w.Commit(true));
+}
+
+TEST(TeeWriter, SameOutput)
+{
+	using namespace panini;
+
+	auto g = [](Writer& w) {
+		w << Include("vector", IncludeStyle::AngularBrackets) << NextLine();
+		w << Scope("struct Gadget", [](Writer& w) {
+			w << CommentBlock([](Writer& w) {
+				w << "Go go" << NextLine();
+			}) << NextLine();
+			w << "int arms = " << 'X' << ";" << NextLine();
+		}) << ";";
+	};
+
+	std::string e;
+	StringWriter ew(e);
+	g(ew);
+
+	std::string a;
+	std::string b;
+	StringWriter aw(a);
+	StringWriter bw(b);
+	TeeWriter w({ aw, bw });
+	g(w);
+
+	EXPECT_EQ(2, w.GetTargetCount());
+	EXPECT_STREQ(e.c_str(), a.c_str());
+	EXPECT_STREQ(e.c_str(), b.c_str());
+}
+
+TEST(TeeWriter, VisitOnce)
+{
+	using namespace panini;
+
+	std::string a;
+	std::string b;
+	std::string c;
+	StringWriter aw(a);
+	StringWriter bw(b);
+	StringWriter cw(c);
+	TeeWriter w({ aw, bw });
+	w.Add(cw);
+
+	int v = 0;
+	w << CountingCommand(v);
+
+	EXPECT_EQ(1, v);
+	EXPECT_STREQ("Visited 1\n", a.c_str());
+	EXPECT_STREQ("Visited 1\n", b.c_str());
+	EXPECT_STREQ("Visited 1\n", c.c_str());
+}
+
+TEST(TeeWriter, OwnConfig)
+{
+	using namespace panini;
+
+	std::string a;
+	StringWriter aw(a);
+
+	std::string b;
+	StringWriterConfig bc;
+	bc.chunkNewLine = "\r\n";
+	bc.chunkIndent = "  ";
+	StringWriter bw(b, bc);
+
+	HashWriter h;
+
+	TeeWriter w({ aw, bw, h });
+	w << Scope("void Stop()", [](Writer& w) {
+		w << "return;" << NextLine();
+	});
+
+	EXPECT_STREQ("void Stop()\n{\n\treturn;\n}", a.c_str());
+	EXPECT_STREQ("void Stop()\r\n{\r\n  return;\r\n}", b.c_str());
+	EXPECT_EQ(Hash64::Compute(a), h.GetDigest());
+}
+
+TEST(TeeWriter, ConfigFromFirstTarget)
+{
+	using namespace panini;
+
+	std::string a;
+	StringWriterConfig ac;
+	ac.braceBreakingStyle = BraceBreakingStyle::Attach;
+	StringWriter aw(a, ac);
+
+	std::string b;
+	StringWriter bw(b);
+
+	TeeWriter w({ aw, bw });
+	EXPECT_EQ(BraceBreakingStyle::Attach, w.GetBraceBreakingStyle());
+
+	w << Scope("enum Color", [](Writer& w) {
+		w << "Red" << NextLine();
+	});
+
+	EXPECT_STREQ("enum Color {\n\tRed\n}", a.c_str());
+	EXPECT_STREQ("enum Color {\n\tRed\n}", b.c_str());
+}
+
+TEST(TeeWriter, CommentBlock)
+{
+	using namespace panini;
+
+	auto g = [](Writer& w) {
+		w << CommentBlock([](Writer& w) {
+			w << "First" << NextLine();
+			w << "Second";
+		});
+	};
+
+	std::string e;
+	StringWriter ew(e);
+	g(ew);
+
+	std::string a;
+	std::string b;
+	StringWriter aw(a);
+	StringWriter bw(b);
+	TeeWriter w({ aw, bw });
+	g(w);
+
+	EXPECT_STREQ(e.c_str(), a.c_str());
+	EXPECT_STREQ(e.c_str(), b.c_str());
+}
+
+TEST(TeeWriter, CommitAll)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "tee_writer_commit";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	CompareWriterConfig ac;
+	ac.filePath = d / "first.txt";
+	CompareWriter aw(ac);
+
+	CompareWriterConfig bc;
+	bc.filePath = d / "second.txt";
+	CompareWriter bw(bc);
+
+	HashWriter h;
+
+	TeeWriter w({ aw, bw, h });
+	w << "Shared" << NextLine();
+
+	EXPECT_TRUE(w.IsChanged());
+	EXPECT_TRUE(w.Commit());
+	EXPECT_FALSE(aw.IsChanged());
+	EXPECT_FALSE(bw.IsChanged());
+	EXPECT_TRUE(std::filesystem::exists(ac.filePath));
+	EXPECT_TRUE(std::filesystem::exists(bc.filePath));
+
+	std::filesystem::remove_all(d);
+}
@@ -0,0 +1,157 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+TEST(ThreadPool, RunAll)
+{
+	using namespace panini;
+
+	ThreadPool p(4);
+	EXPECT_EQ(4, p.GetThreadCount());
+
+	std::atomic<int> c = 0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		p.Submit([&c] {
+			c++;
+		});
+	}
+	p.Wait();
+
+	EXPECT_EQ(1000, c.load());
+}
+
+TEST(ThreadPool, WaitWithoutTasks)
+{
+	using namespace panini;
+
+	ThreadPool p(2);
+	p.Wait();
+}
+
+TEST(ThreadPool, SubmitFromTask)
+{
+	using namespace panini;
+
+	ThreadPool p(2);
+
+	std::atomic<int> c = 0;
+	for (int i = 0; i < 10; ++i)
+	{
+		p.Submit([&p, &c] {
+			for (int j = 0; j < 10; ++j)
+			{
+				p.Submit([&c] {
+					c++;
+				});
+			}
+		});
+	}
+	p.Wait();
+
+	EXPECT_EQ(100, c.load());
+}
+
+TEST(ThreadPool, WaitFromTask)
+{
+	using namespace panini;
+
+	ThreadPool p(1);
+
+	std::atomic<int> c = 0;
+	p.Submit([&p, &c] {
+		ThreadPool::TaskGroup g;
+		p.Submit(g, [&c] {
+			c++;
+		});
+		p.Wait(g);
+
+		EXPECT_EQ(1, c.load());
+	});
+	p.Wait();
+
+	EXPECT_EQ(1, c.load());
+}
+
+TEST(ThreadPool, RethrowException)
+{
+	using namespace panini;
+
+	ThreadPool p(2);
+
+	std::atomic<int> c = 0;
+	p.Submit([] {
+		throw std::runtime_error("Clean up on aisle five.");
+	});
+	p.Submit([&c] {
+		c++;
+	});
+
+	EXPECT_THROW(p.Wait(), std::runtime_error);
+	EXPECT_EQ(1, c.load());
+
+	p.Wait();
+}
+
+TEST(ThreadPool, FinishOnDestruction)
+{
+	using namespace panini;
+
+	std::atomic<int> c = 0;
+
+	{
+		ThreadPool p(3);
+		for (int i = 0; i < 100; ++i)
+		{
+			p.Submit([&c] {
+				c++;
+			});
+		}
+	}
+
+	EXPECT_EQ(100, c.load());
+}
+
+TEST(ThreadPool, WaitForGroup)
+{
+	using namespace panini;
+
+	ThreadPool p(2);
+
+	std::atomic<int> c = 0;
+	ThreadPool::TaskGroup g;
+	for (int i = 0; i < 50; ++i)
+	{
+		p.Submit(g, [&c] {
+			c++;
+		});
+	}
+	p.Submit(g, [] {
+		throw std::runtime_error("Grouped up.");
+	});
+
+	EXPECT_THROW(p.Wait(g), std::runtime_error);
+	EXPECT_EQ(50, c.load());
+
+	p.Wait();
+}
@@ -0,0 +1,319 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+#include <thread>
+
+namespace
+{
+
+	const panini::TraceEvent* FindEvent(const std::vector<panini::TraceEvent>& events, std::string_view name, std::string_view label = {})
+	{
+		auto found = std::find_if(events.begin(), events.end(), [&](const panini::TraceEvent& it) {
+			return it.name == name && (label.empty() || it.label == label);
+		});
+
+		return (found != events.end()) ? &*found : nullptr;
+	}
+
+};
+
+TEST(TraceRecorder, StartStop)
+{
+	using namespace panini;
+
+	EXPECT_EQ(nullptr, TraceRecorder::GetActive());
+
+	{
+		TraceRecorder r;
+		EXPECT_FALSE(r.IsStarted());
+
+		r.Start();
+		EXPECT_TRUE(r.IsStarted());
+		EXPECT_EQ(&r, TraceRecorder::GetActive());
+
+		r.Stop();
+		EXPECT_FALSE(r.IsStarted());
+		EXPECT_EQ(nullptr, TraceRecorder::GetActive());
+
+		r.Start();
+	}
+
+	EXPECT_EQ(nullptr, TraceRecorder::GetActive());
+}
+
+TEST(TraceRecorder, SpanNotRecordedWhenStopped)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+
+	{
+		TraceSpan s("test", "Stopped");
+	}
+
+	EXPECT_EQ(0, r.GetEventCount());
+}
+
+TEST(TraceRecorder, Spans)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.Start();
+
+	{
+		TraceSpan o("test", "Outer");
+
+		{
+			TraceSpan i("test", "Inner", "Label");
+		}
+	}
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+	ASSERT_EQ(2, e.size());
+
+	EXPECT_EQ("Outer", e[0].name);
+	EXPECT_STREQ("test", e[0].category);
+	EXPECT_TRUE(e[0].label.empty());
+	EXPECT_EQ(1, e[0].threadId);
+
+	EXPECT_EQ("Inner", e[1].name);
+	EXPECT_EQ("Label", e[1].label);
+	EXPECT_EQ(1, e[1].threadId);
+
+	EXPECT_LE(e[0].start, e[1].start);
+	EXPECT_GE(e[0].start + e[0].duration, e[1].start + e[1].duration);
+
+	r.Clear();
+	EXPECT_EQ(0, r.GetEventCount());
+}
+
+TEST(TraceRecorder, Threads)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.Start();
+
+	{
+		TraceSpan s("test", "Main");
+	}
+
+	std::thread t([] {
+		TraceSpan s("test", "Thread");
+	});
+	t.join();
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+	ASSERT_EQ(2, e.size());
+
+	const TraceEvent* m = FindEvent(e, "Main");
+	const TraceEvent* o = FindEvent(e, "Thread");
+	ASSERT_NE(nullptr, m);
+	ASSERT_NE(nullptr, o);
+	EXPECT_EQ(1, m->threadId);
+	EXPECT_EQ(2, o->threadId);
+}
+
+TEST(TraceRecorder, CommandDepth)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.SetMaxCommandDepth(1);
+	r.Start();
+
+	{
+		TraceCommandSpan o(typeid(NextLine));
+
+		{
+			TraceCommandSpan i(typeid(IndentPush));
+		}
+	}
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+	ASSERT_EQ(1, e.size());
+	EXPECT_EQ("panini::NextLine", e[0].name);
+	EXPECT_STREQ("command", e[0].category);
+}
+
+TEST(TraceRecorder, WriteChromeTrace)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.Start();
+	r.SetThreadName("Main \"thread\"");
+	r.AddEvent("Scope", "scope", "struct Gadget", 1500, 4250);
+	r.AddEvent("Commit", "commit", {}, 5000, 5010);
+	r.Stop();
+
+	std::stringstream s;
+	r.WriteChromeTrace(s);
+
+	EXPECT_STREQ(R"({"displayTimeUnit":"ns","traceEvents":[
+{"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"Main \"thread\""}},
+{"name":"struct Gadget","cat":"scope","ph":"X","pid":1,"tid":1,"ts":1.500,"dur":2.750,"args":{"type":"Scope"}},
+{"name":"Commit","cat":"commit","ph":"X","pid":1,"tid":1,"ts":5.000,"dur":0.010}
+]}
+)", s.str().c_str());
+}
+
+TEST(TraceRecorder, WriteChromeTraceEmpty)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+
+	std::stringstream s;
+	r.WriteChromeTrace(s);
+
+	EXPECT_STREQ("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n", s.str().c_str());
+}
+
+#if defined(PANINI_ENABLE_TRACING)
+
+TEST(TraceRecorder, WriterHooks)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.Start();
+
+	std::string o;
+	StringWriter w(o);
+	w << Scope("struct Gadget", [](Writer& w) {
+		w << "int arms;" << CommentLine("robot") << NextLine();
+	});
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+
+	const TraceEvent* c = FindEvent(e, "panini::Scope");
+	const TraceEvent* s = FindEvent(e, "Scope", "struct Gadget");
+	ASSERT_NE(nullptr, c);
+	ASSERT_NE(nullptr, s);
+	EXPECT_STREQ("command", c->category);
+	EXPECT_STREQ("scope", s->category);
+	EXPECT_LE(c->start, s->start);
+
+	EXPECT_NE(nullptr, FindEvent(e, "panini::CommentLine"));
+}
+
+TEST(TraceRecorder, SinkWriterHooks)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.Start();
+
+	std::string o;
+	SinkWriter w(StringSink{ o });
+	w << CommentLine("sink");
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+
+	const TraceEvent* c = FindEvent(e, "panini::CommentLine");
+	ASSERT_NE(nullptr, c);
+	EXPECT_STREQ("command", c->category);
+}
+
+TEST(TraceRecorder, GenerationJobHooks)
+{
+	using namespace panini;
+
+	std::filesystem::path d = "trace_recorder_jobs";
+	std::filesystem::remove_all(d);
+	std::filesystem::create_directories(d);
+
+	TraceRecorder r;
+	r.SetMaxCommandDepth(1);
+	r.Start();
+
+	GenerationJobs j;
+	j.Add(d / "first.txt", [](Writer& w) {
+		w << "First" << NextLine();
+	});
+	j.Add(d / "second.txt", [](Writer& w) {
+		w << "Second" << NextLine();
+	});
+
+	ThreadPool p(2);
+	j.Run(p);
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+
+	const TraceEvent* f = FindEvent(e, "GenerationJob", (d / "first.txt").string());
+	const TraceEvent* s = FindEvent(e, "GenerationJob", (d / "second.txt").string());
+	ASSERT_NE(nullptr, f);
+	ASSERT_NE(nullptr, s);
+	EXPECT_STREQ("job", f->category);
+
+	const TraceEvent* c = FindEvent(e, "CompareWriter::OnCommit", (d / "first.txt").string());
+	ASSERT_NE(nullptr, c);
+	EXPECT_STREQ("commit", c->category);
+	EXPECT_EQ(f->threadId, c->threadId);
+	EXPECT_LE(f->start, c->start);
+	EXPECT_GE(f->start + f->duration, c->start + c->duration);
+
+	std::filesystem::remove_all(d);
+}
+
+TEST(TraceRecorder, FileWriterCommit)
+{
+	using namespace panini;
+
+	TraceRecorder r;
+	r.Start();
+
+	{
+		FileWriterConfig c;
+		c.targetPath = "trace_recorder_file.txt";
+		FileWriter w(c);
+		w << "Hello" << NextLine();
+		w.Commit(true);
+	}
+
+	r.Stop();
+
+	std::vector<TraceEvent> e = r.GetEvents();
+	const TraceEvent* c = FindEvent(e, "FileWriter::OnCommit", "trace_recorder_file.txt");
+	ASSERT_NE(nullptr, c);
+	EXPECT_STREQ("commit", c->category);
+
+	std::filesystem::remove("trace_recorder_file.txt");
+}
+
+#endif
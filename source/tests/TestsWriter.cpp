@@ -0,0 +1,193 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	// records every call to its hooks as a string
+
+	class HookWriter
+		: public panini::ConfiguredWriter<panini::WriterConfig>
+	{
+
+	public:
+		inline explicit HookWriter(size_t batchSize = 0, bool assemble = false)
+		{
+			if (assemble)
+			{
+				EnableLineAssembly(batchSize);
+			}
+		}
+
+		std::vector<std::string> calls;
+
+	protected:
+		inline void OnLineStart() override
+		{
+			calls.push_back("start");
+		}
+
+		inline void Write(std::string_view chunk) override
+		{
+			calls.push_back("write:" + std::string(chunk));
+		}
+
+		inline void WriteNewLine() override
+		{
+			calls.push_back("newline");
+		}
+
+		inline void WriteLines(std::string_view lines) override
+		{
+			calls.push_back("lines:" + std::string(lines));
+		}
+
+		inline bool OnCommit(bool force) override
+		{
+			(void)force;
+
+			return true;
+		}
+
+	};
+
+};
+
+TEST(Writer, LineStart)
+{
+	using namespace panini;
+
+	HookWriter w;
+	w << "int a;" << NextLine();
+	w << IndentPush() << "int b;" << " int c;" << NextLine();
+
+	std::vector<std::string> e = {
+		"start",
+		"write:int a;",
+		"newline",
+		"start",
+		"write:\t",
+		"write:int b;",
+		"write: int c;",
+		"newline",
+	};
+
+	EXPECT_EQ(e, w.calls);
+}
+
+TEST(Writer, LinePrefixInCommentBlock)
+{
+	using namespace panini;
+
+	HookWriter w;
+	w << IndentPush();
+	w.SetIsInCommentBlock(true);
+	w << IndentPush() << "Nested" << NextLine();
+	w << NextLine();
+	w << IndentPop() << "Back" << NextLine();
+	w.SetIsInCommentBlock(false);
+	w << "Done";
+
+	std::vector<std::string> e = {
+		"start",
+		"write:\t * \t",
+		"write:Nested",
+		"newline",
+		"start",
+		"write: *",
+		"newline",
+		"start",
+		"write:\t * ",
+		"write:Back",
+		"newline",
+		"start",
+		"write:\t",
+		"write:Done",
+	};
+
+	EXPECT_EQ(e, w.calls);
+}
+
+TEST(Writer, AssembleEveryLine)
+{
+	using namespace panini;
+
+	HookWriter w(0, true);
+	w << IndentPush() << "int a;" << NextLine();
+	w << "int b;" << " int c;" << NextLine();
+	w << "int d;";
+
+	std::vector<std::string> e = {
+		"start",
+		"lines:\tint a;\n",
+		"start",
+		"lines:\tint b; int c;\n",
+		"start",
+	};
+
+	EXPECT_EQ(e, w.calls);
+
+	w.Commit();
+
+	e.push_back("lines:\tint d;");
+
+	EXPECT_EQ(e, w.calls);
+}
+
+TEST(Writer, AssembleBatches)
+{
+	using namespace panini;
+
+	HookWriter w(12, true);
+	w << "one" << NextLine();
+	w << "two" << NextLine();
+	w << PinnedChunk{ "three" } << NextLine();
+	w << "four" << NextLine();
+
+	std::vector<std::string> e = {
+		"start",
+		"start",
+		"start",
+		"lines:one\ntwo\nthree\n",
+		"start",
+	};
+
+	EXPECT_EQ(e, w.calls);
+
+	w.Commit();
+
+	e.push_back("lines:four\n");
+
+	EXPECT_EQ(e, w.calls);
+}
+
+TEST(Writer, AssembleCommitEmpty)
+{
+	using namespace panini;
+
+	HookWriter w(16, true);
+	w.Commit();
+
+	EXPECT_TRUE(w.calls.empty());
+}
@@ -0,0 +1,289 @@
+/*
+	MIT No Attribution
+
+	Copyright 2021-2023 Mr. Hands
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to
+	deal in the Software without restriction, including without limitation the
+	rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+	THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+	DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Panini.hpp>
+
+namespace
+{
+
+	class InspectedFileWriter
+		: public panini::FileWriter
+	{
+
+	public:
+		using FileWriter::FileWriter;
+
+		size_t GetCopiedSize() const
+		{
+			return m_scatter.GetCopiedSize();
+		}
+
+	};
+
+};
+
+TEST(WriterPool, ReuseReleased)
+{
+	using namespace panini;
+
+	WriterPool<StringWriter> p;
+	std::string a;
+	std::string b;
+
+	{
+		auto w = p.Acquire(a);
+		*w << "Pretty fly";
+	}
+
+	EXPECT_EQ(1, p.GetReleasedCount());
+
+	{
+		auto w = p.Acquire(b);
+		*w << "for a white guy";
+	}
+
+	EXPECT_STREQ("Pretty fly", a.c_str());
+	EXPECT_STREQ("for a white guy", b.c_str());
+	EXPECT_EQ(1, p.GetCreatedCount());
+	EXPECT_EQ(1, p.GetReusedCount());
+	EXPECT_EQ(1, p.GetReleasedCount());
+}
+
+TEST(WriterPool, AcquireWhileInUse)
+{
+	using namespace panini;
+
+	WriterPool<StringWriter> p;
+	std::string a;
+	std::string b;
+
+	{
+		auto wa = p.Acquire(a);
+		auto wb = p.Acquire(b);
+		*wa << "Left";
+		*wb << "Right";
+	}
+
+	EXPECT_STREQ("Left", a.c_str());
+	EXPECT_STREQ("Right", b.c_str());
+	EXPECT_EQ(2, p.GetCreatedCount());
+	EXPECT_EQ(0, p.GetReusedCount());
+	EXPECT_EQ(2, p.GetReleasedCount());
+}
+
+TEST(WriterPool, MaximumReleased)
+{
+	using namespace panini;
+
+	WriterPool<StringWriter> p(1);
+	std::string a;
+	std::string b;
+
+	{
+		auto wa = p.Acquire(a);
+		auto wb = p.Acquire(b);
+	}
+
+	EXPECT_EQ(1, p.GetReleasedCount());
+}
+
+TEST(WriterPool, ResetState)
+{
+	using namespace panini;
+
+	WriterPool<StringWriter> p;
+	std::string a;
+	std::string b;
+
+	{
+		auto w = p.Acquire(a);
+		*w << IndentPush() << IndentPush() << "unfinished" << AlignPush(4) << NextLine() << "business";
+	}
+
+	{
+		auto w = p.Acquire(b);
+		*w << "clean" << NextLine() << "slate";
+	}
+
+	EXPECT_STREQ("clean\nslate", b.c_str());
+}
+
+TEST(WriterPool, ResetConfig)
+{
+	using namespace panini;
+
+	WriterPool<StringWriter> p;
+	std::string a;
+	std::string b;
+
+	StringWriterConfig ca;
+	ca.chunkIndent = "\t";
+
+	StringWriterConfig cb;
+	cb.chunkIndent = "  ";
+
+	{
+		auto w = p.Acquire(a, ca);
+		*w << IndentPush() << "one" << NextLine() << "two";
+	}
+
+	{
+		auto w = p.Acquire(b, cb);
+		*w << IndentPush() << "one" << NextLine() << "two";
+	}
+
+	EXPECT_STREQ("\tone\n\ttwo", a.c_str());
+	EXPECT_STREQ("  one\n  two", b.c_str());
+	EXPECT_EQ(1, p.GetReusedCount());
+}
+
+TEST(WriterPool, CompareWriterFiles)
+{
+	using namespace panini;
+
+	WriterPool<CompareWriter> p;
+
+	CompareWriterConfig c;
+	c.filePath = "pool_compare_first.txt";
+	std::filesystem::remove(c.filePath);
+	std::filesystem::remove("pool_compare_second.txt");
+
+	{
+		auto w = p.Acquire(c);
+		*w << "First";
+	}
+
+	c.filePath = "pool_compare_second.txt";
+
+	{
+		auto w = p.Acquire(c);
+		*w << "Second";
+		EXPECT_TRUE(w->IsChanged());
+	}
+
+	c.filePath = "pool_compare_first.txt";
+
+	{
+		auto w = p.Acquire(c);
+		*w << "First";
+		EXPECT_FALSE(w->IsChanged());
+	}
+
+	std::ifstream f("pool_compare_second.txt", std::ios::in | std::ios::binary);
+	EXPECT_TRUE(f.is_open());
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("Second", ss.str().c_str());
+	EXPECT_EQ(2, p.GetReusedCount());
+}
+
+TEST(WriterPool, ReleasedWriterIsDetached)
+{
+	using namespace panini;
+
+	CompareWriterConfig c;
+	c.filePath = "pool_detached.txt";
+	std::filesystem::remove(c.filePath);
+	std::filesystem::remove("pool_detached.manifest");
+
+	{
+		WriterPool<CompareWriter> p;
+
+		{
+			OutputManifest m("pool_detached.manifest");
+			c.manifest = &m;
+
+			auto w = p.Acquire(c);
+			*w << "Chief Quimby";
+		}
+
+		// the manifest was destroyed while the writer is still in the pool
+
+		std::ofstream f(c.filePath, std::ios::out | std::ios::binary);
+		f << "This message will self-destruct";
+		f.close();
+
+		EXPECT_EQ(1, p.GetReleasedCount());
+	}
+
+	std::ifstream f(c.filePath, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_STREQ("This message will self-destruct", ss.str().c_str());
+
+	std::filesystem::remove("pool_detached.manifest");
+}
+
+TEST(WriterPool, FileWriterModes)
+{
+	using namespace panini;
+
+	WriterPool<InspectedFileWriter> p;
+
+	const std::string s = "Pinned chunks are never copied.";
+
+	FileWriterConfig c;
+	c.targetPath = "pool_modes_commit.txt";
+
+	{
+		auto w = p.Acquire(c);
+		*w << PinnedChunk{ s } << NextLine();
+	}
+
+	c.targetPath = "pool_modes_scatter_gather.txt";
+	c.mode = FileWriterMode::ScatterGather;
+
+	std::string e;
+
+	{
+		auto w = p.Acquire(c);
+		for (size_t i = 0; i < 256; ++i)
+		{
+			*w << PinnedChunk{ s } << NextLine();
+			e += s + "\n";
+		}
+
+		EXPECT_EQ(size_t{ 0 }, w->GetCopiedSize());
+	}
+
+	c.targetPath = "pool_modes_streaming.txt";
+	c.mode = FileWriterMode::Streaming;
+	c.bufferSize = 8;
+
+	{
+		auto w = p.Acquire(c);
+		*w << "Streamed" << NextLine() << "again";
+
+		// output is written before the writer is committed
+
+		EXPECT_LE(size_t{ 8 }, std::filesystem::file_size(c.targetPath));
+	}
+
+	std::ifstream f("pool_modes_scatter_gather.txt", std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << f.rdbuf();
+
+	EXPECT_EQ(e, ss.str());
+	EXPECT_EQ(2, p.GetReusedCount());
+}